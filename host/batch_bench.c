@@ -0,0 +1,340 @@
+/******************************************************************************
+* File Name: batch_bench.c
+*
+* Description: Host check and benchmark of aes_batch_run(). It runs a full
+* AES_BATCH frame's worth of short CTR and CFB messages as one batch with a
+* single key load, and as separate messages that each load and unload the key
+* with aes_session_load(), checks that both give the same output and that CFB
+* decryption restores the input, and prints the best time per message for both.
+* Built and run by 'make bench'.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_batch.h"
+#include "aes_cfb.h"
+#include "aes_ctr.h"
+#include "frame_protocol.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Jobs per batch, as many as an AES_BATCH frame carries */
+#define BATCH_BENCH_JOBS                     (FRAME_MAX_BATCH_JOBS)
+#define BATCH_BENCH_MAX_SIZE                 (64u)
+
+/* Batches per size, mode and variant */
+#define BATCH_BENCH_CALLS                    (1000u)
+
+/* Runs per size, mode and variant, interleaved; the fastest one is
+ * reported */
+#define BATCH_BENCH_RUNS                     (7u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const size_t batch_bench_sizes[] = { 5u, 16u, 27u, 64u };
+
+static const aes_batch_mode_t batch_bench_modes[] =
+{
+    AES_BATCH_CTR, AES_BATCH_CFB_ENCRYPT
+};
+
+static const uint8_t bench_key[AES_SESSION_KEY_SIZE] =
+{
+    0xAAu, 0xBBu, 0xCCu, 0xDDu, 0xEEu, 0xFFu, 0xFFu, 0xEEu,
+    0xDDu, 0xCCu, 0xBBu, 0xAAu, 0xAAu, 0xBBu, 0xCCu, 0xDDu,
+};
+
+static aes_session_t bench_session;
+static aes_batch_job_t bench_jobs[BATCH_BENCH_JOBS];
+static uint8_t bench_iv[BATCH_BENCH_JOBS][AES_BATCH_IV_SIZE];
+static uint8_t bench_src[BATCH_BENCH_JOBS][BATCH_BENCH_MAX_SIZE];
+static uint8_t bench_dst[BATCH_BENCH_JOBS][BATCH_BENCH_MAX_SIZE];
+static uint8_t bench_ref[BATCH_BENCH_JOBS][BATCH_BENCH_MAX_SIZE];
+
+/*******************************************************************************
+* Function Name: setup_jobs
+********************************************************************************
+* Summary: Points every job at its own IV, input and the given output, with
+*          len bytes each.
+*
+*******************************************************************************/
+static void setup_jobs(uint8_t (*src)[BATCH_BENCH_MAX_SIZE],
+                       uint8_t (*dst)[BATCH_BENCH_MAX_SIZE], size_t len)
+{
+    for (size_t i = 0u; i < BATCH_BENCH_JOBS; i++)
+    {
+        bench_jobs[i].iv = bench_iv[i];
+        bench_jobs[i].src = src[i];
+        bench_jobs[i].dst = dst[i];
+        bench_jobs[i].len = len;
+    }
+}
+
+/*******************************************************************************
+* Function Name: run_per_message
+********************************************************************************
+* Summary: Runs every job as its own message, loading the key before it and
+*          unloading it after, as separate requests with no batch do.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t run_per_message(aes_batch_mode_t mode)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+    cy_en_cryptolite_status_t unload_res;
+    aes_ctr_ctx_t ctr;
+    aes_cfb_ctx_t cfb;
+    aes_batch_job_t const *job;
+
+    for (size_t i = 0u; (i < BATCH_BENCH_JOBS) && (res == CY_CRYPTOLITE_SUCCESS); i++)
+    {
+        job = &bench_jobs[i];
+        res = aes_session_load(&bench_session, bench_key);
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            break;
+        }
+
+        if (mode == AES_BATCH_CTR)
+        {
+            res = aes_ctr_init(&ctr, &bench_session, job->iv);
+            if (res == CY_CRYPTOLITE_SUCCESS)
+            {
+                res = aes_ctr_update(&ctr, job->dst, job->src, job->len);
+            }
+            aes_ctr_final(&ctr);
+        }
+        else
+        {
+            res = aes_cfb_init(&cfb, &bench_session,
+                               (mode == AES_BATCH_CFB_ENCRYPT) ?
+                               CY_CRYPTOLITE_ENCRYPT : CY_CRYPTOLITE_DECRYPT,
+                               job->iv);
+            if (res == CY_CRYPTOLITE_SUCCESS)
+            {
+                res = aes_cfb_update(&cfb, job->dst, job->src, job->len);
+            }
+            aes_cfb_final(&cfb);
+        }
+
+        unload_res = aes_session_unload(&bench_session);
+        res = (res == CY_CRYPTOLITE_SUCCESS) ? unload_res : res;
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: run_batch
+********************************************************************************
+* Summary: Runs all jobs with aes_batch_run(), which loads the key once, and
+*          unloads it after, so that every batch pays for one load.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t run_batch(aes_batch_mode_t mode)
+{
+    cy_en_cryptolite_status_t res;
+    cy_en_cryptolite_status_t unload_res;
+    aes_batch_stats_t stats;
+
+    res = aes_batch_run(&bench_session, bench_key, mode, bench_jobs,
+                        BATCH_BENCH_JOBS, &stats);
+    if ((res == CY_CRYPTOLITE_SUCCESS) &&
+        ((stats.failed_jobs != 0u) ||
+         (stats.bytes != (BATCH_BENCH_JOBS * bench_jobs[0].len))))
+    {
+        res = CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    unload_res = aes_session_unload(&bench_session);
+    return (res == CY_CRYPTOLITE_SUCCESS) ? unload_res : res;
+}
+
+/*******************************************************************************
+* Function Name: check_mode
+********************************************************************************
+* Summary: Checks that a batch gives the same output as separate messages
+*          and, for CFB, that a decrypting batch restores the input.
+*
+*******************************************************************************/
+static bool check_mode(aes_batch_mode_t mode, size_t len)
+{
+    setup_jobs(bench_src, bench_ref, len);
+    if (run_per_message(mode) != CY_CRYPTOLITE_SUCCESS)
+    {
+        return false;
+    }
+
+    setup_jobs(bench_src, bench_dst, len);
+    memset(bench_dst, 0, sizeof(bench_dst));
+    if (run_batch(mode) != CY_CRYPTOLITE_SUCCESS)
+    {
+        return false;
+    }
+    for (size_t i = 0u; i < BATCH_BENCH_JOBS; i++)
+    {
+        if (memcmp(bench_dst[i], bench_ref[i], len) != 0)
+        {
+            return false;
+        }
+    }
+
+    if (mode == AES_BATCH_CFB_ENCRYPT)
+    {
+        setup_jobs(bench_ref, bench_dst, len);
+        if (run_batch(AES_BATCH_CFB_DECRYPT) != CY_CRYPTOLITE_SUCCESS)
+        {
+            return false;
+        }
+        for (size_t i = 0u; i < BATCH_BENCH_JOBS; i++)
+        {
+            if (memcmp(bench_dst[i], bench_src[i], len) != 0)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary: Monotonic time in nanoseconds.
+*
+*******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: time_message
+********************************************************************************
+* Summary: Returns the average time of one message in nanoseconds, or a
+*          negative value if a call failed.
+*
+*******************************************************************************/
+static double time_message(cy_en_cryptolite_status_t (*fn)(aes_batch_mode_t),
+                           aes_batch_mode_t mode)
+{
+    double start = now_ns();
+
+    for (uint32_t i = 0u; i < BATCH_BENCH_CALLS; i++)
+    {
+        if (fn(mode) != CY_CRYPTOLITE_SUCCESS)
+        {
+            return -1.0;
+        }
+        /* Keep the calls from being merged or dropped */
+        __asm__ volatile("" : : "r"(bench_dst) : "memory");
+    }
+    return (now_ns() - start) / (double)(BATCH_BENCH_CALLS * BATCH_BENCH_JOBS);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Checks both variants against each other, then prints the best
+*          time per message with a key load per message and per batch.
+*
+*******************************************************************************/
+int main(void)
+{
+    aes_batch_mode_t mode;
+    size_t len;
+    double best[2];
+    double ns;
+
+    for (size_t i = 0u; i < BATCH_BENCH_JOBS; i++)
+    {
+        for (size_t j = 0u; j < AES_BATCH_IV_SIZE; j++)
+        {
+            bench_iv[i][j] = (uint8_t)((i * 16u) + j);
+        }
+        for (size_t j = 0u; j < BATCH_BENCH_MAX_SIZE; j++)
+        {
+            bench_src[i][j] = (uint8_t)((i * 31u) + (j * 7u));
+        }
+    }
+
+    printf("%u jobs per batch\n", (unsigned int)BATCH_BENCH_JOBS);
+    printf("%-4s %6s %15s %12s %10s %8s\n", "mode", "size", "per-message ns",
+           "batch ns", "saved ns", "speedup");
+    for (size_t m = 0u; m < (sizeof(batch_bench_modes) / sizeof(batch_bench_modes[0])); m++)
+    {
+        mode = batch_bench_modes[m];
+        for (size_t s = 0u; s < (sizeof(batch_bench_sizes) / sizeof(batch_bench_sizes[0])); s++)
+        {
+            len = batch_bench_sizes[s];
+            if (!check_mode(mode, len))
+            {
+                printf("batch differs from single messages at size %zu\n",
+                       len);
+                return 1;
+            }
+
+            setup_jobs(bench_src, bench_dst, len);
+            for (uint32_t run = 0u; run < BATCH_BENCH_RUNS; run++)
+            {
+                for (uint32_t v = 0u; v < 2u; v++)
+                {
+                    ns = time_message((v == 0u) ? run_per_message : run_batch,
+                                      mode);
+                    if (ns < 0.0)
+                    {
+                        printf("AES failed at size %zu\n", len);
+                        return 1;
+                    }
+                    best[v] = ((run == 0u) || (ns < best[v])) ? ns : best[v];
+                }
+            }
+            printf("%-4s %6zu %15.1f %12.1f %10.1f %7.2fx\n",
+                   (mode == AES_BATCH_CTR) ? "CTR" : "CFB", len, best[0],
+                   best[1], best[0] - best[1], best[0] / best[1]);
+        }
+    }
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,309 @@
+/******************************************************************************
+* File Name: ble_sc_bench.c
+*
+* Description: Host check and benchmark of the LE Secure Connections functions.
+* f4, f5, f6 and g2 are run on the sample data of the Bluetooth Core
+* Specification (Vol 3, Part H, Appendix D) and then timed per call. Built and
+* run by 'make bench'.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "ble_sc.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Calls per function and run */
+#define BLE_SC_BENCH_CALLS                   (20000u)
+
+/* Runs per function; the fastest one is reported */
+#define BLE_SC_BENCH_RUNS                    (7u)
+
+/* g2 of the sample data */
+#define SAMPLE_G2                            (0x2F9ED5BAu)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Sample data, most significant byte first. f4 and g2 share U, V and X;
+ * f5 and f6 use X as N1 and Y as N2. */
+static const uint8_t sample_u[BLE_SC_PUBLIC_KEY_X_SIZE] =
+{
+    0x20u, 0xB0u, 0x03u, 0xD2u, 0xF2u, 0x97u, 0xBEu, 0x2Cu,
+    0x5Eu, 0x2Cu, 0x83u, 0xA7u, 0xE9u, 0xF9u, 0xA5u, 0xB9u,
+    0xEFu, 0xF4u, 0x91u, 0x11u, 0xACu, 0xF4u, 0xFDu, 0xDBu,
+    0xCCu, 0x03u, 0x01u, 0x48u, 0x0Eu, 0x35u, 0x9Du, 0xE6u,
+};
+
+static const uint8_t sample_v[BLE_SC_PUBLIC_KEY_X_SIZE] =
+{
+    0x55u, 0x18u, 0x8Bu, 0x3Du, 0x32u, 0xF6u, 0xBBu, 0x9Au,
+    0x90u, 0x0Au, 0xFCu, 0xFBu, 0xEEu, 0xD4u, 0xE7u, 0x2Au,
+    0x59u, 0xCBu, 0x9Au, 0xC2u, 0xF1u, 0x9Du, 0x7Cu, 0xFBu,
+    0x6Bu, 0x4Fu, 0xDDu, 0x49u, 0xF4u, 0x7Fu, 0xC5u, 0xFDu,
+};
+
+static const uint8_t sample_x[BLE_SC_NONCE_SIZE] =
+{
+    0xD5u, 0xCBu, 0x84u, 0x54u, 0xD1u, 0x77u, 0x73u, 0x3Eu,
+    0xFFu, 0xFFu, 0xB2u, 0xECu, 0x71u, 0x2Bu, 0xAEu, 0xABu,
+};
+
+static const uint8_t sample_y[BLE_SC_NONCE_SIZE] =
+{
+    0xA6u, 0xE8u, 0xE7u, 0xCCu, 0x25u, 0xA7u, 0x5Fu, 0x6Eu,
+    0x21u, 0x65u, 0x83u, 0xF7u, 0xFFu, 0x3Du, 0xC4u, 0xCFu,
+};
+
+static const uint8_t sample_w[BLE_SC_DHKEY_SIZE] =
+{
+    0xECu, 0x02u, 0x34u, 0xA3u, 0x57u, 0xC8u, 0xADu, 0x05u,
+    0x34u, 0x10u, 0x10u, 0xA6u, 0x0Au, 0x39u, 0x7Du, 0x9Bu,
+    0x99u, 0x79u, 0x6Bu, 0x13u, 0xB4u, 0xF8u, 0x66u, 0xF1u,
+    0x86u, 0x8Du, 0x34u, 0xF3u, 0x73u, 0xBFu, 0xA6u, 0x98u,
+};
+
+static const uint8_t sample_a1[BLE_SC_ADDRESS_SIZE] =
+{
+    0x00u, 0x56u, 0x12u, 0x37u, 0x37u, 0xBFu, 0xCEu,
+};
+
+static const uint8_t sample_a2[BLE_SC_ADDRESS_SIZE] =
+{
+    0x00u, 0xA7u, 0x13u, 0x70u, 0x2Du, 0xCFu, 0xC1u,
+};
+
+static const uint8_t sample_r[BLE_SC_NONCE_SIZE] =
+{
+    0x12u, 0xA3u, 0x34u, 0x3Bu, 0xB4u, 0x53u, 0xBBu, 0x54u,
+    0x08u, 0xDAu, 0x42u, 0xD2u, 0x0Cu, 0x2Du, 0x0Fu, 0xC8u,
+};
+
+static const uint8_t sample_io_cap[BLE_SC_IO_CAP_SIZE] =
+{
+    0x01u, 0x01u, 0x02u,
+};
+
+static const uint8_t sample_f4[BLE_SC_KEY_SIZE] =
+{
+    0xF2u, 0xC9u, 0x16u, 0xF1u, 0x07u, 0xA9u, 0xBDu, 0x1Cu,
+    0xF1u, 0xEDu, 0xA1u, 0xBEu, 0xA9u, 0x74u, 0x87u, 0x2Du,
+};
+
+static const uint8_t sample_mac_key[BLE_SC_KEY_SIZE] =
+{
+    0x29u, 0x65u, 0xF1u, 0x76u, 0xA1u, 0x08u, 0x4Au, 0x02u,
+    0xFDu, 0x3Fu, 0x6Au, 0x20u, 0xCEu, 0x63u, 0x6Eu, 0x20u,
+};
+
+static const uint8_t sample_ltk[BLE_SC_KEY_SIZE] =
+{
+    0x69u, 0x86u, 0x79u, 0x11u, 0x69u, 0xD7u, 0xCDu, 0x23u,
+    0x98u, 0x05u, 0x22u, 0xB5u, 0x94u, 0x75u, 0x0Au, 0x38u,
+};
+
+static const uint8_t sample_f6[BLE_SC_KEY_SIZE] =
+{
+    0xE3u, 0xC4u, 0x73u, 0x98u, 0x9Cu, 0xD0u, 0xE8u, 0xC5u,
+    0xD2u, 0x6Cu, 0x0Bu, 0x09u, 0xDAu, 0x95u, 0x8Fu, 0x61u,
+};
+
+static ble_sc_t bench_ctx;
+
+/*******************************************************************************
+* Function Name: run_f4
+********************************************************************************
+* Summary: f4 on the sample data; true if it matched.
+*
+*******************************************************************************/
+static bool run_f4(void)
+{
+    uint8_t out[BLE_SC_KEY_SIZE];
+
+    return (ble_sc_f4(&bench_ctx, sample_u, sample_v, sample_x, 0u, out) ==
+            CY_CRYPTOLITE_SUCCESS) &&
+           (memcmp(out, sample_f4, sizeof(out)) == 0);
+}
+
+/*******************************************************************************
+* Function Name: run_f5
+********************************************************************************
+* Summary: f5 on the sample data; true if it matched.
+*
+*******************************************************************************/
+static bool run_f5(void)
+{
+    uint8_t mac_key[BLE_SC_KEY_SIZE];
+    uint8_t ltk[BLE_SC_KEY_SIZE];
+
+    return (ble_sc_f5(&bench_ctx, sample_w, sample_x, sample_y, sample_a1,
+                      sample_a2, mac_key, ltk) == CY_CRYPTOLITE_SUCCESS) &&
+           (memcmp(mac_key, sample_mac_key, sizeof(mac_key)) == 0) &&
+           (memcmp(ltk, sample_ltk, sizeof(ltk)) == 0);
+}
+
+/*******************************************************************************
+* Function Name: run_f6
+********************************************************************************
+* Summary: f6 on the sample data; true if it matched.
+*
+*******************************************************************************/
+static bool run_f6(void)
+{
+    uint8_t out[BLE_SC_KEY_SIZE];
+
+    return (ble_sc_f6(&bench_ctx, sample_mac_key, sample_x, sample_y,
+                      sample_r, sample_io_cap, sample_a1, sample_a2, out) ==
+            CY_CRYPTOLITE_SUCCESS) &&
+           (memcmp(out, sample_f6, sizeof(out)) == 0);
+}
+
+/*******************************************************************************
+* Function Name: run_g2
+********************************************************************************
+* Summary: g2 on the sample data; true if it matched.
+*
+*******************************************************************************/
+static bool run_g2(void)
+{
+    uint32_t value = 0u;
+
+    return (ble_sc_g2(&bench_ctx, sample_u, sample_v, sample_x, sample_y,
+                      &value) == CY_CRYPTOLITE_SUCCESS) &&
+           (value == SAMPLE_G2);
+}
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary: Monotonic time in nanoseconds.
+*
+*******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: time_call
+********************************************************************************
+* Summary: Returns the best average time of one call in nanoseconds, or a
+*          negative value if a call failed.
+*
+*******************************************************************************/
+static double time_call(bool (*fn)(void))
+{
+    double best_ns = 0.0;
+    double start;
+    double ns;
+
+    for (uint32_t run = 0u; run < BLE_SC_BENCH_RUNS; run++)
+    {
+        start = now_ns();
+        for (uint32_t i = 0u; i < BLE_SC_BENCH_CALLS; i++)
+        {
+            if (!fn())
+            {
+                return -1.0;
+            }
+        }
+        ns = (now_ns() - start) / (double)BLE_SC_BENCH_CALLS;
+        best_ns = ((run == 0u) || (ns < best_ns)) ? ns : best_ns;
+    }
+    return best_ns;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Checks each function on the sample data, then prints its time per
+*          call, including the comparison with the expected value.
+*
+*******************************************************************************/
+int main(void)
+{
+    static const struct
+    {
+        char const *name;
+        bool      (*fn)(void);
+    } functions[] =
+    {
+        { "f4", run_f4 }, { "f5", run_f5 }, { "f6", run_f6 }, { "g2", run_g2 },
+    };
+    double ns;
+
+    if (ble_sc_init(&bench_ctx) != CY_CRYPTOLITE_SUCCESS)
+    {
+        printf("BLE SC init failed\n");
+        return 1;
+    }
+
+    for (size_t i = 0u; i < (sizeof(functions) / sizeof(functions[0])); i++)
+    {
+        if (!functions[i].fn())
+        {
+            printf("%s sample data failed\n", functions[i].name);
+            return 1;
+        }
+    }
+    printf("f4, f5, f6 and g2 sample data ok\n");
+
+    printf("%4s %10s %12s\n", "func", "ns/call", "calls/s");
+    for (size_t i = 0u; i < (sizeof(functions) / sizeof(functions[0])); i++)
+    {
+        ns = time_call(functions[i].fn);
+        if (ns < 0.0)
+        {
+            printf("%s failed\n", functions[i].name);
+            return 1;
+        }
+        printf("%4s %10.1f %12.0f\n", functions[i].name, ns, 1e9 / ns);
+    }
+
+    (void)ble_sc_deinit(&bench_ctx);
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,485 @@
+/******************************************************************************
+* File Name: ccm_bench.c
+*
+* Description: Host check and benchmark of AES-CCM. It runs SP 800-38C examples
+* 1 to 4 and RFC 3610 packet 1 in place and out of place, checks that a
+* tampered tag is rejected with the output wiped, then times aes_ccm_encrypt()
+* against a two-pass composition that computes the CBC-MAC block by block and
+* then encrypts with Cy_Cryptolite_Aes_Ctr(). Built and run by 'make bench';
+* 'make check' runs it with the argument 'check', which skips the timing.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_ccm.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CCM_BENCH_MAX_SIZE                   (4096u)
+
+/* Associated data of SP 800-38C example 4: 2^16 bytes of 00..FF */
+#define CCM_BENCH_LONG_AAD_SIZE              (65536u)
+
+/* Bytes encrypted per size, so small sizes run many calls */
+#define CCM_BENCH_TOTAL_BYTES                (1024u * 1024u)
+
+/* Runs per size and variant, interleaved; the fastest one is reported */
+#define CCM_BENCH_RUNS                       (7u)
+
+/* Nonce, associated data and tag lengths of the timed messages, as in BLE */
+#define CCM_BENCH_NONCE_LENGTH               (13u)
+#define CCM_BENCH_AAD_LENGTH                 (8u)
+#define CCM_BENCH_TAG_LENGTH                 (8u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef struct
+{
+    char const    *name;
+    uint8_t const *key;
+    uint8_t const *nonce;
+    size_t         nonce_len;
+    uint8_t const *aad;
+    size_t         aad_len;
+    uint8_t const *plaintext;
+    size_t         len;
+    size_t         tag_len;
+    /* Ciphertext followed by the tag */
+    uint8_t const *output;
+} ccm_bench_case_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* 00..FF, the source of most inputs of the test vectors */
+static uint8_t ramp[256];
+static uint8_t long_aad[CCM_BENCH_LONG_AAD_SIZE];
+
+static const uint8_t rfc3610_nonce[13] =
+{
+    0x00u, 0x00u, 0x00u, 0x03u, 0x02u, 0x01u, 0x00u, 0xA0u,
+    0xA1u, 0xA2u, 0xA3u, 0xA4u, 0xA5u,
+};
+
+static const uint8_t ex1_output[8] =
+{
+    0x71u, 0x62u, 0x01u, 0x5Bu, 0x4Du, 0xACu, 0x25u, 0x5Du,
+};
+
+static const uint8_t ex2_output[22] =
+{
+    0xD2u, 0xA1u, 0xF0u, 0xE0u, 0x51u, 0xEAu, 0x5Fu, 0x62u,
+    0x08u, 0x1Au, 0x77u, 0x92u, 0x07u, 0x3Du, 0x59u, 0x3Du,
+    0x1Fu, 0xC6u, 0x4Fu, 0xBFu, 0xACu, 0xCDu,
+};
+
+static const uint8_t ex3_output[32] =
+{
+    0xE3u, 0xB2u, 0x01u, 0xA9u, 0xF5u, 0xB7u, 0x1Au, 0x7Au,
+    0x9Bu, 0x1Cu, 0xEAu, 0xECu, 0xCDu, 0x97u, 0xE7u, 0x0Bu,
+    0x61u, 0x76u, 0xAAu, 0xD9u, 0xA4u, 0x42u, 0x8Au, 0xA5u,
+    0x48u, 0x43u, 0x92u, 0xFBu, 0xC1u, 0xB0u, 0x99u, 0x51u,
+};
+
+static const uint8_t ex4_output[46] =
+{
+    0x69u, 0x91u, 0x5Du, 0xADu, 0x1Eu, 0x84u, 0xC6u, 0x37u,
+    0x6Au, 0x68u, 0xC2u, 0x96u, 0x7Eu, 0x4Du, 0xABu, 0x61u,
+    0x5Au, 0xE0u, 0xFDu, 0x1Fu, 0xAEu, 0xC4u, 0x4Cu, 0xC4u,
+    0x84u, 0x82u, 0x85u, 0x29u, 0x46u, 0x3Cu, 0xCFu, 0x72u,
+    0xB4u, 0xACu, 0x6Bu, 0xECu, 0x93u, 0xE8u, 0x59u, 0x8Eu,
+    0x7Fu, 0x0Du, 0xADu, 0xBCu, 0xEAu, 0x5Bu,
+};
+
+static const uint8_t rfc3610_packet1_output[31] =
+{
+    0x58u, 0x8Cu, 0x97u, 0x9Au, 0x61u, 0xC6u, 0x63u, 0xD2u,
+    0xF0u, 0x66u, 0xD0u, 0xC2u, 0xC0u, 0xF9u, 0x89u, 0x80u,
+    0x6Du, 0x5Fu, 0x6Bu, 0x61u, 0xDAu, 0xC3u, 0x84u, 0x17u,
+    0xE8u, 0xD1u, 0x2Cu, 0xFDu, 0xF9u, 0x26u, 0xE0u,
+};
+static const ccm_bench_case_t ccm_cases[] =
+{
+    {
+        "SP 800-38C example 1", &ramp[0x40], &ramp[0x10], 7u, &ramp[0x00], 8u,
+        &ramp[0x20], 4u, 4u, ex1_output
+    },
+    {
+        "SP 800-38C example 2", &ramp[0x40], &ramp[0x10], 8u, &ramp[0x00], 16u,
+        &ramp[0x20], 16u, 6u, ex2_output
+    },
+    {
+        "SP 800-38C example 3", &ramp[0x40], &ramp[0x10], 12u, &ramp[0x00], 20u,
+        &ramp[0x20], 24u, 8u, ex3_output
+    },
+    {
+        "SP 800-38C example 4", &ramp[0x40], &ramp[0x10], 13u, long_aad,
+        CCM_BENCH_LONG_AAD_SIZE, &ramp[0x20], 32u, 14u, ex4_output
+    },
+    {
+        "RFC 3610 packet 1", &ramp[0xC0], rfc3610_nonce, 13u, &ramp[0x00], 8u,
+        &ramp[0x08], 23u, 8u, rfc3610_packet1_output
+    },
+};
+
+static const size_t ccm_bench_sizes[] = { 16u, 64u, 251u, 1024u, 4096u };
+
+static aes_session_t bench_session;
+static uint8_t bench_src[CCM_BENCH_MAX_SIZE];
+static uint8_t bench_dst[CCM_BENCH_MAX_SIZE];
+static uint8_t bench_ref[CCM_BENCH_MAX_SIZE];
+
+/*******************************************************************************
+* Function Name: is_zero
+********************************************************************************
+* Summary: Returns true if all len bytes of buf are zero.
+*
+*******************************************************************************/
+static bool is_zero(uint8_t const *buf, size_t len)
+{
+    uint8_t acc = 0u;
+
+    for (size_t i = 0u; i < len; i++)
+    {
+        acc |= buf[i];
+    }
+    return (acc == 0u);
+}
+
+/*******************************************************************************
+* Function Name: check_case
+********************************************************************************
+* Summary: Returns true if case c encrypts to its ciphertext and tag and
+*          decrypts back as authentic, both in place and out of place, and
+*          is rejected with its output wiped when one tag bit is flipped.
+*
+*******************************************************************************/
+static bool check_case(ccm_bench_case_t const *c)
+{
+    aes_ccm_params_t params =
+    {
+        c->nonce, c->nonce_len, c->aad, c->aad_len, c->tag_len
+    };
+    uint8_t const *ciphertext = c->output;
+    uint8_t const *expected_tag = &c->output[c->len];
+    uint8_t tag[AES_CCM_MAX_TAG_LENGTH];
+    bool authentic = false;
+    bool pass;
+
+    pass = (aes_session_load(&bench_session, c->key) == CY_CRYPTOLITE_SUCCESS);
+
+    /* Out of place, then in place */
+    pass = pass &&
+           (aes_ccm_encrypt(&bench_session, &params, bench_dst, c->plaintext,
+                            c->len, tag) == CY_CRYPTOLITE_SUCCESS) &&
+           (memcmp(bench_dst, ciphertext, c->len) == 0) &&
+           (memcmp(tag, expected_tag, c->tag_len) == 0);
+    memcpy(bench_dst, c->plaintext, c->len);
+    pass = pass &&
+           (aes_ccm_encrypt(&bench_session, &params, bench_dst, bench_dst,
+                            c->len, tag) == CY_CRYPTOLITE_SUCCESS) &&
+           (memcmp(bench_dst, ciphertext, c->len) == 0) &&
+           (memcmp(tag, expected_tag, c->tag_len) == 0);
+
+    pass = pass &&
+           (aes_ccm_decrypt(&bench_session, &params, bench_dst, ciphertext,
+                            c->len, expected_tag, &authentic) == CY_CRYPTOLITE_SUCCESS) &&
+           authentic && (memcmp(bench_dst, c->plaintext, c->len) == 0);
+    memcpy(bench_dst, ciphertext, c->len);
+    authentic = false;
+    pass = pass &&
+           (aes_ccm_decrypt(&bench_session, &params, bench_dst, bench_dst,
+                            c->len, expected_tag, &authentic) == CY_CRYPTOLITE_SUCCESS) &&
+           authentic && (memcmp(bench_dst, c->plaintext, c->len) == 0);
+
+    /* Tampered tag, out of place and in place */
+    memcpy(tag, expected_tag, c->tag_len);
+    tag[c->tag_len - 1u] ^= 0x80u;
+    memset(bench_dst, 0xA5, c->len);
+    pass = pass &&
+           (aes_ccm_decrypt(&bench_session, &params, bench_dst, ciphertext,
+                            c->len, tag, &authentic) == CY_CRYPTOLITE_SUCCESS) &&
+           !authentic && is_zero(bench_dst, c->len);
+    memcpy(bench_dst, ciphertext, c->len);
+    authentic = true;
+    pass = pass &&
+           (aes_ccm_decrypt(&bench_session, &params, bench_dst, bench_dst,
+                            c->len, tag, &authentic) == CY_CRYPTOLITE_SUCCESS) &&
+           !authentic && is_zero(bench_dst, c->len);
+    return pass;
+}
+
+/*******************************************************************************
+* Function Name: two_pass_encrypt
+********************************************************************************
+* Summary: CCM as a composition of the block primitives: the CBC-MAC over B0,
+*          the associated data and the plaintext one Cy_Cryptolite_Aes_Ecb()
+*          call per block, then the payload in one Cy_Cryptolite_Aes_Ctr()
+*          call. Only short associated data (below 0xFF00 bytes) is handled.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t two_pass_encrypt(aes_ccm_params_t const *params,
+                                                  uint8_t *dst,
+                                                  uint8_t const *src,
+                                                  size_t len, uint8_t *tag)
+{
+    cy_stc_cryptolite_aes_state_t *state = &bench_session.state;
+    cy_en_cryptolite_status_t res;
+    uint8_t mac[AES_CCM_BLOCK_SIZE] = { 0u };
+    uint8_t counter[AES_CCM_BLOCK_SIZE] = { 0u };
+    uint8_t keystream[AES_CCM_BLOCK_SIZE];
+    size_t length_size = AES_CCM_BLOCK_SIZE - 1u - params->nonce_len;
+    size_t header_len = 2u + params->aad_len;
+    uint32_t offset = 0u;
+    size_t chunk;
+
+    /* Pass 1: CBC-MAC of B0, the length-prefixed associated data and the
+     * plaintext */
+    mac[0] = (uint8_t)(((params->aad_len != 0u) ? 0x40u : 0u) |
+                       (((params->tag_len - 2u) / 2u) << 3) |
+                       (length_size - 1u));
+    memcpy(&mac[1], params->nonce, params->nonce_len);
+    for (size_t i = 0u; i < length_size; i++)
+    {
+        mac[AES_CCM_BLOCK_SIZE - 1u - i] = (uint8_t)(len >> (8u * i));
+    }
+    res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, mac, mac, state);
+
+    for (size_t pos = 0u; (res == CY_CRYPTOLITE_SUCCESS) &&
+         (params->aad_len != 0u) && (pos < header_len); pos++)
+    {
+        mac[pos % AES_CCM_BLOCK_SIZE] ^=
+            (pos == 0u) ? (uint8_t)(params->aad_len >> 8) :
+            (pos == 1u) ? (uint8_t)params->aad_len : params->aad[pos - 2u];
+        if ((((pos + 1u) % AES_CCM_BLOCK_SIZE) == 0u) || ((pos + 1u) == header_len))
+        {
+            res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, mac, mac, state);
+        }
+    }
+
+    for (size_t pos = 0u; (res == CY_CRYPTOLITE_SUCCESS) && (pos < len);
+         pos += chunk)
+    {
+        chunk = ((len - pos) < AES_CCM_BLOCK_SIZE) ? (len - pos) : AES_CCM_BLOCK_SIZE;
+        for (size_t i = 0u; i < chunk; i++)
+        {
+            mac[i] ^= src[pos + i];
+        }
+        res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, mac, mac, state);
+    }
+
+    /* Pass 2: keystream of A0 for the tag, then CTR from A1 */
+    counter[0] = (uint8_t)(length_size - 1u);
+    memcpy(&counter[1], params->nonce, params->nonce_len);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, keystream, counter, state);
+    }
+    for (size_t i = 0u; i < params->tag_len; i++)
+    {
+        tag[i] = mac[i] ^ keystream[i];
+    }
+    counter[AES_CCM_BLOCK_SIZE - 1u] = 1u;
+    if ((res == CY_CRYPTOLITE_SUCCESS) && (len != 0u))
+    {
+        res = Cy_Cryptolite_Aes_Ctr(CRYPTOLITE, (uint32_t)len, &offset, counter,
+                                    dst, src, state);
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary: Monotonic time in nanoseconds.
+*
+*******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: time_encrypt
+********************************************************************************
+* Summary: Returns the average time of one encryption of len bytes in
+*          nanoseconds, fused or two-pass, or a negative value if a call
+*          failed.
+*
+*******************************************************************************/
+static double time_encrypt(size_t len, bool fused)
+{
+    aes_ccm_params_t params =
+    {
+        &ramp[0x10], CCM_BENCH_NONCE_LENGTH, ramp, CCM_BENCH_AAD_LENGTH,
+        CCM_BENCH_TAG_LENGTH
+    };
+    uint8_t tag[AES_CCM_MAX_TAG_LENGTH];
+    size_t calls = CCM_BENCH_TOTAL_BYTES / len;
+    cy_en_cryptolite_status_t res;
+    double start = now_ns();
+
+    for (size_t i = 0u; i < calls; i++)
+    {
+        res = fused ? aes_ccm_encrypt(&bench_session, &params, bench_dst,
+                                      bench_src, len, tag)
+                    : two_pass_encrypt(&params, bench_dst, bench_src, len, tag);
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            return -1.0;
+        }
+        /* Keep the calls from being merged or dropped */
+        __asm__ volatile("" : : "r"(bench_dst) : "memory");
+    }
+    return (now_ns() - start) / (double)calls;
+}
+
+/*******************************************************************************
+* Function Name: check_two_pass
+********************************************************************************
+* Summary: Returns true if the two-pass composition produces the same output
+*          and tag as aes_ccm_encrypt() at len bytes, so that the timings
+*          compare equal work.
+*
+*******************************************************************************/
+static bool check_two_pass(size_t len)
+{
+    aes_ccm_params_t params =
+    {
+        &ramp[0x10], CCM_BENCH_NONCE_LENGTH, ramp, CCM_BENCH_AAD_LENGTH,
+        CCM_BENCH_TAG_LENGTH
+    };
+    uint8_t tag[AES_CCM_MAX_TAG_LENGTH];
+    uint8_t ref_tag[AES_CCM_MAX_TAG_LENGTH];
+
+    return (aes_ccm_encrypt(&bench_session, &params, bench_ref, bench_src, len,
+                            ref_tag) == CY_CRYPTOLITE_SUCCESS) &&
+           (two_pass_encrypt(&params, bench_dst, bench_src, len, tag) ==
+            CY_CRYPTOLITE_SUCCESS) &&
+           (memcmp(bench_dst, bench_ref, len) == 0) &&
+           (memcmp(tag, ref_tag, CCM_BENCH_TAG_LENGTH) == 0);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Checks the test vectors, then, unless the argument is "check",
+*          prints the best time per encryption for the fused and the
+*          two-pass implementation and the throughput of the fused one.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    double best[2];
+    double ns;
+
+    for (size_t i = 0u; i < sizeof(ramp); i++)
+    {
+        ramp[i] = (uint8_t)i;
+    }
+    for (size_t i = 0u; i < sizeof(long_aad); i++)
+    {
+        long_aad[i] = (uint8_t)i;
+    }
+
+    for (size_t i = 0u; i < (sizeof(ccm_cases) / sizeof(ccm_cases[0])); i++)
+    {
+        if (!check_case(&ccm_cases[i]))
+        {
+            printf("CCM %s failed\n", ccm_cases[i].name);
+            return 1;
+        }
+    }
+    printf("CCM SP 800-38C examples 1-4 and RFC 3610 packet 1 ok, "
+           "in place and out of place, tampered tags rejected\n");
+
+    if ((argc > 1) && (strcmp(argv[1], "check") == 0))
+    {
+        (void)aes_session_unload(&bench_session);
+        return 0;
+    }
+
+    for (size_t i = 0u; i < sizeof(bench_src); i++)
+    {
+        bench_src[i] = (uint8_t)(i * 7u);
+    }
+    if (aes_session_load(&bench_session, &ramp[0x40]) != CY_CRYPTOLITE_SUCCESS)
+    {
+        return 1;
+    }
+
+    printf("%6s %12s %12s %10s\n", "size", "fused ns", "two-pass ns", "MB/s");
+    for (size_t s = 0u; s < (sizeof(ccm_bench_sizes) / sizeof(ccm_bench_sizes[0])); s++)
+    {
+        size_t size = ccm_bench_sizes[s];
+
+        if (!check_two_pass(size))
+        {
+            printf("two-pass CCM differs at size %zu\n", size);
+            return 1;
+        }
+        for (uint32_t run = 0u; run < CCM_BENCH_RUNS; run++)
+        {
+            for (uint32_t v = 0u; v < 2u; v++)
+            {
+                ns = time_encrypt(size, (v == 0u));
+                if (ns < 0.0)
+                {
+                    printf("CCM failed at size %zu\n", size);
+                    return 1;
+                }
+                best[v] = ((run == 0u) || (ns < best[v])) ? ns : best[v];
+            }
+        }
+        printf("%6zu %12.1f %12.1f %10.1f\n", size, best[0], best[1],
+               (double)size * 1e3 / best[0]);
+    }
+
+    (void)aes_session_unload(&bench_session);
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,390 @@
+/******************************************************************************
+* File Name: ctr_cache_bench.c
+*
+* Description: Host check and benchmark of the CTR keystream cache. It checks
+* that aes_ctr_cache_crypt() gives the same output as aes_ctr_update() with no,
+* partial and full keystream coverage, in place and out of place, and after a
+* key reload or an IV change has made the cached keystream stale, then times an
+* inline aes_ctr message against a cache hit for menu-sized messages. Built and
+* run by 'make bench'; 'make check' runs it with the argument 'check', which
+* skips the timing.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_ctr_cache.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Covers the 100-byte menu message, as CTR_KEYSTREAM_CACHE_BLOCKS in main.c */
+#define CTR_CACHE_BENCH_BLOCKS               (7u)
+#define CTR_CACHE_BENCH_MAX_SIZE             (CTR_CACHE_BENCH_BLOCKS * \
+                                              AES_CTR_BLOCK_SIZE)
+
+/* Partial coverage in the check */
+#define CTR_CACHE_BENCH_PARTIAL_BLOCKS       (3u)
+
+/* Messages per size and variant */
+#define CTR_CACHE_BENCH_CALLS                (20000u)
+
+/* Runs per size and variant, interleaved; the fastest one is reported */
+#define CTR_CACHE_BENCH_RUNS                 (7u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const size_t ctr_cache_bench_sizes[] = { 5u, 16u, 32u, 64u, 99u };
+
+static const uint8_t bench_key[2][AES_SESSION_KEY_SIZE] =
+{
+    {
+        0xAAu, 0xBBu, 0xCCu, 0xDDu, 0xEEu, 0xFFu, 0xFFu, 0xEEu,
+        0xDDu, 0xCCu, 0xBBu, 0xAAu, 0xAAu, 0xBBu, 0xCCu, 0xDDu,
+    },
+    {
+        0x2Bu, 0x7Eu, 0x15u, 0x16u, 0x28u, 0xAEu, 0xD2u, 0xA6u,
+        0xABu, 0xF7u, 0x15u, 0x88u, 0x09u, 0xCFu, 0x4Fu, 0x3Cu,
+    },
+};
+
+/* The second IV wraps the low counter byte inside the cached range */
+static const uint8_t bench_iv[2][AES_CTR_BLOCK_SIZE] =
+{
+    {
+        0x00u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u,
+        0x08u, 0x09u, 0x0Au, 0x0Bu, 0x0Cu, 0x0Du, 0x0Eu, 0x0Fu,
+    },
+    {
+        0xF0u, 0xF1u, 0xF2u, 0xF3u, 0xF4u, 0xF5u, 0xF6u, 0xF7u,
+        0xF8u, 0xF9u, 0xFAu, 0xFBu, 0xFCu, 0xFDu, 0xFEu, 0xFDu,
+    },
+};
+
+/* The cache's session and a separate one for the reference output, so
+ * computing references does not bump the cache session's generation */
+static aes_session_t bench_session;
+static aes_session_t ref_session;
+static aes_ctr_cache_t bench_cache;
+static uint8_t bench_keystream[CTR_CACHE_BENCH_MAX_SIZE];
+static uint8_t bench_src[CTR_CACHE_BENCH_MAX_SIZE];
+static uint8_t bench_dst[CTR_CACHE_BENCH_MAX_SIZE];
+static uint8_t bench_ref[CTR_CACHE_BENCH_MAX_SIZE];
+
+/*******************************************************************************
+* Function Name: message_inline
+********************************************************************************
+* Summary: One CTR message through aes_ctr, as main.c does without the cache.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t message_inline(aes_session_t *session,
+                                                uint8_t const *iv,
+                                                uint8_t *dst,
+                                                uint8_t const *src,
+                                                size_t len)
+{
+    cy_en_cryptolite_status_t res;
+    aes_ctr_ctx_t ctr;
+
+    res = aes_ctr_init(&ctr, session, iv);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = aes_ctr_update(&ctr, dst, src, len);
+    }
+    aes_ctr_final(&ctr);
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: reference
+********************************************************************************
+* Summary: Computes the expected output of len bytes into bench_ref.
+*
+*******************************************************************************/
+static bool reference(uint8_t const *key, uint8_t const *iv, size_t len)
+{
+    return (aes_session_load(&ref_session, key) == CY_CRYPTOLITE_SUCCESS) &&
+           (message_inline(&ref_session, iv, bench_ref, bench_src, len) ==
+            CY_CRYPTOLITE_SUCCESS);
+}
+
+/*******************************************************************************
+* Function Name: crypt_matches
+********************************************************************************
+* Summary: Runs aes_ctr_cache_crypt() out of place and in place for every
+*          length up to the cache size and compares with aes_ctr_update().
+*
+*******************************************************************************/
+static bool crypt_matches(uint8_t const *key, uint8_t const *iv)
+{
+    for (size_t len = 0u; len <= CTR_CACHE_BENCH_MAX_SIZE; len++)
+    {
+        if (!reference(key, iv, len))
+        {
+            return false;
+        }
+
+        memset(bench_dst, 0, sizeof(bench_dst));
+        if ((aes_ctr_cache_crypt(&bench_cache, &bench_session, iv, bench_dst,
+                                 bench_src, len) != CY_CRYPTOLITE_SUCCESS) ||
+            (memcmp(bench_dst, bench_ref, len) != 0))
+        {
+            return false;
+        }
+
+        memcpy(bench_dst, bench_src, len);
+        if ((aes_ctr_cache_crypt(&bench_cache, &bench_session, iv, bench_dst,
+                                 bench_dst, len) != CY_CRYPTOLITE_SUCCESS) ||
+            (memcmp(bench_dst, bench_ref, len) != 0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: fill_blocks
+********************************************************************************
+* Summary: Prepares the cache for key and IV and generates blocks keystream
+*          blocks one at a time, as the menu's idle loop does.
+*
+*******************************************************************************/
+static bool fill_blocks(uint8_t const *key, uint8_t const *iv, size_t blocks)
+{
+    if ((aes_session_load(&bench_session, key) != CY_CRYPTOLITE_SUCCESS) ||
+        (aes_ctr_cache_prepare(&bench_cache, &bench_session, iv) !=
+         CY_CRYPTOLITE_SUCCESS))
+    {
+        return false;
+    }
+    for (size_t i = 0u; i < blocks; i++)
+    {
+        if (aes_ctr_cache_fill(&bench_cache, 1u) != CY_CRYPTOLITE_SUCCESS)
+        {
+            return false;
+        }
+    }
+    return bench_cache.blocks == blocks;
+}
+
+/*******************************************************************************
+* Function Name: check_cache
+********************************************************************************
+* Summary: Checks aes_ctr_cache_crypt() against aes_ctr_update() for no,
+*          partial and full coverage under both IVs, after an IV change and
+*          after key reloads, including a reload of the key the keystream
+*          was generated with.
+*
+*******************************************************************************/
+static bool check_cache(void)
+{
+    size_t const coverage[] =
+    {
+        0u, CTR_CACHE_BENCH_PARTIAL_BLOCKS, CTR_CACHE_BENCH_BLOCKS
+    };
+
+    for (size_t v = 0u; v < 2u; v++)
+    {
+        for (size_t c = 0u; c < (sizeof(coverage) / sizeof(coverage[0])); c++)
+        {
+            if (!fill_blocks(bench_key[v], bench_iv[v], coverage[c]) ||
+                !crypt_matches(bench_key[v], bench_iv[v]))
+            {
+                printf("CTR cache: %zu of %u blocks, key/IV %zu differs\n",
+                       coverage[c], CTR_CACHE_BENCH_BLOCKS, v);
+                return false;
+            }
+        }
+    }
+
+    /* IV change: the keystream for IV 1 must not be used for IV 0, and
+     * preparing for IV 0 must start over */
+    if (!crypt_matches(bench_key[1], bench_iv[0]) ||
+        (aes_ctr_cache_prepare(&bench_cache, &bench_session, bench_iv[0]) !=
+         CY_CRYPTOLITE_SUCCESS) || (bench_cache.blocks != 0u))
+    {
+        printf("CTR cache: IV change differs\n");
+        return false;
+    }
+
+    /* Key reload: the full keystream for key 0 goes stale on loading key 1,
+     * and again on loading key 0 anew */
+    for (size_t v = 0u; v < 2u; v++)
+    {
+        if (!fill_blocks(bench_key[0], bench_iv[0], CTR_CACHE_BENCH_BLOCKS) ||
+            (aes_session_unload(&bench_session) != CY_CRYPTOLITE_SUCCESS) ||
+            (aes_session_load(&bench_session, bench_key[v]) !=
+             CY_CRYPTOLITE_SUCCESS) ||
+            !aes_ctr_cache_pending(&bench_cache) ||
+            !crypt_matches(bench_key[v], bench_iv[0]))
+        {
+            printf("CTR cache: stale keystream used after reloading key %zu\n",
+                   v);
+            return false;
+        }
+
+        /* Filling regenerates the keystream for the new key */
+        if ((aes_ctr_cache_fill(&bench_cache, CTR_CACHE_BENCH_BLOCKS) !=
+             CY_CRYPTOLITE_SUCCESS) ||
+            (bench_cache.blocks != CTR_CACHE_BENCH_BLOCKS) ||
+            aes_ctr_cache_pending(&bench_cache) ||
+            !crypt_matches(bench_key[v], bench_iv[0]))
+        {
+            printf("CTR cache: refill after reloading key %zu differs\n", v);
+            return false;
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary: Monotonic time in nanoseconds.
+*
+*******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: time_message
+********************************************************************************
+* Summary: Returns the average time of one message in nanoseconds, inline or
+*          from the full cache, or a negative value if a call failed.
+*
+*******************************************************************************/
+static double time_message(size_t len, bool cached)
+{
+    cy_en_cryptolite_status_t res;
+    double start = now_ns();
+
+    for (uint32_t i = 0u; i < CTR_CACHE_BENCH_CALLS; i++)
+    {
+        res = cached ? aes_ctr_cache_crypt(&bench_cache, &bench_session,
+                                           bench_iv[0], bench_dst, bench_src,
+                                           len)
+                     : message_inline(&bench_session, bench_iv[0], bench_dst,
+                                      bench_src, len);
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            return -1.0;
+        }
+        /* Keep the calls from being merged or dropped */
+        __asm__ volatile("" : : "r"(bench_dst) : "memory");
+    }
+    return (now_ns() - start) / (double)CTR_CACHE_BENCH_CALLS;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Runs the checks, then, unless the argument is "check", prints the
+*          best time per message inline and from a full cache.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    double best[2];
+    double ns;
+
+    for (size_t i = 0u; i < sizeof(bench_src); i++)
+    {
+        bench_src[i] = (uint8_t)(i * 7u);
+    }
+    aes_ctr_cache_init(&bench_cache, bench_keystream, CTR_CACHE_BENCH_BLOCKS);
+
+    if (!check_cache())
+    {
+        return 1;
+    }
+    printf("CTR cache matches aes_ctr with 0, %u and %u of %u blocks, "
+           "after an IV change and after key reloads\n",
+           CTR_CACHE_BENCH_PARTIAL_BLOCKS, CTR_CACHE_BENCH_BLOCKS,
+           CTR_CACHE_BENCH_BLOCKS);
+
+    if ((argc > 1) && (strcmp(argv[1], "check") == 0))
+    {
+        aes_ctr_cache_clear(&bench_cache);
+        (void)aes_session_unload(&bench_session);
+        (void)aes_session_unload(&ref_session);
+        return 0;
+    }
+
+    if (!fill_blocks(bench_key[0], bench_iv[0], CTR_CACHE_BENCH_BLOCKS))
+    {
+        return 1;
+    }
+
+    printf("%6s %12s %12s %8s\n", "size", "inline ns", "hit ns", "speedup");
+    for (size_t s = 0u; s < (sizeof(ctr_cache_bench_sizes) / sizeof(ctr_cache_bench_sizes[0])); s++)
+    {
+        size_t size = ctr_cache_bench_sizes[s];
+
+        for (uint32_t run = 0u; run < CTR_CACHE_BENCH_RUNS; run++)
+        {
+            for (uint32_t v = 0u; v < 2u; v++)
+            {
+                ns = time_message(size, (v == 1u));
+                if (ns < 0.0)
+                {
+                    printf("CTR failed at size %zu\n", size);
+                    return 1;
+                }
+                best[v] = ((run == 0u) || (ns < best[v])) ? ns : best[v];
+            }
+        }
+        printf("%6zu %12.1f %12.1f %7.1fx\n", size, best[0], best[1],
+               best[0] / best[1]);
+    }
+
+    aes_ctr_cache_clear(&bench_cache);
+    (void)aes_session_unload(&bench_session);
+    (void)aes_session_unload(&ref_session);
+    return 0;
+}
+
+/* [] END OF FILE */
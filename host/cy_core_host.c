@@ -0,0 +1,93 @@
+/******************************************************************************
+* File Name: cy_core_host.c
+*
+* Description: Host implementation of the Cortex-M data watchpoint and trace
+* unit's cycle counter. DWT->CYCCNT is loaded from CLOCK_MONOTONIC whenever DWT
+* is accessed, scaled to SystemCoreClock, so code that times itself with the
+* cycle counter reports wall-clock time on the host.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include <time.h>
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+uint32_t SystemCoreClock = 1000000000u;
+
+CoreDebug_Type cy_host_core_debug;
+
+static DWT_Type host_dwt;
+
+/*******************************************************************************
+* Function Name: Cy_Host_Dwt
+********************************************************************************
+* Summary: Advances CYCCNT by the time elapsed since the previous access,
+*          provided trace and the counter are enabled, and returns the
+*          emulated register block.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  DWT_Type* - Emulated DWT registers
+*
+*******************************************************************************/
+DWT_Type *Cy_Host_Dwt(void)
+{
+    static uint64_t last_ns;
+    struct timespec now;
+    uint64_t now_ns;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    now_ns = ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+
+    if (((cy_host_core_debug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) != 0u) &&
+        ((host_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0u) && (last_ns != 0u))
+    {
+        host_dwt.CYCCNT += (uint32_t)(((now_ns - last_ns) *
+                                       (uint64_t)SystemCoreClock) /
+                                      1000000000u);
+    }
+    last_ns = now_ns;
+    return &host_dwt;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,763 @@
+/******************************************************************************
+* File Name: cy_cryptolite_model.c
+*
+* Description: Bit-exact software model of the Cryptolite block for host
+* builds. Implements the AES-128 (forward cipher only, as in hardware), SHA-256
+* and TRNG entry points of the PDL Cryptolite driver with the same argument
+* checks, return codes and side effects on the caller's IV, offset and context.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define AES128_ROUNDS                        (10u)
+
+#define ROTR32(x, n)                         (((x) >> (n)) | ((x) << (32u - (n))))
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+CRYPTOLITE_Type cy_cryptolite_model;
+
+static bool trng_seeded;
+static uint32_t (*trng_source)(void *arg);
+static void *trng_source_arg;
+/* Time the noise source takes per word, from CY_HOST_TRNG_WORD_NS; 0 returns
+ * words immediately */
+static uint64_t trng_word_ns;
+
+/* Degenerate noise source selected with CY_HOST_TRNG_FAULT, starting after
+ * CY_HOST_TRNG_FAULT_AFTER good words, to exercise the health tests */
+typedef enum
+{
+    TRNG_FAULT_NONE,
+    /* Every byte reads 0 */
+    TRNG_FAULT_ZERO,
+    /* The last good word repeats */
+    TRNG_FAULT_STUCK,
+    /* A quarter of the bytes read 0 */
+    TRNG_FAULT_BIASED,
+} trng_fault_t;
+
+static trng_fault_t trng_fault;
+static uint64_t trng_fault_after;
+static uint64_t trng_words;
+static uint32_t trng_last_word;
+
+static const uint8_t aes_sbox[256] =
+{
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+static const uint32_t sha256_k[64] =
+{
+    0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u,
+    0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u,
+    0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau,
+    0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u, 0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u,
+    0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
+    0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u, 0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u,
+    0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
+    0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u,
+};
+
+static const uint32_t sha256_iv[8] =
+{
+    0x6a09e667u, 0xbb67ae85u, 0x3c6ef372u, 0xa54ff53au,
+    0x510e527fu, 0x9b05688cu, 0x1f83d9abu, 0x5be0cd19u,
+};
+
+/*******************************************************************************
+* Function Name: load_be32 / store_be32
+********************************************************************************
+* Summary: Big-endian 32-bit load and store.
+*
+*******************************************************************************/
+static uint32_t load_be32(uint8_t const *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8)  |  (uint32_t)p[3];
+}
+
+static void store_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+/*******************************************************************************
+* Function Name: aes_expand_key
+********************************************************************************
+* Summary: FIPS-197 AES-128 key expansion.
+*
+*******************************************************************************/
+static void aes_expand_key(uint32_t rk[44], uint8_t const *key)
+{
+    static const uint8_t rcon[10] =
+        { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36 };
+    uint32_t i;
+
+    for (i = 0u; i < 4u; i++)
+    {
+        rk[i] = load_be32(&key[4u * i]);
+    }
+    for (i = 4u; i < 44u; i++)
+    {
+        uint32_t t = rk[i - 1u];
+        if ((i % 4u) == 0u)
+        {
+            t = ((uint32_t)aes_sbox[(t >> 16) & 0xFFu] << 24) |
+                ((uint32_t)aes_sbox[(t >> 8) & 0xFFu] << 16)  |
+                ((uint32_t)aes_sbox[t & 0xFFu] << 8)          |
+                 (uint32_t)aes_sbox[t >> 24];
+            t ^= (uint32_t)rcon[(i / 4u) - 1u] << 24;
+        }
+        rk[i] = rk[i - 4u] ^ t;
+    }
+}
+
+static uint8_t xtime(uint8_t x)
+{
+    return (uint8_t)((x << 1) ^ (((x >> 7) & 1u) * 0x1bu));
+}
+
+/*******************************************************************************
+* Function Name: aes_encrypt_block
+********************************************************************************
+* Summary: FIPS-197 AES-128 forward cipher on one block. dst may equal src.
+*
+*******************************************************************************/
+static void aes_encrypt_block(uint32_t const rk[44], uint8_t dst[16],
+                              uint8_t const src[16])
+{
+    uint8_t s[16];
+    uint8_t t[16];
+    uint32_t round;
+    uint32_t i;
+
+    for (i = 0u; i < 16u; i++)
+    {
+        s[i] = src[i] ^ (uint8_t)(rk[i / 4u] >> (24u - 8u * (i % 4u)));
+    }
+
+    for (round = 1u; round <= AES128_ROUNDS; round++)
+    {
+        /* SubBytes and ShiftRows */
+        for (i = 0u; i < 16u; i++)
+        {
+            t[i] = aes_sbox[s[(i + 4u * (i % 4u)) % 16u]];
+        }
+        /* MixColumns, skipped in the final round */
+        if (round != AES128_ROUNDS)
+        {
+            for (i = 0u; i < 16u; i += 4u)
+            {
+                uint8_t a0 = t[i];
+                uint8_t a1 = t[i + 1u];
+                uint8_t a2 = t[i + 2u];
+                uint8_t a3 = t[i + 3u];
+                uint8_t all = a0 ^ a1 ^ a2 ^ a3;
+                t[i]      ^= all ^ xtime(a0 ^ a1);
+                t[i + 1u] ^= all ^ xtime(a1 ^ a2);
+                t[i + 2u] ^= all ^ xtime(a2 ^ a3);
+                t[i + 3u] ^= all ^ xtime(a3 ^ a0);
+            }
+        }
+        /* AddRoundKey */
+        for (i = 0u; i < 16u; i++)
+        {
+            s[i] = t[i] ^ (uint8_t)(rk[4u * round + i / 4u] >> (24u - 8u * (i % 4u)));
+        }
+    }
+
+    memcpy(dst, s, 16u);
+}
+
+/*******************************************************************************
+* Function Name: ctr_increment
+********************************************************************************
+* Summary: Increments the 128-bit big-endian counter block.
+*
+*******************************************************************************/
+static void ctr_increment(uint8_t counter[16])
+{
+    int32_t i;
+
+    for (i = 15; i >= 0; i--)
+    {
+        counter[i]++;
+        if (counter[i] != 0u)
+        {
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+* PDL Cryptolite AES API
+*******************************************************************************/
+cy_en_cryptolite_status_t Cy_Cryptolite_Aes_Init(CRYPTOLITE_Type *base,
+                                    uint8_t const *key,
+                                    cy_stc_cryptolite_aes_state_t *aesState,
+                                    cy_stc_cryptolite_aes_buffers_t *aesBuffers)
+{
+    if ((base == NULL) || (key == NULL) || (aesState == NULL) || (aesBuffers == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    memset(aesBuffers, 0, sizeof(*aesBuffers));
+    memcpy(aesBuffers->key, key, CY_CRYPTOLITE_AES_KEY_SIZE);
+    aesState->buffers = aesBuffers;
+    aes_expand_key(aesState->round_keys, aesBuffers->key);
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+cy_en_cryptolite_status_t Cy_Cryptolite_Aes_Free(CRYPTOLITE_Type *base,
+                                    cy_stc_cryptolite_aes_state_t *aesState)
+{
+    if ((base == NULL) || (aesState == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    if (aesState->buffers != NULL)
+    {
+        memset(aesState->buffers, 0, sizeof(*aesState->buffers));
+    }
+    memset(aesState, 0, sizeof(*aesState));
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+cy_en_cryptolite_status_t Cy_Cryptolite_Aes_Ecb(CRYPTOLITE_Type *base,
+                                    uint8_t *dst,
+                                    uint8_t const *src,
+                                    cy_stc_cryptolite_aes_state_t *aesState)
+{
+    if ((base == NULL) || (dst == NULL) || (src == NULL) ||
+        (aesState == NULL) || (aesState->buffers == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    aes_encrypt_block(aesState->round_keys, dst, src);
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+cy_en_cryptolite_status_t Cy_Cryptolite_Aes_Cfb(CRYPTOLITE_Type *base,
+                                    cy_en_cryptolite_dir_mode_t dirMode,
+                                    uint32_t srcSize,
+                                    uint8_t *ivPtr,
+                                    uint8_t *dst,
+                                    uint8_t const *src,
+                                    cy_stc_cryptolite_aes_state_t *aesState)
+{
+    uint8_t *feedback;
+    uint8_t *keystream;
+    uint32_t block;
+    uint32_t i;
+
+    if ((base == NULL) || (ivPtr == NULL) || (aesState == NULL) ||
+        (aesState->buffers == NULL) ||
+        ((srcSize != 0u) && ((dst == NULL) || (src == NULL))))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if ((srcSize % CY_CRYPTOLITE_AES_BLOCK_SIZE) != 0u)
+    {
+        return CY_CRYPTOLITE_SIZE_NOT_X16;
+    }
+
+    feedback  = aesState->buffers->block0;
+    keystream = aesState->buffers->block1;
+    memcpy(feedback, ivPtr, CY_CRYPTOLITE_AES_BLOCK_SIZE);
+
+    for (block = 0u; block < srcSize; block += CY_CRYPTOLITE_AES_BLOCK_SIZE)
+    {
+        aes_encrypt_block(aesState->round_keys, keystream, feedback);
+        for (i = 0u; i < CY_CRYPTOLITE_AES_BLOCK_SIZE; i++)
+        {
+            uint8_t in = src[block + i];
+            dst[block + i] = in ^ keystream[i];
+            /* The ciphertext byte is fed back in both directions */
+            feedback[i] = (dirMode == CY_CRYPTOLITE_ENCRYPT) ? dst[block + i] : in;
+        }
+    }
+
+    memcpy(ivPtr, feedback, CY_CRYPTOLITE_AES_BLOCK_SIZE);
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+cy_en_cryptolite_status_t Cy_Cryptolite_Aes_Ctr(CRYPTOLITE_Type *base,
+                                    uint32_t srcSize,
+                                    uint32_t *srcOffset,
+                                    uint8_t ivPtr[CY_CRYPTOLITE_AES_BLOCK_SIZE],
+                                    uint8_t *dst,
+                                    uint8_t const *src,
+                                    cy_stc_cryptolite_aes_state_t *aesState)
+{
+    uint8_t *stream_block;
+    uint32_t offset;
+    uint32_t i;
+
+    if ((base == NULL) || (srcOffset == NULL) || (ivPtr == NULL) ||
+        (aesState == NULL) || (aesState->buffers == NULL) ||
+        (*srcOffset >= CY_CRYPTOLITE_AES_BLOCK_SIZE) ||
+        ((srcSize != 0u) && ((dst == NULL) || (src == NULL))))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    /* The keystream block of a partially used counter value is kept in the
+     * AES buffers, *srcOffset is the number of its bytes already consumed. */
+    stream_block = aesState->buffers->block2;
+    offset = *srcOffset;
+
+    for (i = 0u; i < srcSize; i++)
+    {
+        if (offset == 0u)
+        {
+            aes_encrypt_block(aesState->round_keys, stream_block, ivPtr);
+            ctr_increment(ivPtr);
+        }
+        dst[i] = src[i] ^ stream_block[offset];
+        offset = (offset + 1u) % CY_CRYPTOLITE_AES_BLOCK_SIZE;
+    }
+
+    *srcOffset = offset;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: sha256_process_block
+********************************************************************************
+* Summary: FIPS 180-4 SHA-256 compression of the context's message block.
+*
+*******************************************************************************/
+static void sha256_process_block(cy_stc_cryptolite_context_sha256_t *ctx)
+{
+    uint32_t *w = ctx->message_schedule;
+    uint32_t a, b, c, d, e, f, g, h;
+    uint32_t i;
+
+    for (i = 0u; i < 16u; i++)
+    {
+        w[i] = load_be32((uint8_t const *)&ctx->msgblock[i]);
+    }
+    for (i = 16u; i < 64u; i++)
+    {
+        uint32_t s0 = ROTR32(w[i - 15u], 7u) ^ ROTR32(w[i - 15u], 18u) ^ (w[i - 15u] >> 3);
+        uint32_t s1 = ROTR32(w[i - 2u], 17u) ^ ROTR32(w[i - 2u], 19u) ^ (w[i - 2u] >> 10);
+        w[i] = w[i - 16u] + s0 + w[i - 7u] + s1;
+    }
+
+    a = ctx->hash[0]; b = ctx->hash[1]; c = ctx->hash[2]; d = ctx->hash[3];
+    e = ctx->hash[4]; f = ctx->hash[5]; g = ctx->hash[6]; h = ctx->hash[7];
+
+    for (i = 0u; i < 64u; i++)
+    {
+        uint32_t s1 = ROTR32(e, 6u) ^ ROTR32(e, 11u) ^ ROTR32(e, 25u);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + sha256_k[i] + w[i];
+        uint32_t s0 = ROTR32(a, 2u) ^ ROTR32(a, 13u) ^ ROTR32(a, 22u);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    ctx->hash[0] += a; ctx->hash[1] += b; ctx->hash[2] += c; ctx->hash[3] += d;
+    ctx->hash[4] += e; ctx->hash[5] += f; ctx->hash[6] += g; ctx->hash[7] += h;
+}
+
+/*******************************************************************************
+* PDL Cryptolite SHA-256 API
+*******************************************************************************/
+cy_en_cryptolite_status_t Cy_Cryptolite_Sha256_Init(CRYPTOLITE_Type *base,
+                                    cy_stc_cryptolite_context_sha256_t *cfContext)
+{
+    if ((base == NULL) || (cfContext == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    memset(cfContext, 0, sizeof(*cfContext));
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+cy_en_cryptolite_status_t Cy_Cryptolite_Sha256_Start(CRYPTOLITE_Type *base,
+                                    cy_stc_cryptolite_context_sha256_t *cfContext)
+{
+    if ((base == NULL) || (cfContext == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    memcpy(cfContext->hash, sha256_iv, sizeof(sha256_iv));
+    cfContext->msgIdx = 0u;
+    cfContext->messageSize = 0u;
+    cfContext->started = true;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+cy_en_cryptolite_status_t Cy_Cryptolite_Sha256_Update(CRYPTOLITE_Type *base,
+                                    uint8_t const *message,
+                                    uint32_t messageSize,
+                                    cy_stc_cryptolite_context_sha256_t *cfContext)
+{
+    uint8_t *block;
+    uint32_t i;
+
+    if ((base == NULL) || (cfContext == NULL) ||
+        ((messageSize != 0u) && (message == NULL)))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!cfContext->started)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    block = (uint8_t *)cfContext->msgblock;
+    for (i = 0u; i < messageSize; i++)
+    {
+        block[cfContext->msgIdx++] = message[i];
+        if (cfContext->msgIdx == CY_CRYPTOLITE_SHA256_BLOCK_SIZE)
+        {
+            sha256_process_block(cfContext);
+            cfContext->msgIdx = 0u;
+        }
+    }
+    cfContext->messageSize += messageSize;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+cy_en_cryptolite_status_t Cy_Cryptolite_Sha256_Finish(CRYPTOLITE_Type *base,
+                                    uint8_t *digest,
+                                    cy_stc_cryptolite_context_sha256_t *cfContext)
+{
+    uint8_t *block;
+    uint64_t bit_length;
+    uint32_t i;
+
+    if ((base == NULL) || (digest == NULL) || (cfContext == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!cfContext->started)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    block = (uint8_t *)cfContext->msgblock;
+    bit_length = cfContext->messageSize * 8u;
+
+    block[cfContext->msgIdx++] = 0x80u;
+    if (cfContext->msgIdx > CY_CRYPTOLITE_SHA256_PAD_SIZE)
+    {
+        memset(&block[cfContext->msgIdx], 0,
+               CY_CRYPTOLITE_SHA256_BLOCK_SIZE - cfContext->msgIdx);
+        sha256_process_block(cfContext);
+        cfContext->msgIdx = 0u;
+    }
+    memset(&block[cfContext->msgIdx], 0,
+           CY_CRYPTOLITE_SHA256_PAD_SIZE - cfContext->msgIdx);
+    store_be32(&block[56], (uint32_t)(bit_length >> 32));
+    store_be32(&block[60], (uint32_t)bit_length);
+    sha256_process_block(cfContext);
+
+    for (i = 0u; i < 8u; i++)
+    {
+        store_be32(&digest[4u * i], cfContext->hash[i]);
+    }
+    cfContext->started = false;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+cy_en_cryptolite_status_t Cy_Cryptolite_Sha256_Free(CRYPTOLITE_Type *base,
+                                    cy_stc_cryptolite_context_sha256_t *cfContext)
+{
+    if ((base == NULL) || (cfContext == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    memset(cfContext, 0, sizeof(*cfContext));
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+cy_en_cryptolite_status_t Cy_Cryptolite_Sha256_Run(CRYPTOLITE_Type *base,
+                                    uint8_t const *message,
+                                    uint32_t messageSize,
+                                    uint8_t *digest,
+                                    cy_stc_cryptolite_context_sha256_t *cfContext)
+{
+    cy_en_cryptolite_status_t status;
+
+    status = Cy_Cryptolite_Sha256_Init(base, cfContext);
+    if (status == CY_CRYPTOLITE_SUCCESS)
+    {
+        status = Cy_Cryptolite_Sha256_Start(base, cfContext);
+    }
+    if (status == CY_CRYPTOLITE_SUCCESS)
+    {
+        status = Cy_Cryptolite_Sha256_Update(base, message, messageSize, cfContext);
+    }
+    if (status == CY_CRYPTOLITE_SUCCESS)
+    {
+        status = Cy_Cryptolite_Sha256_Finish(base, digest, cfContext);
+    }
+    (void)Cy_Cryptolite_Sha256_Free(base, cfContext);
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: trng_default_source
+********************************************************************************
+* Summary: xoshiro128** generator standing in for the ring-oscillator noise
+*          source. Statistically sound but not cryptographically secure.
+*
+*******************************************************************************/
+static uint32_t trng_default_source(void *arg)
+{
+    uint32_t *s = ((CRYPTOLITE_Type *)arg)->trng_state;
+    uint32_t result = s[1] * 5u;
+    uint32_t t = s[1] << 9;
+
+    result = ((result << 7) | (result >> 25)) * 9u;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: trng_wait
+********************************************************************************
+* Summary: Busy-waits trng_word_ns, so that code timing the TRNG on the host
+*          sees a rate closer to the ring oscillators than to xoshiro.
+*
+*******************************************************************************/
+static void trng_wait(void)
+{
+    struct timespec start;
+    struct timespec now;
+    uint64_t elapsed;
+
+    if (trng_word_ns == 0u)
+    {
+        return;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do
+    {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        elapsed = (uint64_t)(now.tv_sec - start.tv_sec) * 1000000000u +
+                  (uint64_t)now.tv_nsec - (uint64_t)start.tv_nsec;
+    } while (elapsed < trng_word_ns);
+}
+
+/*******************************************************************************
+* Function Name: trng_fault_setup
+********************************************************************************
+* Summary: Reads the fault injection settings from the environment.
+*
+*******************************************************************************/
+static void trng_fault_setup(void)
+{
+    char const *fault = getenv("CY_HOST_TRNG_FAULT");
+    char const *after = getenv("CY_HOST_TRNG_FAULT_AFTER");
+
+    trng_fault = TRNG_FAULT_NONE;
+    if (fault != NULL)
+    {
+        if (strcmp(fault, "zero") == 0)
+        {
+            trng_fault = TRNG_FAULT_ZERO;
+        }
+        else if (strcmp(fault, "stuck") == 0)
+        {
+            trng_fault = TRNG_FAULT_STUCK;
+        }
+        else if (strcmp(fault, "biased") == 0)
+        {
+            trng_fault = TRNG_FAULT_BIASED;
+        }
+    }
+    trng_fault_after = (after != NULL) ? strtoull(after, NULL, 0) : 0u;
+}
+
+/*******************************************************************************
+* Function Name: trng_fault_apply
+********************************************************************************
+* Summary: Turns a word of the noise source into the output of the selected
+*          faulty source.
+*
+*******************************************************************************/
+static uint32_t trng_fault_apply(uint32_t word)
+{
+    uint32_t mask = 0u;
+
+    if ((trng_fault == TRNG_FAULT_NONE) || (trng_words++ < trng_fault_after))
+    {
+        trng_last_word = word;
+        return word;
+    }
+
+    switch (trng_fault)
+    {
+        case TRNG_FAULT_ZERO:
+            word = 0u;
+            break;
+        case TRNG_FAULT_STUCK:
+            word = trng_last_word;
+            break;
+        default:
+            /* Clear each byte whose two low bits are zero */
+            for (uint32_t i = 0u; i < 32u; i += 8u)
+            {
+                if (((word >> i) & 3u) == 0u)
+                {
+                    mask |= 0xFFu << i;
+                }
+            }
+            word &= ~mask;
+            break;
+    }
+    return word;
+}
+
+/*******************************************************************************
+* PDL Cryptolite TRNG API
+*******************************************************************************/
+void Cy_Cryptolite_Model_SetTrngSource(uint32_t (*source)(void *arg), void *arg)
+{
+    trng_source = source;
+    trng_source_arg = arg;
+}
+
+cy_en_cryptolite_status_t Cy_Cryptolite_Trng_Init(CRYPTOLITE_Type *base,
+                                    cy_stc_cryptolite_trng_config_t *config)
+{
+    char const *seed_env;
+    uint64_t seed;
+    uint32_t i;
+
+    (void)config;
+    if (base == NULL)
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    /* Like the ring oscillators, the generator keeps running across
+     * Init/DeInit cycles; it is seeded only once per process. */
+    if (!trng_seeded)
+    {
+        seed_env = getenv("CY_HOST_TRNG_SEED");
+        seed = (seed_env != NULL) ? strtoull(seed_env, NULL, 0)
+                                  : ((uint64_t)time(NULL) << 20) ^ (uint64_t)getpid();
+        /* splitmix64 expansion of the seed into the generator state */
+        for (i = 0u; i < 4u; i++)
+        {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            base->trng_state[i] = (uint32_t)((z ^ (z >> 31)) >> 16);
+        }
+        seed_env = getenv("CY_HOST_TRNG_WORD_NS");
+        trng_word_ns = (seed_env != NULL) ? strtoull(seed_env, NULL, 0) : 0u;
+        trng_fault_setup();
+        trng_seeded = true;
+    }
+    base->trng_enabled = true;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+cy_en_cryptolite_status_t Cy_Cryptolite_Trng(CRYPTOLITE_Type *base,
+                                    uint32_t *randomData)
+{
+    if ((base == NULL) || (randomData == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!base->trng_enabled)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    trng_wait();
+    *randomData = trng_fault_apply((trng_source != NULL)
+                                   ? trng_source(trng_source_arg)
+                                   : trng_default_source(base));
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+void Cy_Cryptolite_Trng_DeInit(CRYPTOLITE_Type *base)
+{
+    if (base != NULL)
+    {
+        base->trng_enabled = false;
+    }
+}
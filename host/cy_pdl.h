@@ -0,0 +1,240 @@
+/******************************************************************************
+* File Name: cy_pdl.h
+*
+* Description: Host stand-in for the subset of the Peripheral Driver Library
+* (PDL) used by this code example. Declares the Cryptolite AES, SHA-256 and
+* TRNG API with the same names and signatures as the PDL so that main.c builds
+* unchanged on a Linux host. The functions are implemented by the software
+* model in cy_cryptolite_model.c.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOST_CY_PDL_H_
+#define HOST_CY_PDL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The host has no debugger to halt, so a failed assertion aborts the run. */
+#define CY_ASSERT(x)                  do { if (!(x)) { abort(); } } while (0)
+
+#define CY_CRYPTOLITE_AES_BLOCK_SIZE         (16u)
+#define CY_CRYPTOLITE_AES_128_KEY_SIZE       (16u)
+#define CY_CRYPTOLITE_AES_KEY_SIZE           CY_CRYPTOLITE_AES_128_KEY_SIZE
+
+#define CY_CRYPTOLITE_SHA256_BLOCK_SIZE      (64u)
+#define CY_CRYPTOLITE_SHA256_HASH_SIZE       (32u)
+#define CY_CRYPTOLITE_SHA256_PAD_SIZE        (56u)
+
+#define CY_RSLT_SUCCESS                      ((cy_rslt_t)0x00000000u)
+
+/* Interrupts are emulated: they are delivered only while the application
+ * waits in __WFI(), which is where the host reads new input. */
+#define __enable_irq()                       ((void)0)
+#define __WFI()                              Cy_Host_WaitForInterrupt()
+#define __DMB()                              __sync_synchronize()
+
+/* Base address of the Cryptolite block */
+#define CRYPTOLITE                           (&cy_cryptolite_model)
+
+/* Cortex-M debug and trace registers. Every access to DWT refreshes CYCCNT
+ * from the monotonic clock, counting at SystemCoreClock while enabled. */
+#define DWT                                  Cy_Host_Dwt()
+#define CoreDebug                            (&cy_host_core_debug)
+#define DWT_CTRL_CYCCNTENA_Msk               (0x00000001u)
+#define CoreDebug_DEMCR_TRCENA_Msk           (0x01000000u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef uint32_t uint32;
+typedef uint32_t cy_rslt_t;
+
+typedef struct
+{
+    uint32_t CTRL;
+    uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    uint32_t DEMCR;
+} CoreDebug_Type;
+
+/* Register file of the modelled Cryptolite block */
+typedef struct
+{
+    bool     trng_enabled;
+    uint32_t trng_state[4];
+} CRYPTOLITE_Type;
+
+typedef enum
+{
+    CY_CRYPTOLITE_SUCCESS         = 0x00u,
+    CY_CRYPTOLITE_BAD_PARAMS      = 0x01u,
+    CY_CRYPTOLITE_HW_BUSY         = 0x02u,
+    CY_CRYPTOLITE_BUS_ERROR       = 0x03u,
+    CY_CRYPTOLITE_NOT_INITIALIZED = 0x04u,
+    CY_CRYPTOLITE_ALIGNMENT_ERROR = 0x05u,
+    CY_CRYPTOLITE_SIZE_NOT_X16    = 0x06u,
+    CY_CRYPTOLITE_TRNG_UNHEALTHY  = 0x07u
+} cy_en_cryptolite_status_t;
+
+typedef enum
+{
+    CY_CRYPTOLITE_ENCRYPT = 0x00u,
+    CY_CRYPTOLITE_DECRYPT = 0x01u
+} cy_en_cryptolite_dir_mode_t;
+
+/* AES working buffers supplied by the caller */
+typedef struct
+{
+    uint8_t key[CY_CRYPTOLITE_AES_KEY_SIZE];
+    uint8_t block0[CY_CRYPTOLITE_AES_BLOCK_SIZE];
+    uint8_t block1[CY_CRYPTOLITE_AES_BLOCK_SIZE];
+    uint8_t block2[CY_CRYPTOLITE_AES_BLOCK_SIZE];
+} cy_stc_cryptolite_aes_buffers_t;
+
+/* AES state. The round keys stand in for the hardware key schedule. */
+typedef struct
+{
+    cy_stc_cryptolite_aes_buffers_t *buffers;
+    uint32_t round_keys[44];
+} cy_stc_cryptolite_aes_state_t;
+
+typedef struct
+{
+    uint32_t msgblock[CY_CRYPTOLITE_SHA256_BLOCK_SIZE / 4u];
+    uint32_t hash[CY_CRYPTOLITE_SHA256_HASH_SIZE / 4u];
+    uint32_t message_schedule[CY_CRYPTOLITE_SHA256_BLOCK_SIZE];
+    uint32_t msgIdx;
+    uint64_t messageSize;
+    bool     started;
+} cy_stc_cryptolite_context_sha256_t;
+
+typedef struct
+{
+    uint32_t ro_osc_mask;
+    uint32_t sample_clock_div;
+    uint32_t init_delay;
+} cy_stc_cryptolite_trng_config_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern CRYPTOLITE_Type cy_cryptolite_model;
+extern CoreDebug_Type cy_host_core_debug;
+
+/* CPU clock in Hz. The host reports 1 GHz, so one cycle is one nanosecond. */
+extern uint32_t SystemCoreClock;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_cryptolite_status_t Cy_Cryptolite_Aes_Init(CRYPTOLITE_Type *base,
+                                    uint8_t const *key,
+                                    cy_stc_cryptolite_aes_state_t *aesState,
+                                    cy_stc_cryptolite_aes_buffers_t *aesBuffers);
+cy_en_cryptolite_status_t Cy_Cryptolite_Aes_Free(CRYPTOLITE_Type *base,
+                                    cy_stc_cryptolite_aes_state_t *aesState);
+cy_en_cryptolite_status_t Cy_Cryptolite_Aes_Ecb(CRYPTOLITE_Type *base,
+                                    uint8_t *dst,
+                                    uint8_t const *src,
+                                    cy_stc_cryptolite_aes_state_t *aesState);
+cy_en_cryptolite_status_t Cy_Cryptolite_Aes_Cfb(CRYPTOLITE_Type *base,
+                                    cy_en_cryptolite_dir_mode_t dirMode,
+                                    uint32_t srcSize,
+                                    uint8_t *ivPtr,
+                                    uint8_t *dst,
+                                    uint8_t const *src,
+                                    cy_stc_cryptolite_aes_state_t *aesState);
+cy_en_cryptolite_status_t Cy_Cryptolite_Aes_Ctr(CRYPTOLITE_Type *base,
+                                    uint32_t srcSize,
+                                    uint32_t *srcOffset,
+                                    uint8_t ivPtr[CY_CRYPTOLITE_AES_BLOCK_SIZE],
+                                    uint8_t *dst,
+                                    uint8_t const *src,
+                                    cy_stc_cryptolite_aes_state_t *aesState);
+
+cy_en_cryptolite_status_t Cy_Cryptolite_Sha256_Init(CRYPTOLITE_Type *base,
+                                    cy_stc_cryptolite_context_sha256_t *cfContext);
+cy_en_cryptolite_status_t Cy_Cryptolite_Sha256_Start(CRYPTOLITE_Type *base,
+                                    cy_stc_cryptolite_context_sha256_t *cfContext);
+cy_en_cryptolite_status_t Cy_Cryptolite_Sha256_Update(CRYPTOLITE_Type *base,
+                                    uint8_t const *message,
+                                    uint32_t messageSize,
+                                    cy_stc_cryptolite_context_sha256_t *cfContext);
+cy_en_cryptolite_status_t Cy_Cryptolite_Sha256_Finish(CRYPTOLITE_Type *base,
+                                    uint8_t *digest,
+                                    cy_stc_cryptolite_context_sha256_t *cfContext);
+cy_en_cryptolite_status_t Cy_Cryptolite_Sha256_Free(CRYPTOLITE_Type *base,
+                                    cy_stc_cryptolite_context_sha256_t *cfContext);
+cy_en_cryptolite_status_t Cy_Cryptolite_Sha256_Run(CRYPTOLITE_Type *base,
+                                    uint8_t const *message,
+                                    uint32_t messageSize,
+                                    uint8_t *digest,
+                                    cy_stc_cryptolite_context_sha256_t *cfContext);
+
+cy_en_cryptolite_status_t Cy_Cryptolite_Trng_Init(CRYPTOLITE_Type *base,
+                                    cy_stc_cryptolite_trng_config_t *config);
+cy_en_cryptolite_status_t Cy_Cryptolite_Trng(CRYPTOLITE_Type *base,
+                                    uint32_t *randomData);
+void Cy_Cryptolite_Trng_DeInit(CRYPTOLITE_Type *base);
+
+/* Host-only: services pending emulated interrupts, blocking on stdin when
+ * there are none. Implemented in cyhal_uart_host.c. */
+void Cy_Host_WaitForInterrupt(void);
+
+/* Host-only: updates and returns the emulated DWT. Implemented in
+ * cy_core_host.c. */
+DWT_Type *Cy_Host_Dwt(void);
+
+/* Model-only hook: replaces the TRNG noise source. Passing NULL restores the
+ * built-in generator, which is seeded from the CY_HOST_TRNG_SEED environment
+ * variable when set so that runs can be reproduced. The environment can also
+ * slow the TRNG down to CY_HOST_TRNG_WORD_NS per word, and make it fail as
+ * CY_HOST_TRNG_FAULT=zero, stuck or biased after CY_HOST_TRNG_FAULT_AFTER
+ * good words.
+ */
+void Cy_Cryptolite_Model_SetTrngSource(uint32_t (*source)(void *arg), void *arg);
+
+#endif /* HOST_CY_PDL_H_ */
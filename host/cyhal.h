@@ -0,0 +1,108 @@
+/******************************************************************************
+* File Name: cyhal.h
+*
+* Description: Host stand-in for the subset of the Hardware Abstraction Layer
+* (HAL) used by this code example. The debug UART is mapped onto the process's
+* stdin and stdout.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOST_CYHAL_H_
+#define HOST_CYHAL_H_
+
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CYHAL_UART_RSLT_ERR_TIMEOUT          ((cy_rslt_t)0x04020001u)
+#define CYHAL_UART_RSLT_ERR_TX_BUSY          ((cy_rslt_t)0x04020002u)
+
+#define CYHAL_ISR_PRIORITY_DEFAULT           (7u)
+
+/* Depth of the emulated UART RX hardware FIFO. stdin is read into it only
+ * while the application idles in __WFI() and the FIFO is empty, much like
+ * characters trickling in at the line rate. */
+#define CYHAL_HOST_UART_FIFO_DEPTH           (128u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef uint32_t cyhal_gpio_t;
+
+typedef enum
+{
+    CYHAL_UART_IRQ_NONE                = 0u,
+    CYHAL_UART_IRQ_TX_TRANSMIT_IN_FIFO = 1u << 1,
+    CYHAL_UART_IRQ_TX_DONE             = 1u << 2,
+    CYHAL_UART_IRQ_TX_ERROR            = 1u << 3,
+    CYHAL_UART_IRQ_RX_DONE             = 1u << 4,
+    CYHAL_UART_IRQ_RX_ERROR            = 1u << 5,
+    CYHAL_UART_IRQ_RX_NOT_EMPTY        = 1u << 6,
+    CYHAL_UART_IRQ_TX_EMPTY            = 1u << 7,
+    CYHAL_UART_IRQ_TX_FIFO             = 1u << 8,
+    CYHAL_UART_IRQ_RX_FIFO             = 1u << 9
+} cyhal_uart_event_t;
+
+typedef void (*cyhal_uart_event_callback_t)(void *callback_arg,
+                                            cyhal_uart_event_t event);
+
+typedef struct
+{
+    uint32_t                    baudrate;
+    cyhal_uart_event_callback_t callback;
+    void                       *callback_arg;
+    uint32_t                    enabled_events;
+} cyhal_uart_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t cyhal_uart_getc(cyhal_uart_t *obj, uint8_t *value, uint32_t timeout);
+cy_rslt_t cyhal_uart_putc(cyhal_uart_t *obj, uint32_t value);
+uint32_t cyhal_uart_readable(cyhal_uart_t *obj);
+cy_rslt_t cyhal_uart_write_async(cyhal_uart_t *obj, void *tx, size_t length);
+bool cyhal_uart_is_tx_active(cyhal_uart_t *obj);
+void cyhal_uart_register_callback(cyhal_uart_t *obj,
+                                  cyhal_uart_event_callback_t callback,
+                                  void *callback_arg);
+void cyhal_uart_enable_event(cyhal_uart_t *obj, cyhal_uart_event_t event,
+                             uint8_t intr_priority, bool enable);
+
+uint32_t cyhal_system_critical_section_enter(void);
+void cyhal_system_critical_section_exit(uint32_t old_state);
+
+#endif /* HOST_CYHAL_H_ */
@@ -0,0 +1,327 @@
+/******************************************************************************
+* File Name: cyhal_uart_host.c
+*
+* Description: Host implementation of the debug UART, the board support package
+* and retarget-io. UART receive reads from stdin and transmit writes to stdout,
+* so the code example can be driven interactively from a terminal or by piping
+* a script of menu commands into it. The process exits when stdin reaches end
+* of file.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cyhal.h"
+#include "cybsp.h"
+#include "cy_retarget_io.h"
+#include <errno.h>
+#include <unistd.h>
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+cyhal_uart_t cy_retarget_io_uart_obj;
+
+/* Emulated RX hardware FIFO */
+static uint8_t rx_fifo[CYHAL_HOST_UART_FIFO_DEPTH];
+static uint32_t rx_fifo_count;
+static uint32_t rx_fifo_pos;
+
+/* Set while an asynchronous write is waiting for its TX-done interrupt */
+static bool tx_active;
+
+/* Emulated PRIMASK */
+static uint32_t irq_masked;
+
+/*******************************************************************************
+* Function Name: rx_fifo_fill
+********************************************************************************
+* Summary: Blocks until input is available on stdin and moves up to one FIFO
+*          depth of it into the emulated RX FIFO. Exits the application at
+*          end of file.
+*
+*******************************************************************************/
+static void rx_fifo_fill(void)
+{
+    ssize_t count;
+
+    /* Pending output is flushed before every blocking read so that prompts
+     * and frame responses reach a terminal or a piped client promptly. */
+    fflush(stdout);
+
+    do
+    {
+        count = read(STDIN_FILENO, rx_fifo, sizeof(rx_fifo));
+    } while ((count < 0) && (errno == EINTR));
+
+    if (count <= 0)
+    {
+        fflush(stdout);
+        exit(EXIT_SUCCESS);
+    }
+    rx_fifo_count = (uint32_t)count;
+    rx_fifo_pos = 0u;
+}
+
+/*******************************************************************************
+* Function Name: cybsp_init
+********************************************************************************
+* Summary: Nothing to initialize on the host.
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t cybsp_init(void)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: cy_retarget_io_init_fc
+********************************************************************************
+* Summary: Prepares stdin/stdout to act as the debug UART.
+*
+* Parameters:
+*  tx, rx, cts, rts - Ignored on the host
+*  baudrate         - Stored in the UART object for reference
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t cy_retarget_io_init_fc(cyhal_gpio_t tx, cyhal_gpio_t rx,
+                                 cyhal_gpio_t cts, cyhal_gpio_t rts,
+                                 uint32_t baudrate)
+{
+    (void)tx;
+    (void)rx;
+    (void)cts;
+    (void)rts;
+
+    cy_retarget_io_uart_obj.baudrate = baudrate;
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: cyhal_uart_getc
+********************************************************************************
+* Summary: Reads one character from the emulated RX FIFO, refilling it from
+*          stdin when empty. stdin is blocking, so the timeout is never
+*          reached; end of file terminates the application instead.
+*
+* Parameters:
+*  obj     - UART object
+*  value   - Location to store the received character
+*  timeout - Ignored on the host
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t cyhal_uart_getc(cyhal_uart_t *obj, uint8_t *value, uint32_t timeout)
+{
+    (void)obj;
+    (void)timeout;
+
+    if (rx_fifo_pos == rx_fifo_count)
+    {
+        rx_fifo_fill();
+    }
+    *value = rx_fifo[rx_fifo_pos++];
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: cyhal_uart_readable
+********************************************************************************
+* Summary: Returns the number of characters waiting in the emulated RX FIFO.
+*
+*******************************************************************************/
+uint32_t cyhal_uart_readable(cyhal_uart_t *obj)
+{
+    (void)obj;
+
+    return rx_fifo_count - rx_fifo_pos;
+}
+
+/*******************************************************************************
+* Function Name: cyhal_uart_write_async
+********************************************************************************
+* Summary: Writes the data to stdout at once. The TX-done interrupt is raised
+*          at the next __WFI(), so the caller sees the transfer in flight
+*          until it idles, as it would on the device.
+*
+* Parameters:
+*  obj    - UART object
+*  tx     - Data to transmit
+*  length - Number of bytes
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS, or CYHAL_UART_RSLT_ERR_TX_BUSY while a
+*              previous transfer is in flight
+*
+*******************************************************************************/
+cy_rslt_t cyhal_uart_write_async(cyhal_uart_t *obj, void *tx, size_t length)
+{
+    (void)obj;
+
+    if (tx_active)
+    {
+        return CYHAL_UART_RSLT_ERR_TX_BUSY;
+    }
+    fwrite(tx, 1u, length, stdout);
+    tx_active = true;
+    return CY_RSLT_SUCCESS;
+}
+
+bool cyhal_uart_is_tx_active(cyhal_uart_t *obj)
+{
+    (void)obj;
+
+    return tx_active;
+}
+
+/*******************************************************************************
+* Function Name: cyhal_uart_register_callback / cyhal_uart_enable_event
+********************************************************************************
+* Summary: Records the event handler and the events it is enabled for.
+*
+*******************************************************************************/
+void cyhal_uart_register_callback(cyhal_uart_t *obj,
+                                  cyhal_uart_event_callback_t callback,
+                                  void *callback_arg)
+{
+    obj->callback = callback;
+    obj->callback_arg = callback_arg;
+}
+
+void cyhal_uart_enable_event(cyhal_uart_t *obj, cyhal_uart_event_t event,
+                             uint8_t intr_priority, bool enable)
+{
+    (void)intr_priority;
+
+    if (enable)
+    {
+        obj->enabled_events |= (uint32_t)event;
+    }
+    else
+    {
+        obj->enabled_events &= ~(uint32_t)event;
+    }
+}
+
+/*******************************************************************************
+* Function Name: cyhal_system_critical_section_enter / _exit
+********************************************************************************
+* Summary: Masks emulated interrupts. Interrupts are only delivered from
+*          Cy_Host_WaitForInterrupt(), so masking only needs to be recorded.
+*
+*******************************************************************************/
+uint32_t cyhal_system_critical_section_enter(void)
+{
+    uint32_t old_state = irq_masked;
+
+    irq_masked = 1u;
+    return old_state;
+}
+
+void cyhal_system_critical_section_exit(uint32_t old_state)
+{
+    irq_masked = old_state;
+}
+
+/*******************************************************************************
+* Function Name: Cy_Host_WaitForInterrupt
+********************************************************************************
+* Summary: Host implementation of __WFI(). Completes a pending asynchronous
+*          write by raising the TX-done interrupt. Otherwise waits for input
+*          on stdin when the emulated RX FIFO is empty and then raises the
+*          UART RX interrupt. Pending output therefore always reaches stdout
+*          before the host blocks on, or exits at the end of, its input.
+*          As on the device, a pending interrupt wakes the CPU even while
+*          masked; the handler runs here because the host has no later
+*          point at which the mask is lifted.
+*
+*******************************************************************************/
+void Cy_Host_WaitForInterrupt(void)
+{
+    cyhal_uart_t *uart = &cy_retarget_io_uart_obj;
+
+    if (tx_active)
+    {
+        tx_active = false;
+        if ((uart->callback != NULL) &&
+            ((uart->enabled_events & (uint32_t)CYHAL_UART_IRQ_TX_DONE) != 0u))
+        {
+            uart->callback(uart->callback_arg, CYHAL_UART_IRQ_TX_DONE);
+        }
+        return;
+    }
+
+    if (rx_fifo_pos == rx_fifo_count)
+    {
+        rx_fifo_fill();
+    }
+
+    if ((uart->callback != NULL) &&
+        ((uart->enabled_events & (uint32_t)CYHAL_UART_IRQ_RX_NOT_EMPTY) != 0u))
+    {
+        uart->callback(uart->callback_arg, CYHAL_UART_IRQ_RX_NOT_EMPTY);
+    }
+}
+
+/*******************************************************************************
+* Function Name: cyhal_uart_putc
+********************************************************************************
+* Summary: Writes one character to stdout.
+*
+* Parameters:
+*  obj   - UART object
+*  value - Character to transmit
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t cyhal_uart_putc(cyhal_uart_t *obj, uint32_t value)
+{
+    (void)obj;
+
+    putchar((int)(value & 0xFFu));
+    return CY_RSLT_SUCCESS;
+}
@@ -0,0 +1,250 @@
+/******************************************************************************
+* File Name: drbg_check.c
+*
+* Description: Host check of the CTR_DRBG, built once with and once without the
+* derivation function. It runs the known-answer self test on the NIST CAVP
+* vectors, then instantiate, reseed and generate with personalization and
+* additional input at the configured entropy and nonce sizes, against output
+* cross-checked with the OpenSSL CTR-DRBG, and verifies how many bytes each
+* (re)seed draws from the entropy source. Built and run by 'make check'.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "ctr_drbg.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DRBG_CHECK_OUTPUT_SIZE               (64u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef struct
+{
+    char const    *name;
+    size_t         personalization_len;
+    size_t         reseed_additional_len;
+    size_t         additional1_len;
+    size_t         additional2_len;
+    uint8_t const *output;
+} drbg_check_case_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Expected second output of instantiate, reseed, generate, generate, from the
+ * OpenSSL CTR-DRBG (AES-128-CTR) fed the same inputs. Every input is the
+ * pattern of fill_pattern() with its own start value. */
+#if (CTR_DRBG_DERIVATION_FUNCTION != 0u)
+static const uint8_t full_output[DRBG_CHECK_OUTPUT_SIZE] =
+{
+    0xE9u, 0x24u, 0x42u, 0x0Fu, 0x22u, 0x2Du, 0xD2u, 0xC5u,
+    0xFBu, 0x37u, 0x3Du, 0x87u, 0x08u, 0x5Fu, 0x28u, 0xF2u,
+    0xF5u, 0x19u, 0x11u, 0xE6u, 0x33u, 0x31u, 0x46u, 0x3Bu,
+    0x74u, 0x84u, 0xF3u, 0x93u, 0x79u, 0x00u, 0x52u, 0x46u,
+    0x0Cu, 0x44u, 0x5Fu, 0xBCu, 0x26u, 0x2Eu, 0xEAu, 0x4Fu,
+    0x5Au, 0x45u, 0x9Cu, 0xE0u, 0x5Bu, 0xAEu, 0x05u, 0xEBu,
+    0xF6u, 0x2Du, 0x68u, 0x69u, 0x39u, 0x95u, 0x22u, 0x6Cu,
+    0xD9u, 0xEBu, 0x95u, 0xDCu, 0xE9u, 0xE7u, 0xDEu, 0x2Bu,
+};
+
+static const uint8_t short_output[DRBG_CHECK_OUTPUT_SIZE] =
+{
+    0xE0u, 0xD9u, 0x60u, 0x88u, 0x86u, 0x19u, 0xF2u, 0x8Fu,
+    0x84u, 0xA5u, 0xE6u, 0x7Fu, 0xF7u, 0x59u, 0x9Du, 0x23u,
+    0x11u, 0x1Eu, 0x0Bu, 0x6Du, 0x03u, 0x67u, 0xEEu, 0xF4u,
+    0x2Au, 0x94u, 0xACu, 0x8Au, 0xC7u, 0x04u, 0x1Bu, 0x1Eu,
+    0x8Du, 0x56u, 0xD8u, 0x96u, 0xF1u, 0x2Fu, 0xFBu, 0x47u,
+    0x35u, 0x48u, 0xB7u, 0x8Cu, 0xF6u, 0x65u, 0xA3u, 0x92u,
+    0x43u, 0x0Fu, 0x36u, 0x4Du, 0x1Cu, 0x77u, 0xBAu, 0x26u,
+    0xDBu, 0x2Cu, 0xA9u, 0xA2u, 0x96u, 0x32u, 0x40u, 0x73u,
+};
+#else
+static const uint8_t full_output[DRBG_CHECK_OUTPUT_SIZE] =
+{
+    0x9Au, 0x1Bu, 0x5Fu, 0x18u, 0x50u, 0x7Fu, 0x3Cu, 0x95u,
+    0xD6u, 0x57u, 0xE1u, 0xE0u, 0x0Eu, 0x4Au, 0xDFu, 0x2Eu,
+    0x6Eu, 0x2Cu, 0xFCu, 0xDFu, 0xA4u, 0x7Bu, 0x6Du, 0xC2u,
+    0x36u, 0xE8u, 0x46u, 0x67u, 0x5Bu, 0x2Cu, 0x74u, 0x22u,
+    0x03u, 0x65u, 0x97u, 0xB4u, 0x42u, 0xA7u, 0x40u, 0x4Fu,
+    0x65u, 0x42u, 0x2Cu, 0x1Bu, 0x4Eu, 0xCDu, 0x3Cu, 0x09u,
+    0xD1u, 0xB7u, 0xA1u, 0x54u, 0x46u, 0x12u, 0x1Fu, 0x07u,
+    0xEFu, 0xF8u, 0xE7u, 0x0Cu, 0xD7u, 0x14u, 0xEEu, 0x23u,
+};
+
+static const uint8_t short_output[DRBG_CHECK_OUTPUT_SIZE] =
+{
+    0x5Cu, 0x4Fu, 0x1Cu, 0x3Eu, 0xC4u, 0x81u, 0x34u, 0x9Bu,
+    0xBBu, 0xCAu, 0x57u, 0x6Bu, 0x09u, 0x88u, 0x24u, 0x25u,
+    0x37u, 0xE1u, 0x60u, 0xE8u, 0xA0u, 0x34u, 0xB9u, 0x38u,
+    0xE7u, 0x5Fu, 0x8Bu, 0x34u, 0xECu, 0x16u, 0x2Eu, 0x7Fu,
+    0x1Au, 0xBAu, 0x5Fu, 0x2Eu, 0x04u, 0x14u, 0xA7u, 0x12u,
+    0xCCu, 0xB9u, 0x9Cu, 0xDCu, 0x0Du, 0xF5u, 0x37u, 0xFEu,
+    0x0Du, 0x37u, 0x78u, 0x5Eu, 0x78u, 0x94u, 0x0Du, 0x88u,
+    0xD6u, 0xE8u, 0xCDu, 0x39u, 0x80u, 0x3Du, 0x1Au, 0x5Fu,
+};
+#endif
+
+static const drbg_check_case_t drbg_check_cases[] =
+{
+    { "full inputs",  CTR_DRBG_SEED_SIZE, CTR_DRBG_SEED_SIZE,
+      CTR_DRBG_SEED_SIZE, CTR_DRBG_SEED_SIZE, full_output },
+    { "short inputs", 7u, 5u, 1u, 17u, short_output },
+};
+
+/* Calls made to check_entropy() and whether each asked for the right size */
+static uint32_t entropy_calls;
+static bool entropy_sizes_ok;
+
+/*******************************************************************************
+* Function Name: fill_pattern
+********************************************************************************
+* Summary: Fills buf with start, start + 7, start + 14, ... modulo 256.
+*
+*******************************************************************************/
+static void fill_pattern(uint8_t *buf, size_t len, uint8_t start)
+{
+    for (size_t i = 0u; i < len; i++)
+    {
+        buf[i] = (uint8_t)(start + (7u * i));
+    }
+}
+
+/*******************************************************************************
+* Function Name: check_entropy
+********************************************************************************
+* Summary: Entropy source of the checks. The first call must ask for entropy
+*          input and nonce and gets patterns 1 and 2, the second one for a
+*          reseed's entropy input and gets pattern 4.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t check_entropy(uint8_t *buf, size_t len)
+{
+    if (entropy_calls == 0u)
+    {
+        entropy_sizes_ok &= (len == (CTR_DRBG_ENTROPY_SIZE + CTR_DRBG_NONCE_SIZE));
+        fill_pattern(buf, CTR_DRBG_ENTROPY_SIZE, 1u);
+        fill_pattern(&buf[CTR_DRBG_ENTROPY_SIZE], CTR_DRBG_NONCE_SIZE, 2u);
+    }
+    else
+    {
+        entropy_sizes_ok &= (len == CTR_DRBG_ENTROPY_SIZE);
+        fill_pattern(buf, len, 4u);
+    }
+    entropy_calls++;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: run_case
+********************************************************************************
+* Summary: Runs one case and reports whether it matched.
+*
+*******************************************************************************/
+static bool run_case(drbg_check_case_t const *c)
+{
+    ctr_drbg_t drbg;
+    uint8_t personalization[CTR_DRBG_SEED_SIZE];
+    uint8_t reseed_additional[CTR_DRBG_SEED_SIZE];
+    uint8_t additional1[CTR_DRBG_SEED_SIZE];
+    uint8_t additional2[CTR_DRBG_SEED_SIZE];
+    uint8_t out[DRBG_CHECK_OUTPUT_SIZE];
+    cy_en_cryptolite_status_t res;
+    bool pass;
+
+    fill_pattern(personalization, c->personalization_len, 3u);
+    fill_pattern(reseed_additional, c->reseed_additional_len, 5u);
+    fill_pattern(additional1, c->additional1_len, 6u);
+    fill_pattern(additional2, c->additional2_len, 7u);
+    entropy_calls = 0u;
+    entropy_sizes_ok = true;
+
+    res = ctr_drbg_instantiate(&drbg, check_entropy, personalization,
+                               c->personalization_len, 0u, false);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = ctr_drbg_reseed(&drbg, reseed_additional,
+                              c->reseed_additional_len);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = ctr_drbg_generate(&drbg, out, sizeof(out), additional1,
+                                c->additional1_len);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = ctr_drbg_generate(&drbg, out, sizeof(out), additional2,
+                                c->additional2_len);
+    }
+    ctr_drbg_uninstantiate(&drbg);
+
+    pass = (res == CY_CRYPTOLITE_SUCCESS) && (entropy_calls == 2u) &&
+           entropy_sizes_ok && (memcmp(out, c->output, sizeof(out)) == 0);
+    printf("%-14s %s\n", c->name, pass ? "ok" : "FAILED");
+    return pass;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Runs the self test and the cases; exits non-zero on any mismatch.
+*
+*******************************************************************************/
+int main(void)
+{
+    bool pass;
+
+    printf("CTR_DRBG %s derivation function, entropy %u + nonce %u bytes\n",
+           (CTR_DRBG_DERIVATION_FUNCTION != 0u) ? "with" : "without",
+           (unsigned)CTR_DRBG_ENTROPY_SIZE, (unsigned)CTR_DRBG_NONCE_SIZE);
+
+    pass = ctr_drbg_self_test();
+    printf("%-14s %s\n", "CAVP self test", pass ? "ok" : "FAILED");
+
+    for (size_t i = 0u; i < (sizeof(drbg_check_cases) / sizeof(drbg_check_cases[0])); i++)
+    {
+        pass &= run_case(&drbg_check_cases[i]);
+    }
+    return pass ? 0 : 1;
+}
+
+/* [] END OF FILE */
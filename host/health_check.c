@@ -0,0 +1,354 @@
+/******************************************************************************
+* File Name: health_check.c
+*
+* Description: Host check of the TRNG health tests under injected faults. The
+* entropy pool runs on sources that read all zeros, repeat one word or clear a
+* quarter of their bytes, from the start or after a run of good words. It
+* checks that the repetition count or adaptive proportion test latches within
+* the number of words the cutoffs allow, that the pool and random_fill() then
+* refuse to produce output, and that a healthy source does not trip either
+* test. Built and run by 'make check'.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "random_fill.h"
+#include "entropy_pool.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Good words before a late fault starts */
+#define HEALTH_CHECK_GOOD_WORDS              (1000u)
+
+/* Words drawn from the healthy source */
+#define HEALTH_CHECK_HEALTHY_WORDS           (1u << 20)
+
+/* A biased source trips the APT in a window that starts on a zero byte,
+ * which a quarter of them do, so this many windows all miss with a
+ * probability below 2^-26. The fixed seed makes the run repeatable. */
+#define HEALTH_CHECK_BIASED_WINDOWS          (64u)
+
+#define HEALTH_CHECK_SAMPLES_PER_WORD        (4u)
+#define HEALTH_CHECK_APT_WINDOW_WORDS        (TRNG_HEALTH_APT_WINDOW / \
+                                              HEALTH_CHECK_SAMPLES_PER_WORD)
+
+/* Distinct bytes, so a stuck word never trips the repetition count test */
+#define HEALTH_CHECK_STUCK_WORD              (0x7A3C1E5Bu)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef enum
+{
+    FAULT_NONE,
+    /* Every byte reads 0 */
+    FAULT_ZERO,
+    /* The last good word repeats */
+    FAULT_STUCK,
+    /* A quarter of the bytes read 0 */
+    FAULT_BIASED,
+} fault_t;
+
+typedef struct
+{
+    char const          *name;
+    fault_t              fault;
+    /* Good words before the fault */
+    uint32_t             good_words;
+    /* The test expected to latch, and the range of the word that trips it,
+     * counted from 1 */
+    trng_health_status_t expected;
+    uint32_t             first_word;
+    uint32_t             last_word;
+} health_check_case_t;
+
+typedef struct
+{
+    fault_t  fault;
+    uint32_t good_words;
+    uint32_t words;
+    uint32_t last;
+    uint32_t state[4];
+} fault_source_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const health_check_case_t health_check_cases[] =
+{
+    /* RCT: TRNG_HEALTH_RCT_CUTOFF identical samples, 4 to a word */
+    { "zero",          FAULT_ZERO,   0u, TRNG_HEALTH_RCT_FAILURE,
+      (TRNG_HEALTH_RCT_CUTOFF + 3u) / 4u, (TRNG_HEALTH_RCT_CUTOFF + 3u) / 4u },
+    { "zero late",     FAULT_ZERO,   HEALTH_CHECK_GOOD_WORDS, TRNG_HEALTH_RCT_FAILURE,
+      HEALTH_CHECK_GOOD_WORDS + 1u,
+      HEALTH_CHECK_GOOD_WORDS + ((TRNG_HEALTH_RCT_CUTOFF + 3u) / 4u) },
+    /* APT: the window starts on the first byte of the stuck word, which then
+     * recurs every fourth sample */
+    { "stuck",         FAULT_STUCK,  0u, TRNG_HEALTH_APT_FAILURE,
+      TRNG_HEALTH_APT_CUTOFF, TRNG_HEALTH_APT_CUTOFF },
+    /* At worst the rest of the current window passes first */
+    { "stuck late",    FAULT_STUCK,  HEALTH_CHECK_GOOD_WORDS, TRNG_HEALTH_APT_FAILURE,
+      HEALTH_CHECK_GOOD_WORDS + 1u,
+      HEALTH_CHECK_GOOD_WORDS + HEALTH_CHECK_APT_WINDOW_WORDS + TRNG_HEALTH_APT_CUTOFF },
+    /* Either test may catch a biased source first */
+    { "biased",        FAULT_BIASED, 0u, TRNG_HEALTH_OK,
+      1u, HEALTH_CHECK_BIASED_WINDOWS * HEALTH_CHECK_APT_WINDOW_WORDS },
+    { "biased late",   FAULT_BIASED, HEALTH_CHECK_GOOD_WORDS, TRNG_HEALTH_OK,
+      HEALTH_CHECK_GOOD_WORDS + 1u,
+      HEALTH_CHECK_GOOD_WORDS + (HEALTH_CHECK_BIASED_WINDOWS * HEALTH_CHECK_APT_WINDOW_WORDS) },
+};
+
+static cy_stc_cryptolite_trng_config_t trng_config;
+static fault_source_t source;
+
+/*******************************************************************************
+* Function Name: good_word
+********************************************************************************
+* Summary: xorshift128 generator for the good words.
+*
+*******************************************************************************/
+static uint32_t good_word(uint32_t *s)
+{
+    uint32_t t = s[3];
+
+    s[3] = s[2];
+    s[2] = s[1];
+    s[1] = s[0];
+    t ^= t << 11;
+    t ^= t >> 8;
+    s[0] = t ^ s[0] ^ (s[0] >> 19);
+    return s[0];
+}
+
+/*******************************************************************************
+* Function Name: fault_source_word
+********************************************************************************
+* Summary: TRNG source for the model. Produces good words, then the output of
+*          the selected fault, which mirrors CY_HOST_TRNG_FAULT.
+*
+*******************************************************************************/
+static uint32_t fault_source_word(void *arg)
+{
+    fault_source_t *src = (fault_source_t *)arg;
+    uint32_t word = good_word(src->state);
+    uint32_t mask = 0u;
+
+    if ((src->fault == FAULT_NONE) || (src->words++ < src->good_words))
+    {
+        src->last = word;
+        return word;
+    }
+
+    switch (src->fault)
+    {
+        case FAULT_ZERO:
+            word = 0u;
+            break;
+        case FAULT_STUCK:
+            word = src->last;
+            break;
+        default:
+            /* Clear each byte whose two low bits are zero */
+            for (uint32_t i = 0u; i < 32u; i += 8u)
+            {
+                if (((word >> i) & 3u) == 0u)
+                {
+                    mask |= 0xFFu << i;
+                }
+            }
+            word &= ~mask;
+            break;
+    }
+    return word;
+}
+
+/*******************************************************************************
+* Function Name: source_start
+********************************************************************************
+* Summary: Restarts the pool, clearing the latched health state, on a fresh
+*          source.
+*
+*******************************************************************************/
+static void source_start(fault_t fault, uint32_t good_words)
+{
+    static const uint32_t seed[4] =
+    {
+        0x9E3779B9u, 0x243F6A88u, 0xB7E15162u, 0x0D2F8B5Eu
+    };
+
+    memset(&source, 0, sizeof(source));
+    source.fault = fault;
+    source.good_words = good_words;
+    source.last = HEALTH_CHECK_STUCK_WORD;
+    memcpy(source.state, seed, sizeof(seed));
+    Cy_Cryptolite_Model_SetTrngSource(fault_source_word, &source);
+
+    entropy_pool_deinit();
+    (void)entropy_pool_init(&trng_config);
+}
+
+/*******************************************************************************
+* Function Name: outputs_refused
+********************************************************************************
+* Summary: Returns true if, after a failure, every way of getting random
+*          bytes fails and random_fill() leaves its buffer wiped.
+*
+*******************************************************************************/
+static bool outputs_refused(void)
+{
+    uint8_t buf[19];
+    uint8_t zero[sizeof(buf)] = { 0u };
+    uint32_t word = 1u;
+    bool refused;
+
+    refused = (entropy_pool_word(&word) == CY_CRYPTOLITE_TRNG_UNHEALTHY) &&
+              (word == 0u);
+    refused = refused &&
+              (entropy_pool_refill(1u) == CY_CRYPTOLITE_TRNG_UNHEALTHY) &&
+              (entropy_pool_get_random(buf, sizeof(buf)) == 0u);
+    memset(buf, 0xA5, sizeof(buf));
+    refused = refused &&
+              (entropy_pool_read(buf, sizeof(buf)) == CY_CRYPTOLITE_TRNG_UNHEALTHY);
+    memset(buf, 0xA5, sizeof(buf));
+    refused = refused &&
+              (random_fill(buf, sizeof(buf)) == CY_CRYPTOLITE_TRNG_UNHEALTHY) &&
+              (memcmp(buf, zero, sizeof(buf)) == 0);
+    return refused;
+}
+
+/*******************************************************************************
+* Function Name: run_case
+********************************************************************************
+* Summary: Draws words until a health test latches and checks which test and
+*          when, and that the pool then stays shut.
+*
+*******************************************************************************/
+static bool run_case(health_check_case_t const *c)
+{
+    entropy_pool_stats_t stats;
+    uint32_t word;
+    uint32_t words = 0u;
+    bool pass;
+
+    source_start(c->fault, c->good_words);
+    while ((words < c->last_word) &&
+           (entropy_pool_word(&word) == CY_CRYPTOLITE_SUCCESS))
+    {
+        words++;
+    }
+    /* The failing word is not handed out; count it */
+    words++;
+
+    entropy_pool_get_stats(&stats);
+    pass = (stats.health != TRNG_HEALTH_OK) &&
+           ((c->expected == TRNG_HEALTH_OK) || (stats.health == c->expected)) &&
+           (words >= c->first_word) && (words <= c->last_word) &&
+           (entropy_pool_health() == stats.health) && outputs_refused();
+
+    printf("%-12s %-4s after word %6u (allowed %u..%u) %s\n", c->name,
+           (stats.health == TRNG_HEALTH_RCT_FAILURE) ? "RCT" :
+           (stats.health == TRNG_HEALTH_APT_FAILURE) ? "APT" : "none",
+           (unsigned)words, (unsigned)c->first_word, (unsigned)c->last_word,
+           pass ? "ok" : "FAILED");
+    return pass;
+}
+
+/*******************************************************************************
+* Function Name: run_healthy
+********************************************************************************
+* Summary: Draws HEALTH_CHECK_HEALTHY_WORDS words from a healthy source,
+*          directly and through the pool, and checks that neither test trips
+*          and how close the source came to the cutoffs.
+*
+*******************************************************************************/
+static bool run_healthy(void)
+{
+    entropy_pool_stats_t stats;
+    uint8_t buf[64];
+    uint32_t word;
+    bool pass = true;
+
+    source_start(FAULT_NONE, 0u);
+    for (uint32_t i = 0u; pass && (i < (HEALTH_CHECK_HEALTHY_WORDS / 2u)); i++)
+    {
+        pass = (entropy_pool_word(&word) == CY_CRYPTOLITE_SUCCESS);
+    }
+    for (uint32_t i = 0u; pass && (i < (HEALTH_CHECK_HEALTHY_WORDS / 2u));
+         i += (uint32_t)(sizeof(buf) / sizeof(word)))
+    {
+        pass = (entropy_pool_read(buf, sizeof(buf)) == CY_CRYPTOLITE_SUCCESS);
+    }
+
+    entropy_pool_get_stats(&stats);
+    pass = pass && (stats.health == TRNG_HEALTH_OK) &&
+           (stats.health_samples ==
+            (HEALTH_CHECK_HEALTHY_WORDS * HEALTH_CHECK_SAMPLES_PER_WORD));
+
+    printf("%-12s none in %u words (longest run %u of %u, APT max %u of %u) %s\n",
+           "healthy", (unsigned)(stats.health_samples / HEALTH_CHECK_SAMPLES_PER_WORD),
+           (unsigned)stats.max_rct_count, (unsigned)TRNG_HEALTH_RCT_CUTOFF,
+           (unsigned)stats.max_apt_count, (unsigned)TRNG_HEALTH_APT_CUTOFF,
+           pass ? "ok" : "FAILED");
+    return pass;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Runs the healthy source and every fault case; returns non-zero if
+*          any of them fails.
+*
+*******************************************************************************/
+int main(void)
+{
+    bool pass = run_healthy();
+
+    for (size_t i = 0u; i < (sizeof(health_check_cases) / sizeof(health_check_cases[0])); i++)
+    {
+        pass &= run_case(&health_check_cases[i]);
+    }
+
+    entropy_pool_deinit();
+    Cy_Cryptolite_Model_SetTrngSource(NULL, NULL);
+    return pass ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,291 @@
+/******************************************************************************
+* File Name: hex_dump_bench.c
+*
+* Description: Host benchmark of hex_dump() against the per-byte snprintf() and
+* printf() loop that print_data() used before it. Both write to the same stdio
+* stream on /dev/null, so the comparison covers formatting and the calls into
+* stdio. The output of the classic format is checked against the old loop and
+* base64 against the RFC 4648 test vectors first. Built and run by 'make
+* bench'.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "hex_dump.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define HEX_DUMP_BENCH_MAX_SIZE              (4096u)
+
+/* Bytes rendered per size and variant, so small sizes run many calls */
+#define HEX_DUMP_BENCH_TOTAL_BYTES           (1024u * 1024u)
+
+/* print_data() line length */
+#define BYTES_PER_LINE                       (16u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef struct
+{
+    char const *input;
+    char const *output;
+} base64_vector_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const size_t hex_dump_bench_sizes[] =
+{
+    16u, 64u, 255u, 1024u, 4096u
+};
+
+/* RFC 4648 section 10 */
+static const base64_vector_t base64_vectors[] =
+{
+    { "",       "\r\n"             },
+    { "f",      "\r\nZg==\r\n"     },
+    { "fo",     "\r\nZm8=\r\n"     },
+    { "foo",    "\r\nZm9v\r\n"     },
+    { "foob",   "\r\nZm9vYg==\r\n" },
+    { "fooba",  "\r\nZm9vYmE=\r\n" },
+    { "foobar", "\r\nZm9vYmFy\r\n" },
+};
+
+static uint8_t bench_data[HEX_DUMP_BENCH_MAX_SIZE];
+
+/* Where uart_tx_write() sends the dump */
+static FILE *sink;
+
+/*******************************************************************************
+* Function Name: uart_tx_write
+********************************************************************************
+* Summary: Stands in for the UART transmit buffer used by hex_dump().
+*
+*******************************************************************************/
+void uart_tx_write(void const *data, size_t len)
+{
+    fwrite(data, 1u, len, sink);
+}
+
+/*******************************************************************************
+* Function Name: print_data_snprintf
+********************************************************************************
+* Summary: The print_data() loop that hex_dump() replaces, writing to out
+*          instead of stdout.
+*
+*******************************************************************************/
+static void print_data_snprintf(FILE *out, uint8_t const *data, size_t len)
+{
+    char print[10];
+
+    for (size_t i = 0u; i < len; i++)
+    {
+        if ((i % BYTES_PER_LINE) == 0u)
+        {
+            fprintf(out, "\r\n");
+        }
+        snprintf(print, 10, "0x%02X ", *(data + i));
+        fprintf(out, "%s", print);
+    }
+    fprintf(out, "\r\n");
+}
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary: Monotonic time in nanoseconds.
+*
+*******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: capture_matches
+********************************************************************************
+* Summary: Returns true if hex_dump() of data writes exactly expected.
+*
+*******************************************************************************/
+static bool capture_matches(uint8_t const *data, size_t len,
+                            hex_dump_format_t format,
+                            char const *expected, size_t expected_len)
+{
+    char *text = NULL;
+    size_t text_len = 0u;
+    bool match;
+
+    sink = open_memstream(&text, &text_len);
+    hex_dump(data, len, format);
+    fclose(sink);
+    match = (text_len == expected_len) &&
+            (memcmp(text, expected, expected_len) == 0);
+    free(text);
+    return match;
+}
+
+/*******************************************************************************
+* Function Name: check_output
+********************************************************************************
+* Summary: Returns true if the prefixed format matches print_data() for every
+*          length up to 257 bytes and base64 matches the RFC 4648 vectors.
+*
+*******************************************************************************/
+static bool check_output(void)
+{
+    char *text = NULL;
+    size_t text_len = 0u;
+    FILE *ref;
+    bool pass = true;
+
+    for (size_t len = 0u; len <= 257u; len++)
+    {
+        ref = open_memstream(&text, &text_len);
+        print_data_snprintf(ref, bench_data, len);
+        fclose(ref);
+        if (!capture_matches(bench_data, len, HEX_DUMP_FORMAT_PREFIXED,
+                             text, text_len))
+        {
+            printf("hex_dump differs from print_data at %zu bytes\n", len);
+            pass = false;
+        }
+        free(text);
+        text = NULL;
+    }
+
+    for (size_t i = 0u; i < (sizeof(base64_vectors) / sizeof(base64_vectors[0])); i++)
+    {
+        if (!capture_matches((uint8_t const *)base64_vectors[i].input,
+                             strlen(base64_vectors[i].input),
+                             HEX_DUMP_FORMAT_BASE64, base64_vectors[i].output,
+                             strlen(base64_vectors[i].output)))
+        {
+            printf("base64 of \"%s\" is wrong\n", base64_vectors[i].input);
+            pass = false;
+        }
+    }
+
+    return pass;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Checks the output, then prints MB/s of input per size for the old
+*          loop and each hex_dump() format, best of seven interleaved runs.
+*
+*******************************************************************************/
+int main(void)
+{
+    static const hex_dump_format_t formats[] =
+    {
+        HEX_DUMP_FORMAT_PREFIXED, HEX_DUMP_FORMAT_COMPACT, HEX_DUMP_FORMAT_BASE64
+    };
+    double best[1u + (sizeof(formats) / sizeof(formats[0]))];
+    double start;
+    double ns;
+    uint32_t calls;
+
+    for (size_t i = 0u; i < HEX_DUMP_BENCH_MAX_SIZE; i++)
+    {
+        bench_data[i] = (uint8_t)((i * 131u) + 7u);
+    }
+
+    if (!check_output())
+    {
+        return 1;
+    }
+
+    sink = fopen("/dev/null", "w");
+    if (sink == NULL)
+    {
+        return 1;
+    }
+
+    printf("%6s %12s %12s %12s %12s %8s\n", "size", "snprintf",
+           "prefixed", "compact", "base64", "speedup");
+    for (size_t s = 0u; s < (sizeof(hex_dump_bench_sizes) / sizeof(hex_dump_bench_sizes[0])); s++)
+    {
+        size_t size = hex_dump_bench_sizes[s];
+
+        calls = (uint32_t)(HEX_DUMP_BENCH_TOTAL_BYTES / size);
+        for (uint32_t run = 0u; run < 7u; run++)
+        {
+            start = now_ns();
+            for (uint32_t n = 0u; n < calls; n++)
+            {
+                print_data_snprintf(sink, bench_data, size);
+            }
+            ns = now_ns() - start;
+            best[0] = ((run == 0u) || (ns < best[0])) ? ns : best[0];
+
+            for (size_t f = 0u; f < (sizeof(formats) / sizeof(formats[0])); f++)
+            {
+                start = now_ns();
+                for (uint32_t n = 0u; n < calls; n++)
+                {
+                    hex_dump(bench_data, size, formats[f]);
+                }
+                ns = now_ns() - start;
+                best[f + 1u] = ((run == 0u) || (ns < best[f + 1u])) ? ns : best[f + 1u];
+            }
+        }
+
+        printf("%6zu", size);
+        for (size_t f = 0u; f < (sizeof(best) / sizeof(best[0])); f++)
+        {
+            printf(" %12.1f", ((double)calls * (double)size * 1e3) / best[f]);
+        }
+        printf(" %7.1fx\n", best[0] / best[1]);
+    }
+
+    fclose(sink);
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,345 @@
+/******************************************************************************
+* File Name: hmac_bench.c
+*
+* Description: Host check and benchmark of HMAC-SHA256. The RFC 4231 test cases
+* are run one-shot and streamed in 3-byte pieces, then short messages are timed
+* with the cached padded-key midstates against setting the key for every
+* message. Built and run by 'make bench'.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "hmac_sha256.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define HMAC_BENCH_MAX_KEY                   (131u)
+#define HMAC_BENCH_MAX_DATA                  (160u)
+
+/* Streamed cases are fed in pieces of this many bytes */
+#define HMAC_BENCH_PIECE                     (3u)
+
+/* MACs per size and variant */
+#define HMAC_BENCH_CALLS                     (20000u)
+
+/* Runs per variant, interleaved; the fastest one is reported */
+#define HMAC_BENCH_RUNS                      (7u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+/* A key or data field is either text or the len bytes fill, fill + step,
+ * fill + 2 * step, ... */
+typedef struct
+{
+    char const *text;
+    uint8_t     fill;
+    uint8_t     step;
+    size_t      len;
+} hmac_bench_field_t;
+
+typedef struct
+{
+    hmac_bench_field_t key;
+    hmac_bench_field_t data;
+    /* Case 5 checks only the first 128 bits */
+    size_t             mac_len;
+    uint8_t            mac[HMAC_SHA256_MAC_SIZE];
+} hmac_bench_case_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* RFC 4231 section 4, test cases 1 to 7 */
+static const hmac_bench_case_t rfc4231_cases[] =
+{
+    {
+        { NULL, 0x0Bu, 0u, 20u }, { "Hi There", 0u, 0u, 0u }, 32u,
+        {
+            0xB0u, 0x34u, 0x4Cu, 0x61u, 0xD8u, 0xDBu, 0x38u, 0x53u,
+            0x5Cu, 0xA8u, 0xAFu, 0xCEu, 0xAFu, 0x0Bu, 0xF1u, 0x2Bu,
+            0x88u, 0x1Du, 0xC2u, 0x00u, 0xC9u, 0x83u, 0x3Du, 0xA7u,
+            0x26u, 0xE9u, 0x37u, 0x6Cu, 0x2Eu, 0x32u, 0xCFu, 0xF7u,
+        }
+    },
+    {
+        { "Jefe", 0u, 0u, 0u },
+        { "what do ya want for nothing?", 0u, 0u, 0u }, 32u,
+        {
+            0x5Bu, 0xDCu, 0xC1u, 0x46u, 0xBFu, 0x60u, 0x75u, 0x4Eu,
+            0x6Au, 0x04u, 0x24u, 0x26u, 0x08u, 0x95u, 0x75u, 0xC7u,
+            0x5Au, 0x00u, 0x3Fu, 0x08u, 0x9Du, 0x27u, 0x39u, 0x83u,
+            0x9Du, 0xECu, 0x58u, 0xB9u, 0x64u, 0xECu, 0x38u, 0x43u,
+        }
+    },
+    {
+        { NULL, 0xAAu, 0u, 20u }, { NULL, 0xDDu, 0u, 50u }, 32u,
+        {
+            0x77u, 0x3Eu, 0xA9u, 0x1Eu, 0x36u, 0x80u, 0x0Eu, 0x46u,
+            0x85u, 0x4Du, 0xB8u, 0xEBu, 0xD0u, 0x91u, 0x81u, 0xA7u,
+            0x29u, 0x59u, 0x09u, 0x8Bu, 0x3Eu, 0xF8u, 0xC1u, 0x22u,
+            0xD9u, 0x63u, 0x55u, 0x14u, 0xCEu, 0xD5u, 0x65u, 0xFEu,
+        }
+    },
+    {
+        { NULL, 0x01u, 1u, 25u }, { NULL, 0xCDu, 0u, 50u }, 32u,
+        {
+            0x82u, 0x55u, 0x8Au, 0x38u, 0x9Au, 0x44u, 0x3Cu, 0x0Eu,
+            0xA4u, 0xCCu, 0x81u, 0x98u, 0x99u, 0xF2u, 0x08u, 0x3Au,
+            0x85u, 0xF0u, 0xFAu, 0xA3u, 0xE5u, 0x78u, 0xF8u, 0x07u,
+            0x7Au, 0x2Eu, 0x3Fu, 0xF4u, 0x67u, 0x29u, 0x66u, 0x5Bu,
+        }
+    },
+    {
+        { NULL, 0x0Cu, 0u, 20u },
+        { "Test With Truncation", 0u, 0u, 0u }, 16u,
+        {
+            0xA3u, 0xB6u, 0x16u, 0x74u, 0x73u, 0x10u, 0x0Eu, 0xE0u,
+            0x6Eu, 0x0Cu, 0x79u, 0x6Cu, 0x29u, 0x55u, 0x55u, 0x2Bu,
+        }
+    },
+    {
+        { NULL, 0xAAu, 0u, 131u },
+        {
+            "Test Using Larger Than Block-Size Key - Hash Key First",
+            0u, 0u, 0u
+        },
+        32u,
+        {
+            0x60u, 0xE4u, 0x31u, 0x59u, 0x1Eu, 0xE0u, 0xB6u, 0x7Fu,
+            0x0Du, 0x8Au, 0x26u, 0xAAu, 0xCBu, 0xF5u, 0xB7u, 0x7Fu,
+            0x8Eu, 0x0Bu, 0xC6u, 0x21u, 0x37u, 0x28u, 0xC5u, 0x14u,
+            0x05u, 0x46u, 0x04u, 0x0Fu, 0x0Eu, 0xE3u, 0x7Fu, 0x54u,
+        }
+    },
+    {
+        { NULL, 0xAAu, 0u, 131u },
+        {
+            "This is a test using a larger than block-size key and a larger "
+            "than block-size data. The key needs to be hashed before being "
+            "used by the HMAC algorithm.",
+            0u, 0u, 0u
+        },
+        32u,
+        {
+            0x9Bu, 0x09u, 0xFFu, 0xA7u, 0x1Bu, 0x94u, 0x2Fu, 0xCBu,
+            0x27u, 0x63u, 0x5Fu, 0xBCu, 0xD5u, 0xB0u, 0xE9u, 0x44u,
+            0xBFu, 0xDCu, 0x63u, 0x64u, 0x4Fu, 0x07u, 0x13u, 0x93u,
+            0x8Au, 0x7Fu, 0x51u, 0x53u, 0x5Cu, 0x3Au, 0x35u, 0xE2u,
+        }
+    },
+};
+
+static const size_t hmac_bench_sizes[] = { 16u, 32u, 64u };
+
+static hmac_sha256_t bench_hmac;
+static uint8_t bench_key[HMAC_BENCH_MAX_KEY];
+static uint8_t bench_data[HMAC_BENCH_MAX_DATA];
+
+/*******************************************************************************
+* Function Name: field_get
+********************************************************************************
+* Summary: Writes a key or data field to buf and returns its length.
+*
+*******************************************************************************/
+static size_t field_get(hmac_bench_field_t const *field, uint8_t *buf)
+{
+    if (field->text != NULL)
+    {
+        memcpy(buf, field->text, strlen(field->text));
+        return strlen(field->text);
+    }
+    for (size_t i = 0u; i < field->len; i++)
+    {
+        buf[i] = (uint8_t)(field->fill + (field->step * i));
+    }
+    return field->len;
+}
+
+/*******************************************************************************
+* Function Name: check_case
+********************************************************************************
+* Summary: Returns true if case c gives its MAC both one-shot and streamed.
+*
+*******************************************************************************/
+static bool check_case(hmac_bench_case_t const *c)
+{
+    uint8_t mac[HMAC_SHA256_MAC_SIZE];
+    size_t key_len = field_get(&c->key, bench_key);
+    size_t data_len = field_get(&c->data, bench_data);
+    size_t piece;
+    bool pass;
+
+    pass = (hmac_sha256_set_key(&bench_hmac, bench_key, key_len) ==
+            CY_CRYPTOLITE_SUCCESS) &&
+           (hmac_sha256(&bench_hmac, bench_data, data_len, mac) ==
+            CY_CRYPTOLITE_SUCCESS) &&
+           (memcmp(mac, c->mac, c->mac_len) == 0);
+
+    memset(mac, 0, sizeof(mac));
+    pass = pass && (hmac_sha256_start(&bench_hmac) == CY_CRYPTOLITE_SUCCESS);
+    for (size_t pos = 0u; pass && (pos < data_len); pos += piece)
+    {
+        piece = ((data_len - pos) < HMAC_BENCH_PIECE) ? (data_len - pos)
+                                                      : HMAC_BENCH_PIECE;
+        pass = (hmac_sha256_update(&bench_hmac, &bench_data[pos], piece) ==
+                CY_CRYPTOLITE_SUCCESS);
+    }
+    pass = pass &&
+           (hmac_sha256_finish(&bench_hmac, mac) == CY_CRYPTOLITE_SUCCESS) &&
+           (memcmp(mac, c->mac, c->mac_len) == 0);
+    return pass;
+}
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary: Monotonic time in nanoseconds.
+*
+*******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: time_mac
+********************************************************************************
+* Summary: Returns the average time of one MAC over len bytes in nanoseconds,
+*          setting the key before each one if rekey is true, or a negative
+*          value if a call failed.
+*
+*******************************************************************************/
+static double time_mac(bool rekey, size_t len)
+{
+    uint8_t mac[HMAC_SHA256_MAC_SIZE];
+    double start = now_ns();
+
+    for (uint32_t i = 0u; i < HMAC_BENCH_CALLS; i++)
+    {
+        if (rekey && (hmac_sha256_set_key(&bench_hmac, bench_key, 32u) !=
+                      CY_CRYPTOLITE_SUCCESS))
+        {
+            return -1.0;
+        }
+        if (hmac_sha256(&bench_hmac, bench_data, len, mac) !=
+            CY_CRYPTOLITE_SUCCESS)
+        {
+            return -1.0;
+        }
+        /* Keep the calls from being merged or dropped */
+        __asm__ volatile("" : : "r"(mac) : "memory");
+    }
+    return (now_ns() - start) / (double)HMAC_BENCH_CALLS;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Checks the RFC 4231 cases, then prints the best time per MAC with
+*          the key set once and with the key set for every message.
+*
+*******************************************************************************/
+int main(void)
+{
+    double cached_ns;
+    double rekey_ns;
+    double ns;
+
+    for (size_t i = 0u; i < (sizeof(rfc4231_cases) / sizeof(rfc4231_cases[0])); i++)
+    {
+        if (!check_case(&rfc4231_cases[i]))
+        {
+            printf("RFC 4231 test case %zu failed\n", i + 1u);
+            return 1;
+        }
+    }
+    printf("RFC 4231 test cases 1-7 ok\n");
+
+    for (size_t i = 0u; i < sizeof(bench_key); i++)
+    {
+        bench_key[i] = (uint8_t)(i * 7u);
+    }
+    for (size_t i = 0u; i < sizeof(bench_data); i++)
+    {
+        bench_data[i] = (uint8_t)(i * 13u + 1u);
+    }
+
+    printf("%6s %12s %12s %8s %12s\n", "size", "rekey ns", "cached ns",
+           "speedup", "MACs/s");
+    for (size_t s = 0u; s < (sizeof(hmac_bench_sizes) / sizeof(hmac_bench_sizes[0])); s++)
+    {
+        rekey_ns = 0.0;
+        cached_ns = 0.0;
+        for (uint32_t run = 0u; run < HMAC_BENCH_RUNS; run++)
+        {
+            ns = time_mac(true, hmac_bench_sizes[s]);
+            rekey_ns = ((run == 0u) || (ns < rekey_ns)) ? ns : rekey_ns;
+
+            if (hmac_sha256_set_key(&bench_hmac, bench_key, 32u) !=
+                CY_CRYPTOLITE_SUCCESS)
+            {
+                ns = -1.0;
+            }
+            else
+            {
+                ns = time_mac(false, hmac_bench_sizes[s]);
+            }
+            cached_ns = ((run == 0u) || (ns < cached_ns)) ? ns : cached_ns;
+            if ((rekey_ns < 0.0) || (cached_ns < 0.0))
+            {
+                printf("HMAC failed at size %zu\n", hmac_bench_sizes[s]);
+                return 1;
+            }
+        }
+        printf("%6zu %12.1f %12.1f %7.2fx %12.0f\n", hmac_bench_sizes[s],
+               rekey_ns, cached_ns, rekey_ns / cached_ns, 1e9 / cached_ns);
+    }
+
+    hmac_sha256_clear(&bench_hmac);
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,190 @@
+/******************************************************************************
+* File Name: password_bench.c
+*
+* Description: Host benchmark of the password generator: passwords per second
+* and random bytes used per password for a few alphabets and lengths, drawing
+* on the entropy pool over the modelled TRNG, next to the former mask-and-shift
+* scheme. Built and run by 'make bench'; set CY_HOST_TRNG_WORD_NS to give the
+* TRNG a realistic speed.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "password_gen.h"
+#include "entropy_pool.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PASSWORD_BENCH_COUNT                 (100000u)
+#define PASSWORD_BENCH_MAX_LENGTH            (32u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef struct
+{
+    char const *name;
+    char const *alphabet;
+    size_t      length;
+} password_bench_case_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const password_bench_case_t password_bench_cases[] =
+{
+    { "printable", PASSWORD_GEN_ALPHABET_PRINTABLE,  8u },
+    { "printable", PASSWORD_GEN_ALPHABET_PRINTABLE, 16u },
+    { "alnum",     PASSWORD_GEN_ALPHABET_ALNUM,     16u },
+    { "hex",       "0123456789abcdef",              32u },
+    { "digits",    "0123456789",                     6u },
+};
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary: Monotonic time in nanoseconds.
+*
+*******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: mask_password
+********************************************************************************
+* Summary: The scheme used before password_gen: one random byte per
+*          character, masked to 7 bits, with 33 added below 33.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t mask_password(char *password, size_t len)
+{
+    cy_en_cryptolite_status_t res;
+
+    res = entropy_pool_read((uint8_t *)password, len);
+    for (size_t i = 0u; i < len; i++)
+    {
+        password[i] &= 0x7F;
+        if (password[i] < 33)
+        {
+            password[i] += 33;
+        }
+    }
+    password[len] = '\0';
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Times PASSWORD_BENCH_COUNT passwords per case. "bytes used" is the
+*          random bytes taken from the pool per password, "bytes ideal" the
+*          entropy of the password.
+*
+*******************************************************************************/
+int main(void)
+{
+    cy_stc_cryptolite_trng_config_t config;
+    password_gen_t gen;
+    char password[PASSWORD_BENCH_MAX_LENGTH + 1u];
+    password_bench_case_t const *c;
+    size_t alphabet_len;
+    double start;
+    double elapsed;
+
+    if (entropy_pool_init(&config) != CY_CRYPTOLITE_SUCCESS)
+    {
+        printf("TRNG init failed\n");
+        return 1;
+    }
+
+    printf("%-10s %5s %6s %12s %12s %12s %9s\n", "alphabet", "size",
+           "length", "passwords/s", "bytes used", "bytes ideal", "rejected");
+    for (size_t i = 0u; i < (sizeof(password_bench_cases) / sizeof(password_bench_cases[0])); i++)
+    {
+        c = &password_bench_cases[i];
+        alphabet_len = strlen(c->alphabet);
+        password_gen_init(&gen, entropy_pool_read);
+
+        start = now_ns();
+        for (uint32_t n = 0u; n < PASSWORD_BENCH_COUNT; n++)
+        {
+            if (password_gen_generate(&gen, c->alphabet, alphabet_len,
+                                      password, c->length)
+                != CY_CRYPTOLITE_SUCCESS)
+            {
+                printf("password_gen_generate failed\n");
+                return 1;
+            }
+        }
+        elapsed = now_ns() - start;
+
+        printf("%-10s %5zu %6zu %12.0f %12.2f %12.2f %8.1f%%\n", c->name,
+               alphabet_len, c->length,
+               PASSWORD_BENCH_COUNT * 1e9 / elapsed,
+               (double)gen.bytes_used / PASSWORD_BENCH_COUNT,
+               (double)c->length * log2((double)alphabet_len) / 8.0,
+               100.0 * gen.rejected / (gen.draws + gen.rejected));
+        password_gen_clear(&gen);
+    }
+
+    start = now_ns();
+    for (uint32_t n = 0u; n < PASSWORD_BENCH_COUNT; n++)
+    {
+        if (mask_password(password, 8u) != CY_CRYPTOLITE_SUCCESS)
+        {
+            printf("entropy_pool_read failed\n");
+            return 1;
+        }
+    }
+    elapsed = now_ns() - start;
+    printf("%-10s %5s %6u %12.0f %12.2f %12s %9s\n", "former", "95",
+           8u, PASSWORD_BENCH_COUNT * 1e9 / elapsed, 8.0, "-", "-");
+
+    entropy_pool_deinit();
+    return 0;
+}
@@ -0,0 +1,209 @@
+/******************************************************************************
+* File Name: password_check.c
+*
+* Description: Host check that password_gen_index() is uniform. It draws
+* several million values for each of a few alphabet sizes, including the 94
+* visible ASCII characters and other sizes that are not powers of two, from the
+* entropy pool as the application does, and applies a chi-square test to the
+* counts. The 7-bit mask scheme that password_gen replaced must fail the same
+* test, which shows the test can detect its bias. Built and run by 'make
+* check'.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "password_gen.h"
+#include "entropy_pool.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Values drawn per alphabet size */
+#define PASSWORD_CHECK_DRAWS                 (4u * 1024u * 1024u)
+
+/* Largest accepted |z| of the chi-square statistic. A uniform generator
+ * exceeds it with a probability of about 6e-5 per size; 'make check' fixes
+ * the TRNG seed, so the run is repeatable. */
+#define PASSWORD_CHECK_MAX_Z                 (4.0)
+
+/* Values of the former scheme: '!' (33) to DEL (127) */
+#define PASSWORD_CHECK_FORMER_SIZE           (95u)
+#define PASSWORD_CHECK_FORMER_FIRST          (33u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Printable and alphanumeric alphabets, digits, and sizes just above and
+ * below powers of two, where rejection is most and least frequent */
+static const uint32_t password_check_sizes[] = { 3u, 10u, 62u, 94u, 129u, 255u };
+
+static uint32_t counts[256];
+
+/*******************************************************************************
+* Function Name: chi_square_z
+********************************************************************************
+* Summary: Returns the chi-square statistic of counts[0..n-1] against a
+*          uniform distribution over total values, turned into a standard
+*          normal z with the Wilson-Hilferty approximation.
+*
+*******************************************************************************/
+static double chi_square_z(uint32_t n, uint32_t total, double *chi2)
+{
+    double expected = (double)total / (double)n;
+    double df = (double)n - 1.0;
+    double d;
+
+    *chi2 = 0.0;
+    for (uint32_t i = 0u; i < n; i++)
+    {
+        d = (double)counts[i] - expected;
+        *chi2 += (d * d) / expected;
+    }
+    return (cbrt(*chi2 / df) - (1.0 - (2.0 / (9.0 * df)))) /
+           sqrt(2.0 / (9.0 * df));
+}
+
+/*******************************************************************************
+* Function Name: check_size
+********************************************************************************
+* Summary: Draws PASSWORD_CHECK_DRAWS values below n and tests their counts.
+*
+*******************************************************************************/
+static bool check_size(password_gen_t *gen, uint32_t n)
+{
+    uint32_t index;
+    double chi2;
+    double z;
+
+    memset(counts, 0, sizeof(counts));
+    for (uint32_t i = 0u; i < PASSWORD_CHECK_DRAWS; i++)
+    {
+        if ((password_gen_index(gen, n, &index) != CY_CRYPTOLITE_SUCCESS) ||
+            (index >= n))
+        {
+            printf("password_gen_index failed for n = %lu\n",
+                   (unsigned long)n);
+            return false;
+        }
+        counts[index]++;
+    }
+
+    z = chi_square_z(n, PASSWORD_CHECK_DRAWS, &chi2);
+    printf("n = %3lu: chi2 %9.1f on %3lu df, z %5.2f %s\n", (unsigned long)n,
+           chi2, (unsigned long)(n - 1u), z,
+           (fabs(z) <= PASSWORD_CHECK_MAX_Z) ? "ok" : "FAILED");
+    return fabs(z) <= PASSWORD_CHECK_MAX_Z;
+}
+
+/*******************************************************************************
+* Function Name: check_former
+********************************************************************************
+* Summary: Tests the former scheme, one random byte per character masked to
+*          7 bits with 33 added below 33, which must be rejected.
+*
+*******************************************************************************/
+static bool check_former(void)
+{
+    uint8_t buf[PASSWORD_GEN_BUFFER_SIZE];
+    uint8_t c;
+    double chi2;
+    double z;
+
+    memset(counts, 0, sizeof(counts));
+    for (uint32_t i = 0u; i < PASSWORD_CHECK_DRAWS; i += sizeof(buf))
+    {
+        if (entropy_pool_read(buf, sizeof(buf)) != CY_CRYPTOLITE_SUCCESS)
+        {
+            printf("entropy_pool_read failed\n");
+            return false;
+        }
+        for (size_t j = 0u; j < sizeof(buf); j++)
+        {
+            c = (uint8_t)(buf[j] & 0x7Fu);
+            if (c < PASSWORD_CHECK_FORMER_FIRST)
+            {
+                c += PASSWORD_CHECK_FORMER_FIRST;
+            }
+            counts[c - PASSWORD_CHECK_FORMER_FIRST]++;
+        }
+    }
+
+    z = chi_square_z(PASSWORD_CHECK_FORMER_SIZE, PASSWORD_CHECK_DRAWS, &chi2);
+    printf("former: chi2 %9.1f on %3u df, z %5.1f %s\n", chi2,
+           PASSWORD_CHECK_FORMER_SIZE - 1u, z,
+           (z > PASSWORD_CHECK_MAX_Z) ? "rejected as expected" : "NOT REJECTED");
+    return z > PASSWORD_CHECK_MAX_Z;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Runs the chi-square test for every size, then for the former
+*          scheme. Returns nonzero if any size fails or the former scheme
+*          passes.
+*
+*******************************************************************************/
+int main(void)
+{
+    cy_stc_cryptolite_trng_config_t config;
+    password_gen_t gen;
+    bool ok = true;
+
+    if (entropy_pool_init(&config) != CY_CRYPTOLITE_SUCCESS)
+    {
+        printf("TRNG init failed\n");
+        return 1;
+    }
+
+    password_gen_init(&gen, entropy_pool_read);
+    for (size_t i = 0u; i < (sizeof(password_check_sizes) / sizeof(password_check_sizes[0])); i++)
+    {
+        ok = check_size(&gen, password_check_sizes[i]) && ok;
+    }
+    password_gen_clear(&gen);
+
+    ok = check_former() && ok;
+
+    entropy_pool_deinit();
+    return ok ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,195 @@
+/******************************************************************************
+* File Name: random_bench.c
+*
+* Description: Host benchmark of random_fill() against the per-word loop it
+* replaces (one health-checked TRNG word into a local and a copy of up to
+* 4 bytes), for buffers from 4 bytes to 4 KiB at aligned and misaligned
+* destinations. Built and run by 'make bench'.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "random_fill.h"
+#include "entropy_pool.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define RANDOM_BENCH_MAX_SIZE                (4096u)
+
+/* Bytes produced per size and variant, so small sizes run many calls */
+#define RANDOM_BENCH_TOTAL_BYTES             (1024u * 1024u)
+
+/* Runs per variant, interleaved; the fastest one is reported */
+#define RANDOM_BENCH_RUNS                    (7u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const size_t random_bench_sizes[] =
+{
+    4u, 5u, 8u, 13u, 16u, 32u, 64u, 128u, 256u, 512u, 1024u, 2048u, 4096u
+};
+
+/* One spare word so that the destination can start off a word boundary */
+static uint32_t bench_buf[(RANDOM_BENCH_MAX_SIZE / 4u) + 1u];
+
+/*******************************************************************************
+* Function Name: word_loop
+********************************************************************************
+* Summary: The loop used before random_fill(): one word into a local and a
+*          copy of up to 4 bytes. It takes its words from entropy_pool_word()
+*          so that both variants pay for the same health tests and only the
+*          way the words reach the buffer differs.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t __attribute__((noinline)) word_loop(void *buf,
+                                                                     size_t len)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+    uint8_t *dst = (uint8_t *)buf;
+    uint32_t random_val;
+
+    for (size_t i = 0u; (i < len) && (res == CY_CRYPTOLITE_SUCCESS); i += 4u)
+    {
+        res = entropy_pool_word(&random_val);
+        memcpy(&dst[i], &random_val, ((len - i) < 4u) ? (len - i) : 4u);
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary: Monotonic time in nanoseconds.
+*
+*******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: time_fill
+********************************************************************************
+* Summary: Returns the average time of one call in nanoseconds, or a negative
+*          value if a call failed.
+*
+*******************************************************************************/
+static double time_fill(cy_en_cryptolite_status_t (*fn)(void *, size_t),
+                        size_t offset, size_t len)
+{
+    size_t calls = RANDOM_BENCH_TOTAL_BYTES / len;
+    double start = now_ns();
+
+    for (size_t i = 0u; i < calls; i++)
+    {
+        if (fn((uint8_t *)bench_buf + offset, len) != CY_CRYPTOLITE_SUCCESS)
+        {
+            return -1.0;
+        }
+        /* Keep the calls from being merged or dropped */
+        __asm__ volatile("" : : "r"(bench_buf) : "memory");
+    }
+    return (now_ns() - start) / (double)calls;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Prints the best time per call of both variants and the speedup. The
+*          entropy pool is left empty, so both variants generate every word
+*          themselves.
+*
+*******************************************************************************/
+int main(void)
+{
+    cy_stc_cryptolite_trng_config_t config;
+    size_t len;
+    double loop_ns;
+    double fill_ns;
+    double ns;
+
+    if (entropy_pool_init(&config) != CY_CRYPTOLITE_SUCCESS)
+    {
+        printf("TRNG init failed\n");
+        return 1;
+    }
+
+    printf("%6s %8s %12s %14s %8s %10s\n", "size", "dst", "loop ns",
+           "random_fill ns", "speedup", "MB/s");
+    for (size_t s = 0u; s < (sizeof(random_bench_sizes) / sizeof(random_bench_sizes[0])); s++)
+    {
+        len = random_bench_sizes[s];
+        for (size_t offset = 0u; offset < 2u; offset++)
+        {
+            loop_ns = 0.0;
+            fill_ns = 0.0;
+            for (uint32_t run = 0u; run < RANDOM_BENCH_RUNS; run++)
+            {
+                ns = time_fill(word_loop, offset, len);
+                if (ns < 0.0)
+                {
+                    printf("TRNG failed at size %zu\n", len);
+                    return 1;
+                }
+                loop_ns = ((run == 0u) || (ns < loop_ns)) ? ns : loop_ns;
+
+                ns = time_fill(random_fill, offset, len);
+                if (ns < 0.0)
+                {
+                    printf("TRNG failed at size %zu\n", len);
+                    return 1;
+                }
+                fill_ns = ((run == 0u) || (ns < fill_ns)) ? ns : fill_ns;
+            }
+            printf("%6zu %8s %12.1f %14.1f %7.2fx %10.1f\n", len,
+                   (offset == 0u) ? "aligned" : "offset", loop_ns, fill_ns,
+                   loop_ns / fill_ns, (double)len * 1e3 / fill_ns);
+        }
+    }
+
+    entropy_pool_deinit();
+    return 0;
+}
@@ -0,0 +1,386 @@
+/******************************************************************************
+* File Name: rx_bench.c
+*
+* Description: Host load test of the interrupt-driven UART receiver. uart_rx.c
+* runs against a model of the UART that delivers a stream of 90-character lines
+* at the line rate in simulated time and raises the RX interrupt for every
+* character, while the main loop consumes whole lines and spends a fixed time
+* on each. It checks that nothing is lost while the main loop keeps up, that
+* losses are counted when it cannot, and reports how much of the time the CPU
+* sleeps and what the interrupt handler costs. Built and run by 'make bench'.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "uart_rx.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Characters per line before the ENTER, and lines per scenario */
+#define RX_BENCH_LINE_LENGTH                 (90u)
+#define RX_BENCH_LINES                       (2000u)
+#define RX_BENCH_STREAM_SIZE                 ((RX_BENCH_LINE_LENGTH + 1u) * \
+                                              RX_BENCH_LINES)
+
+/* 8N1: ten bit times per character, in picoseconds at 1 baud */
+#define RX_BENCH_CHAR_PS_BAUD                (10000000000000ull)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef struct
+{
+    uint32_t baudrate;
+    /* Simulated main loop time spent on each line */
+    uint32_t work_us;
+    /* Whether the main loop keeps up, so that no character may be lost */
+    bool     lossless;
+} rx_bench_scenario_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const rx_bench_scenario_t rx_bench_scenarios[] =
+{
+    {  115200u,   50u, true  },
+    {  921600u,   50u, true  },
+    { 3000000u,   50u, true  },
+    /* 2.5 ms per line at 3 Mbaud: about 750 characters arrive meanwhile,
+     * more than the ring buffer holds */
+    { 3000000u, 2500u, false },
+};
+
+static uint8_t line_stream[RX_BENCH_STREAM_SIZE];
+
+/* UART model: characters [line_read, line_arrived) are in the hardware FIFO.
+ * Simulated time is kept in whole picoseconds so that a wake-up lands
+ * exactly on the arrival of a character. */
+static cyhal_uart_t bench_uart;
+static uint64_t char_ps;
+static uint64_t sim_ps;
+static size_t line_read;
+static size_t line_arrived;
+static uint32_t fifo_overflows;
+static uint32_t irq_masked;
+
+/* Real time spent in the interrupt handler */
+static double isr_ns;
+
+/* Simulated time spent in __WFI() and the number of wake-ups */
+static uint64_t idle_ps;
+static uint32_t wakeups;
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary: Monotonic time in nanoseconds.
+*
+*******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: line_deliver
+********************************************************************************
+* Summary: Moves the characters received by the current simulated time into
+*          the hardware FIFO, counting those it has no room for, and runs the
+*          RX interrupt handler unless interrupts are masked.
+*
+*******************************************************************************/
+static void line_deliver(void)
+{
+    size_t arrived = (size_t)(sim_ps / char_ps);
+    double start;
+
+    if (arrived > RX_BENCH_STREAM_SIZE)
+    {
+        arrived = RX_BENCH_STREAM_SIZE;
+    }
+    if ((arrived - line_read) > CYHAL_HOST_UART_FIFO_DEPTH)
+    {
+        fifo_overflows += (uint32_t)(arrived - line_read - CYHAL_HOST_UART_FIFO_DEPTH);
+        line_read = arrived - CYHAL_HOST_UART_FIFO_DEPTH;
+    }
+    line_arrived = arrived;
+
+    if ((irq_masked == 0u) && (line_read < line_arrived) &&
+        (bench_uart.callback != NULL))
+    {
+        start = now_ns();
+        bench_uart.callback(bench_uart.callback_arg, CYHAL_UART_IRQ_RX_NOT_EMPTY);
+        isr_ns += now_ns() - start;
+    }
+}
+
+/*******************************************************************************
+* Function Name: advance
+********************************************************************************
+* Summary: Lets simulated time pass character by character, so that the
+*          interrupt fires for each one as it would on the device.
+*
+*******************************************************************************/
+static void advance(uint64_t ps)
+{
+    uint64_t end = sim_ps + ps;
+    uint64_t next;
+
+    while (sim_ps < end)
+    {
+        next = ((sim_ps / char_ps) + 1u) * char_ps;
+        sim_ps = (next < end) ? next : end;
+        line_deliver();
+    }
+}
+
+/*******************************************************************************
+* Function Name: cyhal_uart_readable / getc / register_callback /
+*                enable_event
+********************************************************************************
+* Summary: UART model used by uart_rx.c in place of cyhal_uart_host.c.
+*
+*******************************************************************************/
+uint32_t cyhal_uart_readable(cyhal_uart_t *obj)
+{
+    (void)obj;
+    return (uint32_t)(line_arrived - line_read);
+}
+
+cy_rslt_t cyhal_uart_getc(cyhal_uart_t *obj, uint8_t *value, uint32_t timeout)
+{
+    (void)obj;
+    (void)timeout;
+    if (line_read == line_arrived)
+    {
+        return (cy_rslt_t)1u;
+    }
+    *value = line_stream[line_read++];
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_uart_register_callback(cyhal_uart_t *obj,
+                                  cyhal_uart_event_callback_t callback,
+                                  void *callback_arg)
+{
+    obj->callback = callback;
+    obj->callback_arg = callback_arg;
+}
+
+void cyhal_uart_enable_event(cyhal_uart_t *obj, cyhal_uart_event_t event,
+                             uint8_t intr_priority, bool enable)
+{
+    (void)intr_priority;
+    if (enable)
+    {
+        obj->enabled_events |= (uint32_t)event;
+    }
+    else
+    {
+        obj->enabled_events &= ~(uint32_t)event;
+    }
+}
+
+/*******************************************************************************
+* Function Name: cyhal_system_critical_section_enter / _exit
+********************************************************************************
+* Summary: Masks the modelled interrupt.
+*
+*******************************************************************************/
+uint32_t cyhal_system_critical_section_enter(void)
+{
+    uint32_t old_state = irq_masked;
+
+    irq_masked = 1u;
+    return old_state;
+}
+
+void cyhal_system_critical_section_exit(uint32_t old_state)
+{
+    irq_masked = old_state;
+    if (irq_masked == 0u)
+    {
+        line_deliver();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_Host_WaitForInterrupt
+********************************************************************************
+* Summary: __WFI(): sleeps in simulated time until the next character has
+*          arrived. The handler runs when uart_rx_wait() unmasks interrupts.
+*
+*******************************************************************************/
+void Cy_Host_WaitForInterrupt(void)
+{
+    uint64_t start = sim_ps;
+
+    if (line_arrived < RX_BENCH_STREAM_SIZE)
+    {
+        sim_ps = (uint64_t)(line_arrived + 1u) * char_ps;
+        line_arrived = line_arrived + 1u;
+        idle_ps += sim_ps - start;
+        wakeups++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: run_scenario
+********************************************************************************
+* Summary: Streams all lines through the receiver and returns true if the
+*          outcome matches the scenario: every line intact when lossless,
+*          otherwise every lost character accounted for.
+*
+*******************************************************************************/
+static bool run_scenario(rx_bench_scenario_t const *scenario)
+{
+    uart_rx_stats_t stats;
+    uint8_t const *data;
+    uint32_t count;
+    uint32_t used;
+    uint32_t lines = 0u;
+    uint32_t lines_ok = 0u;
+    size_t line_pos = 0u;
+    bool line_ok = true;
+    bool pass;
+
+    char_ps = RX_BENCH_CHAR_PS_BAUD / scenario->baudrate;
+    sim_ps = 0u;
+    line_read = 0u;
+    line_arrived = 0u;
+    fifo_overflows = 0u;
+    irq_masked = 0u;
+    isr_ns = 0.0;
+    idle_ps = 0u;
+    wakeups = 0u;
+    uart_rx_init(&bench_uart);
+
+    /* Main loop in the style of enter_message(): take what has arrived up
+     * to the ENTER, then work on the line */
+    while ((line_read < RX_BENCH_STREAM_SIZE) ||
+           (uart_rx_peek(&data) != 0u))
+    {
+        count = uart_rx_peek(&data);
+        if (count == 0u)
+        {
+            uart_rx_wait();
+            continue;
+        }
+        for (used = 0u; used < count; used++)
+        {
+            if (data[used] == (uint8_t)'\n')
+            {
+                break;
+            }
+            line_ok = line_ok && (line_pos < RX_BENCH_LINE_LENGTH) &&
+                      (data[used] == line_stream[(lines * (RX_BENCH_LINE_LENGTH + 1u)) + line_pos]);
+            line_pos++;
+        }
+        if (used < count)
+        {
+            uart_rx_consume(used + 1u);
+            lines_ok += (line_ok && (line_pos == RX_BENCH_LINE_LENGTH)) ? 1u : 0u;
+            lines++;
+            line_pos = 0u;
+            line_ok = true;
+            advance((uint64_t)scenario->work_us * 1000000u);
+        }
+        else
+        {
+            uart_rx_consume(used);
+        }
+    }
+
+    uart_rx_get_stats(&stats);
+    if (scenario->lossless)
+    {
+        pass = (lines_ok == RX_BENCH_LINES) && (stats.dropped == 0u) &&
+               (fifo_overflows == 0u);
+    }
+    else
+    {
+        pass = ((stats.dropped + fifo_overflows) > 0u) &&
+               ((stats.received + stats.dropped + fifo_overflows) ==
+                RX_BENCH_STREAM_SIZE);
+    }
+
+    printf("%8u %8u %9u %8u %8u %7.1f%% %9u %9.1f %s\n",
+           (unsigned)scenario->baudrate, (unsigned)scenario->work_us,
+           (unsigned)lines_ok, (unsigned)stats.dropped,
+           (unsigned)fifo_overflows, 100.0 * (double)idle_ps / (double)sim_ps,
+           (unsigned)wakeups, isr_ns / (double)stats.received,
+           pass ? "ok" : "FAILED");
+    return pass;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Runs every scenario and prints per line rate and work time: the
+*          intact lines, characters dropped by the ring buffer and by the
+*          hardware FIFO, the share of time asleep in __WFI(), the wake-ups
+*          and the host time of the interrupt handler per character.
+*
+*******************************************************************************/
+int main(void)
+{
+    bool pass = true;
+
+    for (size_t i = 0u; i < RX_BENCH_STREAM_SIZE; i++)
+    {
+        line_stream[i] = ((i % (RX_BENCH_LINE_LENGTH + 1u)) == RX_BENCH_LINE_LENGTH)
+                         ? (uint8_t)'\n' : (uint8_t)('a' + ((i * 7u) % 26u));
+    }
+
+    printf("%8s %8s %9s %8s %8s %8s %9s %9s\n", "baud", "work us", "lines ok",
+           "dropped", "fifo", "asleep", "wake-ups", "isr ns/ch");
+    for (size_t i = 0u; i < (sizeof(rx_bench_scenarios) / sizeof(rx_bench_scenarios[0])); i++)
+    {
+        pass &= run_scenario(&rx_bench_scenarios[i]);
+    }
+    return pass ? 0 : 1;
+}
+
+/* [] END OF FILE */
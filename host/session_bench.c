@@ -0,0 +1,229 @@
+/******************************************************************************
+* File Name: session_bench.c
+*
+* Description: Host benchmark of the per-message AES setup cost. Before
+* aes_session, each message ran Cy_Cryptolite_Aes_Init() and
+* Cy_Cryptolite_Aes_Free() around its CTR call; now the key stays loaded and
+* aes_session_load() with the same key returns at once. Both variants must
+* produce the same ciphertext. Built and run by 'make bench'.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_session.h"
+#include "aes_ctr.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SESSION_BENCH_MAX_SIZE               (256u)
+
+/* Messages per size and variant */
+#define SESSION_BENCH_CALLS                  (20000u)
+
+/* Runs per variant, interleaved; the fastest one is reported */
+#define SESSION_BENCH_RUNS                   (7u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const size_t session_bench_sizes[] = { 0u, 16u, 64u, 256u };
+
+static const uint8_t bench_key[AES_SESSION_KEY_SIZE] =
+{
+    0xAAu, 0xBBu, 0xCCu, 0xDDu, 0xEEu, 0xFFu, 0xFFu, 0xEEu,
+    0xDDu, 0xCCu, 0xBBu, 0xAAu, 0xAAu, 0xBBu, 0xCCu, 0xDDu,
+};
+
+static const uint8_t bench_iv[AES_CTR_BLOCK_SIZE] =
+{
+    0x00u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u,
+    0x08u, 0x09u, 0x0Au, 0x0Bu, 0x0Cu, 0x0Du, 0x0Eu, 0x0Fu,
+};
+
+static aes_session_t bench_session;
+static uint8_t bench_src[SESSION_BENCH_MAX_SIZE];
+static uint8_t bench_dst[SESSION_BENCH_MAX_SIZE];
+static uint8_t bench_ref[SESSION_BENCH_MAX_SIZE];
+
+/*******************************************************************************
+* Function Name: message_init_free
+********************************************************************************
+* Summary: One CTR message the way it was done before aes_session: key
+*          context set up and torn down around the PDL call.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t message_init_free(uint8_t *dst, size_t len)
+{
+    cy_en_cryptolite_status_t res;
+    cy_stc_cryptolite_aes_state_t state;
+    cy_stc_cryptolite_aes_buffers_t buffers;
+    uint8_t iv[AES_CTR_BLOCK_SIZE];
+    uint32_t offset = 0u;
+
+    res = Cy_Cryptolite_Aes_Init(CRYPTOLITE, bench_key, &state, &buffers);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        memcpy(iv, bench_iv, sizeof(iv));
+        res = Cy_Cryptolite_Aes_Ctr(CRYPTOLITE, (uint32_t)len, &offset, iv,
+                                    dst, bench_src, &state);
+        (void)Cy_Cryptolite_Aes_Free(CRYPTOLITE, &state);
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: message_session
+********************************************************************************
+* Summary: One CTR message on the persistent session, as main.c does it now.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t message_session(uint8_t *dst, size_t len)
+{
+    cy_en_cryptolite_status_t res;
+    aes_ctr_ctx_t ctr;
+
+    res = aes_session_load(&bench_session, bench_key);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = aes_ctr_init(&ctr, &bench_session, bench_iv);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = aes_ctr_update(&ctr, dst, bench_src, len);
+    }
+    aes_ctr_final(&ctr);
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary: Monotonic time in nanoseconds.
+*
+*******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: time_message
+********************************************************************************
+* Summary: Returns the average time of one message in nanoseconds, or a
+*          negative value if a call failed.
+*
+*******************************************************************************/
+static double time_message(cy_en_cryptolite_status_t (*fn)(uint8_t *, size_t),
+                           size_t len)
+{
+    double start = now_ns();
+
+    for (uint32_t i = 0u; i < SESSION_BENCH_CALLS; i++)
+    {
+        if (fn(bench_dst, len) != CY_CRYPTOLITE_SUCCESS)
+        {
+            return -1.0;
+        }
+        /* Keep the calls from being merged or dropped */
+        __asm__ volatile("" : : "r"(bench_dst) : "memory");
+    }
+    return (now_ns() - start) / (double)SESSION_BENCH_CALLS;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Checks that both variants agree, then prints the best time per
+*          message. The 0-byte row is the setup cost alone.
+*
+*******************************************************************************/
+int main(void)
+{
+    size_t len;
+    double before_ns;
+    double after_ns;
+    double ns;
+
+    for (size_t i = 0u; i < sizeof(bench_src); i++)
+    {
+        bench_src[i] = (uint8_t)(i * 7u);
+    }
+
+    printf("%6s %14s %12s %10s %8s\n", "size", "init/free ns", "session ns",
+           "saved ns", "speedup");
+    for (size_t s = 0u; s < (sizeof(session_bench_sizes) / sizeof(session_bench_sizes[0])); s++)
+    {
+        len = session_bench_sizes[s];
+        if ((message_init_free(bench_ref, len) != CY_CRYPTOLITE_SUCCESS) ||
+            (message_session(bench_dst, len) != CY_CRYPTOLITE_SUCCESS) ||
+            (memcmp(bench_ref, bench_dst, len) != 0))
+        {
+            printf("mismatch at size %zu\n", len);
+            return 1;
+        }
+
+        before_ns = 0.0;
+        after_ns = 0.0;
+        for (uint32_t run = 0u; run < SESSION_BENCH_RUNS; run++)
+        {
+            ns = time_message(message_init_free, len);
+            before_ns = ((run == 0u) || (ns < before_ns)) ? ns : before_ns;
+            ns = time_message(message_session, len);
+            after_ns = ((run == 0u) || (ns < after_ns)) ? ns : after_ns;
+        }
+        if ((before_ns < 0.0) || (after_ns < 0.0))
+        {
+            printf("AES failed at size %zu\n", len);
+            return 1;
+        }
+        printf("%6zu %14.1f %12.1f %10.1f %7.2fx\n", len, before_ns, after_ns,
+               before_ns - after_ns, before_ns / after_ns);
+    }
+
+    (void)aes_session_unload(&bench_session);
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,310 @@
+/******************************************************************************
+* File Name: stream_bench.c
+*
+* Description: Host benchmark of AES-CTR and AES-CFB over 1, 16 and 64 KiB
+* messages, as one contiguous buffer and as scatter/gather lists whose segment
+* boundaries differ between source and destination. The scatter/gather output
+* must match the contiguous one and CFB must decrypt back to the plaintext.
+* Built and run by 'make bench'.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_ctr.h"
+#include "aes_cfb.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define STREAM_BENCH_MAX_SIZE                (64u * 1024u)
+
+/* Bytes processed per size and variant, so small sizes run many calls */
+#define STREAM_BENCH_TOTAL_BYTES             (1024u * 1024u)
+
+/* Runs per variant, interleaved; the fastest one is reported */
+#define STREAM_BENCH_RUNS                    (7u)
+
+/* Segments of the source and destination lists, and the length of their
+ * first segment, chosen so that no boundaries line up */
+#define STREAM_BENCH_SRC_SEGMENTS            (4u)
+#define STREAM_BENCH_SRC_FIRST               (13u)
+#define STREAM_BENCH_DST_SEGMENTS            (5u)
+#define STREAM_BENCH_DST_FIRST               (1000u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef enum
+{
+    STREAM_CTR,
+    STREAM_CFB_ENCRYPT,
+    STREAM_CFB_DECRYPT
+} stream_mode_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const size_t stream_bench_sizes[] =
+{
+    1024u, 16u * 1024u, 64u * 1024u
+};
+
+static const uint8_t bench_key[AES_SESSION_KEY_SIZE] =
+{
+    0xAAu, 0xBBu, 0xCCu, 0xDDu, 0xEEu, 0xFFu, 0xFFu, 0xEEu,
+    0xDDu, 0xCCu, 0xBBu, 0xAAu, 0xAAu, 0xBBu, 0xCCu, 0xDDu,
+};
+
+static const uint8_t bench_iv[AES_CTR_BLOCK_SIZE] =
+{
+    0x00u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u,
+    0x08u, 0x09u, 0x0Au, 0x0Bu, 0x0Cu, 0x0Du, 0x0Eu, 0x0Fu,
+};
+
+static aes_session_t bench_session;
+static uint8_t bench_src[STREAM_BENCH_MAX_SIZE];
+static uint8_t bench_dst[STREAM_BENCH_MAX_SIZE];
+static uint8_t bench_ref[STREAM_BENCH_MAX_SIZE];
+
+/*******************************************************************************
+* Function Name: split
+********************************************************************************
+* Summary: Describes buf as count segments: the first of first bytes, the
+*          rest of equal length with the remainder in the last one.
+*
+*******************************************************************************/
+static void split(sg_entry_t *entries, size_t count, uint8_t *buf,
+                  size_t len, size_t first)
+{
+    size_t each = (len - first) / (count - 1u);
+
+    entries[0].data = buf;
+    entries[0].len = first;
+    for (size_t i = 1u; i < count; i++)
+    {
+        entries[i].data = entries[i - 1u].data + entries[i - 1u].len;
+        entries[i].len = each;
+    }
+    /* The last segment also takes the remainder */
+    entries[count - 1u].len += (len - first) % (count - 1u);
+}
+
+/*******************************************************************************
+* Function Name: stream_run
+********************************************************************************
+* Summary: Processes len bytes of src into dst as one message, contiguously
+*          or through scatter/gather lists.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t stream_run(stream_mode_t mode, bool sg,
+                                            uint8_t *dst, uint8_t *src,
+                                            size_t len)
+{
+    cy_en_cryptolite_status_t res;
+    sg_entry_t src_entries[STREAM_BENCH_SRC_SEGMENTS];
+    sg_entry_t dst_entries[STREAM_BENCH_DST_SEGMENTS];
+    sg_list_t src_list = { src_entries, STREAM_BENCH_SRC_SEGMENTS };
+    sg_list_t dst_list = { dst_entries, STREAM_BENCH_DST_SEGMENTS };
+    aes_ctr_ctx_t ctr;
+    aes_cfb_ctx_t cfb;
+
+    if (sg)
+    {
+        split(src_entries, STREAM_BENCH_SRC_SEGMENTS, src, len,
+              STREAM_BENCH_SRC_FIRST);
+        split(dst_entries, STREAM_BENCH_DST_SEGMENTS, dst, len,
+              STREAM_BENCH_DST_FIRST);
+    }
+
+    if (mode == STREAM_CTR)
+    {
+        res = aes_ctr_init(&ctr, &bench_session, bench_iv);
+        if (res == CY_CRYPTOLITE_SUCCESS)
+        {
+            res = sg ? aes_ctr_update_sg(&ctr, &dst_list, &src_list)
+                     : aes_ctr_update(&ctr, dst, src, len);
+        }
+        aes_ctr_final(&ctr);
+    }
+    else
+    {
+        res = aes_cfb_init(&cfb, &bench_session,
+                           (mode == STREAM_CFB_ENCRYPT) ? CY_CRYPTOLITE_ENCRYPT
+                                                        : CY_CRYPTOLITE_DECRYPT,
+                           bench_iv);
+        if (res == CY_CRYPTOLITE_SUCCESS)
+        {
+            res = sg ? aes_cfb_update_sg(&cfb, &dst_list, &src_list)
+                     : aes_cfb_update(&cfb, dst, src, len);
+        }
+        aes_cfb_final(&cfb);
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: check_mode
+********************************************************************************
+* Summary: Returns true if the scatter/gather output equals the contiguous
+*          one for len bytes, and for CFB if decryption restores the input.
+*
+*******************************************************************************/
+static bool check_mode(stream_mode_t mode, size_t len)
+{
+    bool pass;
+
+    memset(bench_dst, 0, len);
+    pass = (stream_run(mode, false, bench_ref, bench_src, len) ==
+            CY_CRYPTOLITE_SUCCESS) &&
+           (stream_run(mode, true, bench_dst, bench_src, len) ==
+            CY_CRYPTOLITE_SUCCESS) &&
+           (memcmp(bench_ref, bench_dst, len) == 0);
+
+    if (pass && (mode == STREAM_CFB_ENCRYPT))
+    {
+        pass = (stream_run(STREAM_CFB_DECRYPT, true, bench_dst, bench_ref,
+                           len) == CY_CRYPTOLITE_SUCCESS) &&
+               (memcmp(bench_dst, bench_src, len) == 0);
+    }
+    return pass;
+}
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary: Monotonic time in nanoseconds.
+*
+*******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: time_run
+********************************************************************************
+* Summary: Returns the average time of one message of len bytes in
+*          nanoseconds, or a negative value if a call failed.
+*
+*******************************************************************************/
+static double time_run(stream_mode_t mode, bool sg, size_t len)
+{
+    size_t calls = STREAM_BENCH_TOTAL_BYTES / len;
+    double start = now_ns();
+
+    for (size_t i = 0u; i < calls; i++)
+    {
+        if (stream_run(mode, sg, bench_dst, bench_src, len) !=
+            CY_CRYPTOLITE_SUCCESS)
+        {
+            return -1.0;
+        }
+        /* Keep the calls from being merged or dropped */
+        __asm__ volatile("" : : "r"(bench_dst) : "memory");
+    }
+    return (now_ns() - start) / (double)calls;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Checks every mode and size, then prints the best time per message
+*          contiguously and through scatter/gather lists.
+*
+*******************************************************************************/
+int main(void)
+{
+    static char const *const mode_names[] = { "CTR", "CFB" };
+    size_t len;
+    double flat_ns;
+    double sg_ns;
+    double ns;
+
+    for (size_t i = 0u; i < sizeof(bench_src); i++)
+    {
+        bench_src[i] = (uint8_t)(i * 7u);
+    }
+    if (aes_session_load(&bench_session, bench_key) != CY_CRYPTOLITE_SUCCESS)
+    {
+        printf("key load failed\n");
+        return 1;
+    }
+
+    printf("%6s %5s %12s %12s %10s\n", "size", "mode", "contig us", "sg us",
+           "MB/s");
+    for (size_t s = 0u; s < (sizeof(stream_bench_sizes) / sizeof(stream_bench_sizes[0])); s++)
+    {
+        len = stream_bench_sizes[s];
+        for (stream_mode_t mode = STREAM_CTR; mode <= STREAM_CFB_ENCRYPT; mode++)
+        {
+            if (!check_mode(mode, len))
+            {
+                printf("%s mismatch at size %zu\n", mode_names[mode], len);
+                return 1;
+            }
+
+            flat_ns = 0.0;
+            sg_ns = 0.0;
+            for (uint32_t run = 0u; run < STREAM_BENCH_RUNS; run++)
+            {
+                ns = time_run(mode, false, len);
+                flat_ns = ((run == 0u) || (ns < flat_ns)) ? ns : flat_ns;
+                ns = time_run(mode, true, len);
+                sg_ns = ((run == 0u) || (ns < sg_ns)) ? ns : sg_ns;
+            }
+            if ((flat_ns < 0.0) || (sg_ns < 0.0))
+            {
+                printf("%s failed at size %zu\n", mode_names[mode], len);
+                return 1;
+            }
+            printf("%6zu %5s %12.1f %12.1f %10.1f\n", len, mode_names[mode],
+                   flat_ns / 1e3, sg_ns / 1e3, (double)len * 1e3 / flat_ns);
+        }
+    }
+
+    (void)aes_session_unload(&bench_session);
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,409 @@
+/******************************************************************************
+* File Name: tx_bench.c
+*
+* Description: Host latency test of the buffered UART transmitter. uart_tx.c
+* runs against a model of the UART that sends at the line rate in simulated
+* time and raises the TX-done interrupt when a transfer completes, while the
+* main loop runs a queue of commands, each spending a fixed crypto time and
+* printing its result with hex_dump(). The time to finish all commands is
+* compared with the blocking console output it replaced, where every character
+* holds the CPU for its time on the wire. The transmitted stream is checked
+* first. Built and run by 'make bench'.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "hex_dump.h"
+#include "uart_tx.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TX_BENCH_COMMANDS                    (200u)
+#define TX_BENCH_MAX_RESULT                  (255u)
+
+/* Largest transmitted stream: header and dump of the longest result per
+ * command */
+#define TX_BENCH_STREAM_SIZE                 (TX_BENCH_COMMANDS * 2048u)
+
+/* 8N1: ten bit times per character, in picoseconds at 1 baud */
+#define TX_BENCH_CHAR_PS_BAUD                (10000000000000ull)
+
+#define TX_BENCH_HEADER                      "\n\r[Command] : AES CTR Mode\r\n"
+
+/* print_data() line length */
+#define BYTES_PER_LINE                       (16u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef struct
+{
+    uint32_t baudrate;
+    /* Simulated crypto time of each command */
+    uint32_t work_us;
+    /* Bytes of result printed by each command */
+    uint32_t result_len;
+} tx_bench_scenario_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const tx_bench_scenario_t tx_bench_scenarios[] =
+{
+    /* Output fits the ring buffer and goes out while the next command runs */
+    {  921600u,  2000u,  16u },
+    { 3000000u,  2000u,  64u },
+    /* Output longer than the ring buffer: the writer waits for room */
+    {  921600u, 20000u, 255u },
+    /* Output slower than the crypto: the line rate bounds both paths */
+    {  115200u,  2000u,  16u },
+    { 3000000u,   500u,  64u },
+};
+
+static uint8_t bench_result[TX_BENCH_MAX_RESULT];
+
+static char expected[TX_BENCH_STREAM_SIZE];
+static size_t expected_len;
+static char wire[TX_BENCH_STREAM_SIZE];
+static size_t wire_len;
+
+/* UART model: a transfer started by cyhal_uart_write_async() completes at
+ * tx_done_ps. Simulated time is kept in whole picoseconds. */
+static cyhal_uart_t bench_uart;
+static uint64_t char_ps;
+static uint64_t sim_ps;
+static uint64_t tx_done_ps;
+static bool tx_active;
+static uint32_t irq_masked;
+
+/* Simulated time the main loop spent in __WFI() */
+static uint64_t blocked_ps;
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary: Monotonic time in nanoseconds.
+*
+*******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: tx_complete
+********************************************************************************
+* Summary: Ends the transfer in progress and raises the TX-done interrupt.
+*
+*******************************************************************************/
+static void tx_complete(void)
+{
+    sim_ps = tx_done_ps;
+    tx_active = false;
+    if ((bench_uart.callback != NULL) &&
+        ((bench_uart.enabled_events & (uint32_t)CYHAL_UART_IRQ_TX_DONE) != 0u))
+    {
+        bench_uart.callback(bench_uart.callback_arg, CYHAL_UART_IRQ_TX_DONE);
+    }
+}
+
+/*******************************************************************************
+* Function Name: advance
+********************************************************************************
+* Summary: Lets simulated time pass, completing transfers that end meanwhile
+*          as the interrupt would on the device.
+*
+*******************************************************************************/
+static void advance(uint64_t ps)
+{
+    uint64_t end = sim_ps + ps;
+
+    while (tx_active && (irq_masked == 0u) && (tx_done_ps <= end))
+    {
+        tx_complete();
+    }
+    sim_ps = end;
+}
+
+/*******************************************************************************
+* Function Name: uart_rx_event_handler
+********************************************************************************
+* Summary: The receiver shares the UART callback; nothing is received here.
+*
+*******************************************************************************/
+void uart_rx_event_handler(void *callback_arg, cyhal_uart_event_t event)
+{
+    (void)callback_arg;
+    (void)event;
+}
+
+/*******************************************************************************
+* Function Name: cyhal_uart_write_async / is_tx_active / register_callback /
+*                enable_event
+********************************************************************************
+* Summary: UART model used by uart_tx.c in place of cyhal_uart_host.c.
+*
+*******************************************************************************/
+cy_rslt_t cyhal_uart_write_async(cyhal_uart_t *obj, void *tx, size_t length)
+{
+    (void)obj;
+    if (tx_active)
+    {
+        return CYHAL_UART_RSLT_ERR_TX_BUSY;
+    }
+    if ((wire_len + length) <= sizeof(wire))
+    {
+        memcpy(&wire[wire_len], tx, length);
+    }
+    wire_len += length;
+    tx_done_ps = sim_ps + ((uint64_t)length * char_ps);
+    tx_active = true;
+    return CY_RSLT_SUCCESS;
+}
+
+bool cyhal_uart_is_tx_active(cyhal_uart_t *obj)
+{
+    (void)obj;
+    return tx_active;
+}
+
+void cyhal_uart_register_callback(cyhal_uart_t *obj,
+                                  cyhal_uart_event_callback_t callback,
+                                  void *callback_arg)
+{
+    obj->callback = callback;
+    obj->callback_arg = callback_arg;
+}
+
+void cyhal_uart_enable_event(cyhal_uart_t *obj, cyhal_uart_event_t event,
+                             uint8_t intr_priority, bool enable)
+{
+    (void)intr_priority;
+    if (enable)
+    {
+        obj->enabled_events |= (uint32_t)event;
+    }
+    else
+    {
+        obj->enabled_events &= ~(uint32_t)event;
+    }
+}
+
+/*******************************************************************************
+* Function Name: cyhal_system_critical_section_enter / _exit
+********************************************************************************
+* Summary: Masks the modelled interrupt.
+*
+*******************************************************************************/
+uint32_t cyhal_system_critical_section_enter(void)
+{
+    uint32_t old_state = irq_masked;
+
+    irq_masked = 1u;
+    return old_state;
+}
+
+void cyhal_system_critical_section_exit(uint32_t old_state)
+{
+    irq_masked = old_state;
+    advance(0u);
+}
+
+/*******************************************************************************
+* Function Name: Cy_Host_WaitForInterrupt
+********************************************************************************
+* Summary: __WFI(): sleeps in simulated time until the transfer in progress
+*          completes. As on the device the pending interrupt wakes the CPU
+*          while masked; the handler runs when the mask is lifted.
+*
+*******************************************************************************/
+void Cy_Host_WaitForInterrupt(void)
+{
+    if (tx_active && (tx_done_ps > sim_ps))
+    {
+        blocked_ps += tx_done_ps - sim_ps;
+        sim_ps = tx_done_ps;
+    }
+}
+
+/*******************************************************************************
+* Function Name: expect_result
+********************************************************************************
+* Summary: Appends to the expected stream what one command prints, using the
+*          snprintf() layout of the old print_data().
+*
+*******************************************************************************/
+static void expect_result(uint32_t result_len)
+{
+    expected_len += (size_t)snprintf(&expected[expected_len],
+                                     sizeof(expected) - expected_len,
+                                     "%s", TX_BENCH_HEADER);
+    for (uint32_t i = 0u; i < result_len; i++)
+    {
+        if ((i % BYTES_PER_LINE) == 0u)
+        {
+            expected_len += (size_t)snprintf(&expected[expected_len],
+                                             sizeof(expected) - expected_len,
+                                             "\r\n");
+        }
+        expected_len += (size_t)snprintf(&expected[expected_len],
+                                         sizeof(expected) - expected_len,
+                                         "0x%02X ", bench_result[i]);
+    }
+    expected_len += (size_t)snprintf(&expected[expected_len],
+                                     sizeof(expected) - expected_len, "\r\n");
+}
+
+/*******************************************************************************
+* Function Name: run_scenario
+********************************************************************************
+* Summary: Runs the command queue through the buffered transmitter and
+*          returns true if the stream on the wire is exactly what was printed,
+*          the commands finish no later than with blocking output, and output
+*          that can overlap the next command never holds up the main loop.
+*
+*******************************************************************************/
+static bool run_scenario(tx_bench_scenario_t const *scenario)
+{
+    uint64_t work_ps = (uint64_t)scenario->work_us * 1000000u;
+    uint64_t output_ps;
+    uint64_t blocking_ps;
+    uint64_t results_ps;
+    uart_tx_stats_t stats;
+    double host_ns = 0.0;
+    double start;
+    bool pass;
+
+    char_ps = TX_BENCH_CHAR_PS_BAUD / scenario->baudrate;
+    sim_ps = 0u;
+    tx_active = false;
+    irq_masked = 0u;
+    blocked_ps = 0u;
+    wire_len = 0u;
+    expected_len = 0u;
+    uart_tx_init(&bench_uart);
+
+    for (uint32_t cmd = 0u; cmd < TX_BENCH_COMMANDS; cmd++)
+    {
+        advance(work_ps);
+        start = now_ns();
+        uart_tx_puts(TX_BENCH_HEADER);
+        hex_dump(bench_result, scenario->result_len, HEX_DUMP_FORMAT_PREFIXED);
+        uart_tx_flush();
+        host_ns += now_ns() - start;
+        expect_result(scenario->result_len);
+    }
+    results_ps = sim_ps;
+
+    /* Drain the rest of the output */
+    while (tx_active)
+    {
+        uart_tx_flush();
+        advance(tx_done_ps - sim_ps);
+        uart_tx_flush();
+    }
+    uart_tx_get_stats(&stats);
+
+    /* Blocking output: every character holds the CPU for its time on the
+     * wire, so crypto and output never overlap */
+    output_ps = (uint64_t)(expected_len / TX_BENCH_COMMANDS) * char_ps;
+    blocking_ps = (uint64_t)TX_BENCH_COMMANDS * (work_ps + output_ps);
+
+    pass = (wire_len == expected_len) &&
+           (memcmp(wire, expected, expected_len) == 0) &&
+           (stats.written == expected_len) && (sim_ps <= blocking_ps);
+
+    /* Output that fits and is sent within one command's crypto time must
+     * never hold up the main loop */
+    if (((expected_len / TX_BENCH_COMMANDS) <= UART_TX_BUFFER_SIZE) &&
+        (output_ps <= work_ps))
+    {
+        pass = pass && (blocked_ps == 0u);
+    }
+
+    printf("%8u %8u %7u %7u %11.2f %11.2f %11.2f %11.2f %7u %8.1f %s\n",
+           (unsigned)scenario->baudrate, (unsigned)scenario->work_us,
+           (unsigned)scenario->result_len,
+           (unsigned)(expected_len / TX_BENCH_COMMANDS),
+           (double)(work_ps + output_ps) / 1e6,
+           (double)results_ps / 1e6 / (double)TX_BENCH_COMMANDS,
+           (double)blocked_ps / 1e6 / (double)TX_BENCH_COMMANDS,
+           (double)(blocking_ps - sim_ps) / 1e6 / (double)TX_BENCH_COMMANDS,
+           (unsigned)stats.stalls, host_ns / (double)expected_len,
+           pass ? "ok" : "FAILED");
+    return pass;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Runs every scenario and prints per command, in microseconds of
+*          simulated time: the cost with blocking output, the cost with the
+*          buffered transmitter, the part of it spent waiting for room in
+*          the ring buffer and the time saved overall. Also prints the number
+*          of waits and the host time of the output calls per byte.
+*
+*******************************************************************************/
+int main(void)
+{
+    bool pass = true;
+
+    for (uint32_t i = 0u; i < TX_BENCH_MAX_RESULT; i++)
+    {
+        bench_result[i] = (uint8_t)((i * 131u) + 7u);
+    }
+
+    printf("%8s %8s %7s %7s %11s %11s %11s %11s %7s %8s\n", "baud", "work us",
+           "result", "output", "blocking us", "buffered us", "waiting us",
+           "saved us", "stalls", "host ns/B");
+    for (size_t i = 0u; i < (sizeof(tx_bench_scenarios) / sizeof(tx_bench_scenarios[0])); i++)
+    {
+        pass &= run_scenario(&tx_bench_scenarios[i]);
+    }
+    return pass ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,173 @@
+/******************************************************************************
+* File Name: xor_bench.c
+*
+* Description: Host micro-benchmark of mem_xor() against the byte-wise loop it
+* replaced, for buffer sizes from 1 to 4096 bytes with aligned and misaligned
+* inputs. Built and run by 'make bench'.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "mem_xor.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define XOR_BENCH_MAX_SIZE                   (4096u)
+
+/* Bytes processed per size and variant, so small sizes run many calls */
+#define XOR_BENCH_TOTAL_BYTES                (64u * 1024u * 1024u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const size_t xor_bench_sizes[] =
+{
+    1u, 3u, 4u, 7u, 8u, 15u, 16u, 17u, 31u, 32u, 33u, 64u, 100u, 128u, 255u,
+    256u, 512u, 1000u, 1024u, 2048u, 4095u, 4096u
+};
+
+/* One spare byte so that inputs can start off a word boundary */
+static uint8_t bench_a[XOR_BENCH_MAX_SIZE + 1u];
+static uint8_t bench_b[XOR_BENCH_MAX_SIZE + 1u];
+static uint8_t bench_dst[XOR_BENCH_MAX_SIZE + 1u];
+static uint8_t bench_ref[XOR_BENCH_MAX_SIZE + 1u];
+
+/*******************************************************************************
+* Function Name: xor_bytes
+********************************************************************************
+* Summary: The byte-wise loop used before mem_xor(). Kept out of line so the
+*          compiler treats it like the call it replaces.
+*
+*******************************************************************************/
+static void __attribute__((noinline)) xor_bytes(uint8_t *dst,
+                                                uint8_t const *a,
+                                                uint8_t const *b, size_t len)
+{
+    for (size_t i = 0u; i < len; i++)
+    {
+        dst[i] = a[i] ^ b[i];
+    }
+}
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary: Monotonic time in nanoseconds.
+*
+*******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: time_xor
+********************************************************************************
+* Summary: Returns the average time of one call in nanoseconds.
+*
+*******************************************************************************/
+static double time_xor(void (*fn)(uint8_t *, uint8_t const *,
+                                  uint8_t const *, size_t),
+                       size_t offset, size_t len)
+{
+    size_t calls = XOR_BENCH_TOTAL_BYTES / len;
+    double start = now_ns();
+
+    for (size_t i = 0u; i < calls; i++)
+    {
+        fn(&bench_dst[offset], &bench_a[offset], &bench_b[0], len);
+        /* Keep the calls from being merged or dropped */
+        __asm__ volatile("" : : "r"(bench_dst) : "memory");
+    }
+    return (now_ns() - start) / (double)calls;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary: Checks mem_xor() against the byte loop for every size and offset,
+*          then prints the time per call and the speedup. "aligned" runs all
+*          buffers on the same alignment; "offset" moves dst and a one byte
+*          off b's.
+*
+*******************************************************************************/
+int main(void)
+{
+    size_t len;
+    double bytes_ns;
+    double kernel_ns;
+
+    for (size_t i = 0u; i < sizeof(bench_a); i++)
+    {
+        bench_a[i] = (uint8_t)(i * 7u);
+        bench_b[i] = (uint8_t)(i * 13u + 1u);
+    }
+
+    printf("%6s %8s %12s %12s %8s %10s\n", "size", "inputs", "bytes ns",
+           "mem_xor ns", "speedup", "GB/s");
+    for (size_t s = 0u; s < (sizeof(xor_bench_sizes) / sizeof(xor_bench_sizes[0])); s++)
+    {
+        len = xor_bench_sizes[s];
+        for (size_t offset = 0u; offset < 2u; offset++)
+        {
+            xor_bytes(&bench_ref[offset], &bench_a[offset], bench_b, len);
+            mem_xor(&bench_dst[offset], &bench_a[offset], bench_b, len);
+            if (memcmp(&bench_ref[offset], &bench_dst[offset], len) != 0)
+            {
+                printf("mismatch at size %zu offset %zu\n", len, offset);
+                return 1;
+            }
+
+            bytes_ns = time_xor(xor_bytes, offset, len);
+            kernel_ns = time_xor(mem_xor, offset, len);
+            printf("%6zu %8s %12.2f %12.2f %7.1fx %10.2f\n", len,
+                   (offset == 0u) ? "aligned" : "offset", bytes_ns, kernel_ns,
+                   bytes_ns / kernel_ns, (double)len / kernel_ns);
+        }
+    }
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -47,41 +47,122 @@
 #include "cybsp.h"
 #include "cy_retarget_io.h"
 #include "cy_pdl.h"
+#include "aes_session.h"
+#include "aes_ctr.h"
+#include "aes_ctr_cache.h"
+#include "aes_cfb.h"
+#include "aes_ccm.h"
+#include "aes_gcm.h"
+#include "aes_cmac.h"
+#include "aes_batch.h"
+#include "ble_sc.h"
+#include "cycle_count.h"
+#include "op_stats.h"
+#include "trace_ring.h"
+#include "entropy_pool.h"
+#include "ctr_drbg.h"
+#include "password_gen.h"
+#include "random_fill.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
+#include "hex_dump.h"
+#include "frame_protocol.h"
+#include "sha256_stream.h"
+#include "hmac_sha256.h"
 #include <string.h>
 
 /*******************************************************************************
 * Macros
 *******************************************************************************/
 /* The input message size (inclusive of the string terminating character '\0').
- * Edit this macro to suit your message size.
+ * Edit this macro to suit your message size; lengths are size_t throughout,
+ * so messages are not limited to 255 bytes.
  */
+#ifndef MAX_MESSAGE_SIZE
 #define MAX_MESSAGE_SIZE                     (100u)
-
-/* Size of the message block that can be processed by Cryptolite hardware for
- * AES encryption.
- */
-#define AES128_ENCRYPTION_LENGTH             (uint32_t)(16u)
+#endif
 
 #define AES128_KEY_LENGTH                    (uint32_t)(16u)
 
-/* Number of bytes per line to be printed on the UART terminal. */
-#define BYTES_PER_LINE                       (16u)
+/* 1: CTR and CFB transform the message buffer in place, so only one
+ *    MAX_MESSAGE_SIZE buffer is allocated.
+ * 0: ciphertext and decrypted text go to separate buffers.
+ * Both produce the same output.
+ */
+#ifndef MESSAGE_IN_PLACE
+#define MESSAGE_IN_PLACE                     (1u)
+#endif
 
-/* Time to wait to receive a character from UART terminal. */
-#define UART_INPUT_TIMEOUT_MS                (1u)
+/* Blocks of CTR keystream generated ahead while a CTR message is being
+ * typed, so that encryption and decryption reduce to an XOR. The default
+ * covers a whole message; 0 disables the cache.
+ */
+#ifndef CTR_KEYSTREAM_CACHE_BLOCKS
+#define CTR_KEYSTREAM_CACHE_BLOCKS           ((MAX_MESSAGE_SIZE + 15u) / 16u)
+#endif
+
+/* CTR_DRBG behind the DRBG frame: generate requests between reseeds from the
+ * entropy pool (0 selects CTR_DRBG_RESEED_INTERVAL), and whether every
+ * request reseeds first (prediction resistance, at the cost of 32 bytes of
+ * TRNG output per request).
+ */
+#ifndef DRBG_RESEED_INTERVAL
+#define DRBG_RESEED_INTERVAL                 (0u)
+#endif
+#ifndef DRBG_PREDICTION_RESISTANCE
+#define DRBG_PREDICTION_RESISTANCE           (0u)
+#endif
+
+/* Largest RNG_BENCH request */
+#define RNG_BENCH_MAX_BYTES                  (0x100000u)
+
+/* Format used by print_data(): HEX_DUMP_FORMAT_PREFIXED ("0xAA 0xBB ..."),
+ * HEX_DUMP_FORMAT_COMPACT ("AABB...") or HEX_DUMP_FORMAT_BASE64. Lines hold
+ * HEX_DUMP_BYTES_PER_LINE bytes for the hexadecimal formats.
+ */
+#define PRINT_DATA_FORMAT                    (HEX_DUMP_FORMAT_PREFIXED)
 
 /* Available commands */
 #define CRYPTOLITE_AES_CTR ('1')
 #define CRYPTOLITE_AES_CFB ('2')
 #define CRYPTOLITE_SHA_256 ('3')
 #define CRYPTOLITE_TRNG    ('4')
+#define CRYPTOLITE_AES_CCM ('5')
+#define CRYPTOLITE_OP_STATS ('6')
 
 #define CRYPTOLITE_MESSAGE_DIGEST_SIZE       (32u)
 
-#define ASCII_7BIT_MASK                 (0x7F)
-
+#define AES128_IV_LENGTH                     (16u)
+
+/* CCM parameters of the menu mode, as used by BLE link layer encryption
+ * apart from the longer tag. The nonce leaves 15 - AES_CCM_NONCE_LENGTH
+ * bytes for the message length, so it is shortened when MAX_MESSAGE_SIZE
+ * allows messages of 64 KiB or more. */
+#if (MAX_MESSAGE_SIZE <= 0x10000u)
+#define AES_CCM_NONCE_LENGTH                 (13u)
+#elif (MAX_MESSAGE_SIZE <= 0x1000000u)
+#define AES_CCM_NONCE_LENGTH                 (12u)
+#else
+#define AES_CCM_NONCE_LENGTH                 (11u)
+#endif
+#define AES_CCM_TAG_LENGTH                   (8u)
+
+/* In SHA-256 mode typed characters are absorbed into the digest a block at a
+ * time, so the message length is unlimited; only the last unabsorbed block
+ * can be edited with Backspace. */
+#define SHA256_ABSORB_SIZE                   (SHA256_STREAM_BLOCK_SIZE)
+
+#if (MAX_MESSAGE_SIZE <= SHA256_ABSORB_SIZE)
+#error "MAX_MESSAGE_SIZE must exceed one SHA-256 block"
+#endif
+
+/* Length and characters of the password generated by the TRNG menu entry */
+#ifndef PASSWORD_LENGTH
 #define PASSWORD_LENGTH                 (8u)
-#define ASCII_VISIBLE_CHARACTER_START   (33u)
+#endif
+#ifndef PASSWORD_ALPHABET
+#define PASSWORD_ALPHABET               PASSWORD_GEN_ALPHABET_PRINTABLE
+#endif
 
 /*******************************************************************************
 * Data type definitions
@@ -91,7 +172,8 @@ typedef enum
 {
     MESSAGE_ENTER_NEW,
     MESSAGE_READY,
-    MENU
+    MENU,
+    FRAME_MODE
 } message_status_t;
 
 
@@ -99,15 +181,30 @@ typedef enum
 * Global Variables
 *******************************************************************************/
 
-/* UART object used for reading character from terminal */
+/* UART object used for reading character from terminal. Received characters
+ * are buffered by the RX interrupt, see uart_rx.c. */
 extern cyhal_uart_t cy_retarget_io_uart_obj;
 
 
 /* Variables to hold the user message and the corresponding encrypted message */
 static uint8_t hash[CRYPTOLITE_MESSAGE_DIGEST_SIZE];
+
+/* Digest of the message being typed in SHA-256 mode */
+static sha256_stream_t menu_sha;
+
+/* Digest built by the SHA256_START/UPDATE/FINISH frame commands */
+static sha256_stream_t frame_sha;
+
+/* Key of the HMAC_SHA256 frame command, set by HMAC_SET_KEY */
+static hmac_sha256_t frame_hmac;
 static uint8_t message[MAX_MESSAGE_SIZE];
+#if (MESSAGE_IN_PLACE == 1u)
+#define encrypted_msg                        (message)
+#define decrypted_msg                        (message)
+#else
 static uint8_t encrypted_msg[MAX_MESSAGE_SIZE];
 static uint8_t decrypted_msg[MAX_MESSAGE_SIZE];
+#endif
 
 /* Key used for AES encryption*/
 static uint8_t aes_key[AES128_KEY_LENGTH] = {0xAA, 0xBB, 0xCC, 0xDD,
@@ -115,51 +212,247 @@ static uint8_t aes_key[AES128_KEY_LENGTH] = {0xAA, 0xBB, 0xCC, 0xDD,
                                             0xDD, 0xCC, 0xBB, 0xAA,
                                             0xAA, 0xBB, 0xCC, 0xDD,};
 
+/* AES key context, loaded once with aes_key and shared by all AES modes */
+static aes_session_t aes_session;
+
+/* GHASH tables for aes_session's key, used by the AES_GCM frame command */
+static aes_gcm_key_t gcm_key;
+
+/* CMAC subkeys for aes_session's key, used by the AES_CMAC frame command */
+static aes_cmac_key_t cmac_key;
+
+/* LE Secure Connections key contexts, used by the BLE_SC frame command */
+static ble_sc_t ble_sc;
+
+/* DRBG for nonces and IVs, seeded from the entropy pool */
+static ctr_drbg_t drbg;
+static const char drbg_personalization[] = "Cryptolite CTR_DRBG";
+
+/* Password generator drawing on the entropy pool */
+static password_gen_t password_gen;
+
+/* Descriptors of the AES_BATCH request being processed */
+static aes_batch_job_t frame_batch_jobs[FRAME_MAX_BATCH_JOBS];
 
 
 /******************************CTR Encryption**********************************/
-/* AES CTR MODE Initialization Vector*/
-static uint8_t AesCtrIV[] =
-{
-    0x00,0x01,0x02,0x03,
-    0x04,0x05,0x06,0x07,
-    0x08,0x09,0x0A,0x0B,
-    0x0C,0x0D,0x0E,0x0F,
-};
+/* AES CTR MODE Initialization Vector, random for every message */
+static uint8_t AesCtrIV[AES128_IV_LENGTH];
 
-static uint8_t AesCtrIV_copied[16];
+/* Keystream for AesCtrIV, filled while waiting for input */
+static aes_ctr_cache_t ctr_cache;
+#if (CTR_KEYSTREAM_CACHE_BLOCKS > 0u)
+static uint8_t ctr_keystream[CTR_KEYSTREAM_CACHE_BLOCKS * AES_CTR_BLOCK_SIZE];
+#else
+#define ctr_keystream                        (NULL)
+#endif
 
 /********************************CFB Encryption********************************/
-/* AES CFB MODE Initialization Vector */
-static uint8_t AesCfbIV[] =
-{
-    0x00,0x01,0x02,0x03,
-    0x04,0x05,0x06,0x07,
-    0x08,0x09,0x0A,0x0B,
-    0x0C,0x0D,0x0E,0x0F,
-};
+/* AES CFB MODE Initialization Vector, random for every message */
+static uint8_t AesCfbIV[AES128_IV_LENGTH];
 
-static uint8_t AesCfbIV_copied[16];
+/* CCM nonce, random for every message */
+static uint8_t AesCcmNonce[AES_CCM_NONCE_LENGTH];
+
+/* Associated data authenticated along with the menu message */
+static const uint8_t AesCcmAad[] = "Cryptolite";
 
 /******************************************************************************
  *Function Definitions
  ******************************************************************************/
 
-static void print_data(uint8_t* data, uint8_t len);
-static void encrypt_message_cfb(uint8_t* message, uint8_t size);
-static void decrypt_message_cfb(uint8_t* message, uint8_t size);
-static void encrypt_message_ctr(uint8_t* message, uint8_t size);
-static void decrypt_message_ctr(uint8_t* message, uint8_t size);
+static void print_data(uint8_t* data, size_t len);
+static void encrypt_message_cfb(uint8_t* dst, uint8_t const* src,
+                                size_t size);
+static void decrypt_message_cfb(uint8_t* dst, uint8_t const* src,
+                                size_t size);
+static void encrypt_message_ctr(uint8_t* dst, uint8_t const* src,
+                                size_t size);
+static void decrypt_message_ctr(uint8_t* dst, uint8_t const* src,
+                                size_t size);
+static void encrypt_message_ccm(uint8_t* dst, uint8_t const* src,
+                                size_t size, uint8_t* tag);
+static void decrypt_message_ccm(uint8_t* dst, uint8_t const* src,
+                                size_t size, uint8_t const* tag);
 static void enter_message(void);
 static void message_ready(void);
+static bool idle_step(void);
+static bool new_menu_iv(uint8_t *iv, size_t len);
+static void print_op_stats(void);
 
 void generate_password(void);
-uint8_t check_range(uint8_t value);
+
+/* Fields of an AES_CCM or AES_GCM request */
+typedef struct
+{
+    bool           decrypt;
+    size_t         tag_len;
+    uint8_t const *nonce;
+    size_t         nonce_len;
+    uint8_t const *aad;
+    size_t         aad_len;
+    uint8_t const *data;
+    size_t         data_len;
+    uint8_t const *tag;
+} frame_aead_t;
+
+static frame_status_t frame_parse_aead(frame_t const *request,
+                                       frame_aead_t *aead);
+static frame_status_t frame_aead_result(frame_aead_t const *aead,
+                                        cy_en_cryptolite_status_t res,
+                                        bool authentic,
+                                        uint16_t *response_len);
+static frame_status_t frame_ping(frame_t const *request, uint8_t *response,
+                                 uint16_t *response_len);
+static frame_status_t frame_aes_ctr(frame_t const *request, uint8_t *response,
+                                    uint16_t *response_len);
+static frame_status_t frame_aes_cfb(frame_t const *request, uint8_t *response,
+                                    uint16_t *response_len);
+static frame_status_t frame_sha256(frame_t const *request, uint8_t *response,
+                                   uint16_t *response_len);
+static frame_status_t frame_trng(frame_t const *request, uint8_t *response,
+                                 uint16_t *response_len);
+static frame_status_t frame_set_key(frame_t const *request, uint8_t *response,
+                                    uint16_t *response_len);
+static frame_status_t frame_aes_ccm(frame_t const *request, uint8_t *response,
+                                    uint16_t *response_len);
+static frame_status_t frame_aes_gcm(frame_t const *request, uint8_t *response,
+                                    uint16_t *response_len);
+static frame_status_t frame_sha256_start(frame_t const *request,
+                                         uint8_t *response,
+                                         uint16_t *response_len);
+static frame_status_t frame_sha256_update(frame_t const *request,
+                                          uint8_t *response,
+                                          uint16_t *response_len);
+static frame_status_t frame_sha256_finish(frame_t const *request,
+                                          uint8_t *response,
+                                          uint16_t *response_len);
+static frame_status_t frame_hmac_set_key(frame_t const *request,
+                                         uint8_t *response,
+                                         uint16_t *response_len);
+static frame_status_t frame_hmac_sha256(frame_t const *request,
+                                        uint8_t *response,
+                                        uint16_t *response_len);
+static frame_status_t frame_aes_cmac(frame_t const *request, uint8_t *response,
+                                     uint16_t *response_len);
+static frame_status_t frame_aes_batch(frame_t const *request,
+                                      uint8_t *response,
+                                      uint16_t *response_len);
+static frame_status_t frame_trng_stats(frame_t const *request,
+                                       uint8_t *response,
+                                       uint16_t *response_len);
+static frame_status_t frame_drbg(frame_t const *request, uint8_t *response,
+                                 uint16_t *response_len);
+static frame_status_t frame_rng_bench(frame_t const *request,
+                                      uint8_t *response,
+                                      uint16_t *response_len);
+static frame_status_t frame_password(frame_t const *request,
+                                     uint8_t *response,
+                                     uint16_t *response_len);
+static frame_status_t frame_op_stats(frame_t const *request,
+                                     uint8_t *response,
+                                     uint16_t *response_len);
+static frame_status_t frame_trace_dump(frame_t const *request,
+                                       uint8_t *response,
+                                       uint16_t *response_len);
+static frame_status_t frame_ble_sc(frame_t const *request, uint8_t *response,
+                                   uint16_t *response_len);
+
+/* Requests accepted in frame mode, see frame_protocol.h */
+static const frame_command_t frame_commands[] =
+{
+    { FRAME_CMD_PING,          frame_ping          },
+    { FRAME_CMD_AES_CTR,       frame_aes_ctr       },
+    { FRAME_CMD_AES_CFB,       frame_aes_cfb       },
+    { FRAME_CMD_SHA256,        frame_sha256        },
+    { FRAME_CMD_TRNG,          frame_trng          },
+    { FRAME_CMD_SET_KEY,       frame_set_key       },
+    { FRAME_CMD_SHA256_START,  frame_sha256_start  },
+    { FRAME_CMD_SHA256_UPDATE, frame_sha256_update },
+    { FRAME_CMD_SHA256_FINISH, frame_sha256_finish },
+    { FRAME_CMD_HMAC_SET_KEY,  frame_hmac_set_key  },
+    { FRAME_CMD_HMAC_SHA256,   frame_hmac_sha256   },
+    { FRAME_CMD_AES_CCM,       frame_aes_ccm       },
+    { FRAME_CMD_AES_GCM,       frame_aes_gcm       },
+    { FRAME_CMD_AES_CMAC,      frame_aes_cmac      },
+    { FRAME_CMD_AES_BATCH,     frame_aes_batch     },
+    { FRAME_CMD_TRNG_STATS,    frame_trng_stats    },
+    { FRAME_CMD_DRBG,          frame_drbg          },
+    { FRAME_CMD_RNG_BENCH,     frame_rng_bench     },
+    { FRAME_CMD_PASSWORD,      frame_password      },
+    { FRAME_CMD_OP_STATS,      frame_op_stats      },
+    { FRAME_CMD_TRACE_DUMP,    frame_trace_dump    },
+    { FRAME_CMD_BLE_SC,        frame_ble_sc        },
+};
 
 /* Variable to track the status of the message entered by the user */
 message_status_t msg_status = MENU;
-uint8_t msg_size = 0;
+size_t msg_size = 0;
 static uint8_t mode = 0;
+
+/*******************************************************************************
+* Function Name: idle_step
+********************************************************************************
+* Summary: Does one short piece of background work while waiting for input:
+*          CTR keystream for a message being typed, otherwise topping up the
+*          entropy pool.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if work was done, false if the caller may sleep
+*
+*******************************************************************************/
+static bool idle_step(void)
+{
+    if ((msg_status == MESSAGE_ENTER_NEW) && (mode == 1) &&
+        aes_ctr_cache_pending(&ctr_cache))
+    {
+        if (aes_ctr_cache_fill(&ctr_cache, 1u) != CY_CRYPTOLITE_SUCCESS)
+        {
+            CY_ASSERT(0);
+        }
+        return true;
+    }
+
+    return entropy_pool_idle();
+}
+
+/*******************************************************************************
+* Function Name: new_menu_iv
+********************************************************************************
+* Summary: Fills the IV or nonce for the next menu message with random bytes,
+*          so that no two messages are encrypted with the same one under the
+*          same key.
+*
+* Parameters:
+*  uint8_t* iv - IV or nonce to fill
+*  size_t len  - Its length
+*
+* Return:
+*  bool - false if the TRNG has failed its health tests
+*
+*******************************************************************************/
+static bool new_menu_iv(uint8_t *iv, size_t len)
+{
+    uint32_t start = op_stats_begin(OP_STATS_TRNG);
+    cy_en_cryptolite_status_t res = random_fill(iv, len);
+
+    op_stats_end(OP_STATS_TRNG, start);
+
+    if (res == CY_CRYPTOLITE_TRNG_UNHEALTHY)
+    {
+        uart_tx_puts("\r\nTRNG health test failed, no IV for a new "
+                     "message\r\n");
+        return false;
+    }
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    return true;
+}
 /*******************************************************************************
 * Function Name: enter_message()
 ********************************************************************************
@@ -175,12 +468,30 @@ static uint8_t mode = 0;
 
 static void enter_message(void)
 {
-    cy_rslt_t result;
-    result = cyhal_uart_getc(&cy_retarget_io_uart_obj,
-                             &message[msg_size],
-                             UART_INPUT_TIMEOUT_MS);
-    if (result == CY_RSLT_SUCCESS)
+    uint8_t const *rx_data;
+    uint32_t rx_count;
+    uint32_t used = 0;
+
+    rx_count = uart_rx_peek(&rx_data);
+    if (rx_count == 0u)
+    {
+        /* Use the wait for input for CTR keystream or entropy, a short
+         * step at a time so that typed characters are still picked up
+         * promptly. Sleep until the RX interrupt delivers more characters
+         * once there is nothing left to do. */
+        if (!idle_step())
+        {
+            uart_rx_wait();
+        }
+        return;
+    }
+
+    /* Handle everything received so far in one pass. Stop after ENTER so
+     * that characters typed ahead for the next command stay buffered. */
+    while ((used < rx_count) && (msg_status == MESSAGE_ENTER_NEW))
     {
+        message[msg_size] = rx_data[used++];
+
         /* Check if the ENTER Key is pressed. If pressed, set the
         message status as MESSAGE_READY.*/
         if (message[msg_size] == '\r' || message[msg_size] == '\n')
@@ -188,10 +499,13 @@ static void enter_message(void)
             message[msg_size]='\0';
             msg_status = MESSAGE_READY;
         }
+        else if ((mode == 3) && (message[msg_size] == '\b') && (msg_size == 0u))
+        {
+            /* Earlier characters are already absorbed into the digest */
+        }
         else
         {
-            cyhal_uart_putc(&cy_retarget_io_uart_obj,
-                            message[msg_size]);
+            uart_tx_putc((char)message[msg_size]);
 
             /* Check if Backspace is pressed by the user. */
             if(message[msg_size] != '\b')
@@ -205,11 +519,24 @@ static void enter_message(void)
                     msg_size--;
                 }
             }
+            /* Hash a full block as soon as it is typed */
+            if ((mode == 3) && (msg_size == SHA256_ABSORB_SIZE))
+            {
+                uint32_t start = op_stats_begin(OP_STATS_SHA256);
+
+                if (sha256_stream_update(&menu_sha, message, msg_size) !=
+                    CY_CRYPTOLITE_SUCCESS)
+                {
+                    CY_ASSERT(0);
+                }
+                op_stats_end(OP_STATS_SHA256, start);
+                msg_size = 0;
+            }
             /*Check if size of the message  exceeds MAX_MESSAGE_SIZE
             (inclusive of the string terminating character '\0').*/
             if (msg_size > (MAX_MESSAGE_SIZE - 1))
             {
-                printf("\r\n\nMessage length exceeds %d characters!!!"\
+                uart_tx_printf("\r\n\nMessage length exceeds %d characters!!!"\
                     " Please enter a shorter message\r\nor edit the macro "\
                     "MAX_MESSAGE_SIZE to suit your message size\r\n", MAX_MESSAGE_SIZE);
 
@@ -218,47 +545,93 @@ static void enter_message(void)
                 msg_status = MESSAGE_ENTER_NEW;
                 memset(message, 0, MAX_MESSAGE_SIZE);
                 msg_size = 0;
-                printf("\r\nEnter the message when more than limit:\r\n");
+                uart_tx_puts("\r\nEnter the message when more than limit:\r\n");
             }
          }
     }
+    uart_rx_consume(used);
 }
 
 static void message_menu()
 {
         uint8_t dst_cmd;
-        printf("\n\n\r Choose one of the following Cryptolite Mode :\r\n");
-        printf("\n\r (1) CTR (Counter) mode\r\n");
-        printf("\n\r (2) CFB (Cipher Feedback Block) mode\r\n");
-        printf("\n\r (3) SHA 256\r\n");
-        printf("\n\r (4) TRNG\r\n");
-        while(cyhal_uart_getc(&cy_retarget_io_uart_obj, &dst_cmd, 1)!= CY_RSLT_SUCCESS);
-        cyhal_uart_putc(&cy_retarget_io_uart_obj, dst_cmd);
+        uart_tx_puts("\n\n\r Choose one of the following Cryptolite Mode :\r\n");
+        uart_tx_puts("\n\r (1) CTR (Counter) mode\r\n");
+        uart_tx_puts("\n\r (2) CFB (Cipher Feedback Block) mode\r\n");
+        uart_tx_puts("\n\r (3) SHA 256\r\n");
+        uart_tx_puts("\n\r (4) TRNG\r\n");
+        uart_tx_puts("\n\r (5) CCM (Counter with CBC-MAC) mode\r\n");
+        uart_tx_puts("\n\r (6) Operation timing statistics\r\n");
+        uart_tx_flush();
+        while(uart_rx_read(&dst_cmd, 1u) == 0u)
+        {
+            if (!idle_step())
+            {
+                uart_rx_wait();
+            }
+        }
+        /* A start-of-frame byte switches to the binary frame protocol */
+        if (FRAME_SOF == dst_cmd)
+        {
+            frame_protocol_start();
+            msg_status = FRAME_MODE;
+            return;
+        }
+        uart_tx_putc((char)dst_cmd);
                 if (CRYPTOLITE_AES_CTR == dst_cmd)
                 {
                    mode = 1;
-                   msg_status = MESSAGE_ENTER_NEW;
-                  printf("\n\rEnter the message:\r\n");
+                   /* The keystream cache starts over for the new IV */
+                   if (new_menu_iv(AesCtrIV, sizeof(AesCtrIV)))
+                   {
+                       if (aes_ctr_cache_prepare(&ctr_cache, &aes_session,
+                                                 AesCtrIV) != CY_CRYPTOLITE_SUCCESS)
+                       {
+                           CY_ASSERT(0);
+                       }
+                       msg_status = MESSAGE_ENTER_NEW;
+                       uart_tx_puts("\n\rEnter the message:\r\n");
+                   }
                 }
                 else if (CRYPTOLITE_AES_CFB == dst_cmd)
                 {
                    mode = 2;
-                   msg_status = MESSAGE_ENTER_NEW;
-                   printf("\n\rEnter the message:\r\n");
+                   if (new_menu_iv(AesCfbIV, sizeof(AesCfbIV)))
+                   {
+                       msg_status = MESSAGE_ENTER_NEW;
+                       uart_tx_puts("\n\rEnter the message:\r\n");
+                   }
                 }
                 else if (CRYPTOLITE_SHA_256 == dst_cmd)
                 {
                    mode = 3;
+                   if (sha256_stream_start(&menu_sha) != CY_CRYPTOLITE_SUCCESS)
+                   {
+                       CY_ASSERT(0);
+                   }
                    msg_status = MESSAGE_ENTER_NEW;
-                   printf("\n\rEnter the message:\r\n");
+                   uart_tx_puts("\n\rEnter the message:\r\n");
                 }
                 else if(CRYPTOLITE_TRNG == dst_cmd)
                 {
                     generate_password();
                 }
+                else if (CRYPTOLITE_AES_CCM == dst_cmd)
+                {
+                   mode = 5;
+                   if (new_menu_iv(AesCcmNonce, sizeof(AesCcmNonce)))
+                   {
+                       msg_status = MESSAGE_ENTER_NEW;
+                       uart_tx_puts("\n\rEnter the message:\r\n");
+                   }
+                }
+                else if (CRYPTOLITE_OP_STATS == dst_cmd)
+                {
+                    print_op_stats();
+                }
                 else
                 {
-                    printf("\r\nChoose the number between 1 to 4 \r\n");
+                    uart_tx_puts("\r\nChoose the number between 1 to 6 \r\n");
                 }
                 
 }
@@ -277,30 +650,49 @@ static void message_menu()
 static void message_ready(void)
 {
         cy_en_cryptolite_status_t cryptolite_status = CY_CRYPTOLITE_SUCCESS;
-        cy_stc_cryptolite_context_sha256_t cfContext;
         if (mode == 1)
         {
-            printf("\n\r[Command] : AES CTR Mode\r\n");
-            encrypt_message_ctr(message, msg_size);
-            decrypt_message_ctr(message, msg_size);
+            uart_tx_puts("\n\r[Command] : AES CTR Mode\r\n");
+            uart_tx_puts("\r\nIV:\r\n");
+            print_data(AesCtrIV, sizeof(AesCtrIV));
+            encrypt_message_ctr(encrypted_msg, message, msg_size);
+            decrypt_message_ctr(decrypted_msg, encrypted_msg, msg_size);
         }
         else if (mode == 2)
         {
-            printf("\n\r[Command] : AES CFB Mode\r\n");
-            encrypt_message_cfb(message, msg_size);
-            decrypt_message_cfb(message, msg_size);
+            uart_tx_puts("\n\r[Command] : AES CFB Mode\r\n");
+            uart_tx_puts("\r\nIV:\r\n");
+            print_data(AesCfbIV, sizeof(AesCfbIV));
+            encrypt_message_cfb(encrypted_msg, message, msg_size);
+            decrypt_message_cfb(decrypted_msg, encrypted_msg, msg_size);
+        }
+        else if (mode == 5)
+        {
+            uint8_t tag[AES_CCM_TAG_LENGTH];
+
+            uart_tx_puts("\n\r[Command] : AES CCM Mode\r\n");
+            uart_tx_puts("\r\nNonce:\r\n");
+            print_data(AesCcmNonce, sizeof(AesCcmNonce));
+            encrypt_message_ccm(encrypted_msg, message, msg_size, tag);
+            decrypt_message_ccm(decrypted_msg, encrypted_msg, msg_size, tag);
         }
         else if (mode == 3)
         {
-            cryptolite_status = Cy_Cryptolite_Sha256_Run(CRYPTOLITE,
-                                                         message,
-                                                         msg_size,
-                                                         hash,
-                                                         &cfContext);
+            uint32_t start = op_stats_begin(OP_STATS_SHA256);
+
+            /* Only the characters typed since the last full block are
+             * left to absorb */
+            cryptolite_status = sha256_stream_update(&menu_sha, message,
+                                                     msg_size);
+            if(cryptolite_status == CY_CRYPTOLITE_SUCCESS)
+            {
+                cryptolite_status = sha256_stream_finish(&menu_sha, hash);
+            }
+            op_stats_end(OP_STATS_SHA256, start);
 
             if(cryptolite_status == CY_CRYPTOLITE_SUCCESS)
             {
-            printf("\r\n\nHash Value for the message:\r\n\n");
+            uart_tx_puts("\r\n\nHash Value for the message:\r\n\n");
             print_data(hash,CRYPTOLITE_MESSAGE_DIGEST_SIZE);
             }
             else
@@ -315,7 +707,7 @@ static void message_ready(void)
         msg_status = MENU;
         memset(message, 0, MAX_MESSAGE_SIZE);
         msg_size = 0;
-        printf("\n\n\rChoose the option from the Menu:\r\n");
+        uart_tx_puts("\n\n\rChoose the option from the Menu:\r\n");
 }
 /*******************************************************************************
 * Function Name: main
@@ -334,6 +726,8 @@ static void message_ready(void)
 int main(void)
 {
     cy_rslt_t result;
+    cy_stc_cryptolite_trng_config_t trng_config;
+    message_status_t traced_status = msg_status;
 
     /* Initialize the device and board peripherals */
     result = cybsp_init();
@@ -346,6 +740,32 @@ int main(void)
     /* Enable global interrupts */
     __enable_irq();
 
+    /* Start the cycle counter used to time batched AES jobs */
+    cycle_count_init();
+
+    aes_ctr_cache_init(&ctr_cache, ctr_keystream, CTR_KEYSTREAM_CACHE_BLOCKS);
+
+    /* Keep the TRNG running and its output pooled for TRNG requests */
+    if (entropy_pool_init(&trng_config) != CY_CRYPTOLITE_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    frame_protocol_set_idle_handler(idle_step);
+    password_gen_init(&password_gen, entropy_pool_read);
+
+    /* Check the DRBG against its known answer before seeding it for use */
+    if (!ctr_drbg_self_test())
+    {
+        CY_ASSERT(0);
+    }
+    /* If the TRNG fails its health tests the DRBG stays unseeded and DRBG
+     * requests report an error */
+    (void)ctr_drbg_instantiate(&drbg, entropy_pool_read,
+                               (uint8_t const *)drbg_personalization,
+                               sizeof(drbg_personalization) - 1u,
+                               DRBG_RESEED_INTERVAL,
+                               DRBG_PREDICTION_RESISTANCE != 0u);
+
     /* Initialize retarget-io to use the debug UART port */
     result = cy_retarget_io_init_fc(    CYBSP_DEBUG_UART_TX,
                                         CYBSP_DEBUG_UART_RX,
@@ -357,9 +777,33 @@ int main(void)
     {
         CY_ASSERT(0);
     }
-    printf("\r\n\n*****************Cryptolite Code Example*****************\r\n");
-    printf("\r\n\nKey used for Encryption:\r\n");
+
+    /* Receive characters by interrupt instead of polling the UART, and
+     * send all output through the interrupt-driven transmit buffer */
+    uart_rx_init(&cy_retarget_io_uart_obj);
+    uart_tx_init(&cy_retarget_io_uart_obj);
+
+    uart_tx_puts("\r\n\n*****************Cryptolite Code Example*****************\r\n");
+    frame_protocol_init(frame_commands,
+                        sizeof(frame_commands) / sizeof(frame_commands[0]));
+
+    /* Load the AES key once; every CTR/CFB operation reuses this context */
+    if (aes_session_load(&aes_session, aes_key) != CY_CRYPTOLITE_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    /* Later key changes are picked up by aes_gcm_encrypt/decrypt() and
+     * aes_cmac_start() */
+    if ((aes_gcm_setup(&gcm_key, &aes_session) != CY_CRYPTOLITE_SUCCESS) ||
+        (aes_cmac_setup(&cmac_key, &aes_session) != CY_CRYPTOLITE_SUCCESS) ||
+        (ble_sc_init(&ble_sc) != CY_CRYPTOLITE_SUCCESS))
+    {
+        CY_ASSERT(0);
+    }
+
+    uart_tx_puts("\r\n\nKey used for Encryption:\r\n");
     print_data(aes_key, AES128_KEY_LENGTH);
+    trace_ring_record(TRACE_EVENT_STATE, (uint8_t)msg_status, mode);
     for (;;)
     {
         switch (msg_status)
@@ -380,7 +824,28 @@ int main(void)
                     message_menu();
                     break;
                 }
+                case FRAME_MODE:
+                {
+                    if (!frame_protocol_poll())
+                    {
+                        msg_status = MENU;
+                    }
+                    break;
+                }
+            }
+
+            /* The time spent in each state is traced for
+             * tools/trace_decode.py */
+            if (msg_status != traced_status)
+            {
+                trace_ring_record(TRACE_EVENT_STATE, (uint8_t)msg_status,
+                                  mode);
+                traced_status = msg_status;
             }
+
+            /* Flush point: start sending this step's output. Transmission
+             * continues by interrupt while the next step runs. */
+            uart_tx_flush();
         }
 
 }
@@ -388,30 +853,23 @@ int main(void)
 /*******************************************************************************
 * Function Name: print_data()
 ********************************************************************************
-* Summary: Function used to display the data in hexadecimal format
+* Summary: Function used to display the data in the PRINT_DATA_FORMAT format
 *
 * Parameters:
 *  uint8_t* data - Pointer to location of data to be printed
-*  uint8_t  len  - length of data to be printed
+*  size_t   len  - length of data to be printed
 *
 * Return:
 *  void
 *
 *******************************************************************************/
 
-static void print_data(uint8_t* data, uint8_t len)
+static void print_data(uint8_t* data, size_t len)
 {
-    char print[10];
-    for (uint32 i=0; i < len; i++)
-    {
-        if ((i % BYTES_PER_LINE) == 0)
-        {
-            printf("\r\n");
-        }
-        snprintf(print,10,"0x%02X ", *(data+i));
-        printf("%s", print);
-    }
-    printf("\r\n");
+    uint32_t start = op_stats_begin(OP_STATS_UART_PRINT);
+
+    hex_dump(data, len, PRINT_DATA_FORMAT);
+    op_stats_end(OP_STATS_UART_PRINT, start);
 }
 
 /*******************************************************************************
@@ -420,59 +878,37 @@ static void print_data(uint8_t* data, uint8_t len)
 * Summary: Function used to encrypt the message through cfb mode.
 *
 * Parameters:
-*  char * message - pointer to the message to be encrypted
-*  uint8_t size   - size of message to be encrypted.
+*  uint8_t* dst       - ciphertext buffer, may equal src
+*  uint8_t const* src - message to be encrypted
+*  size_t size        - size of message to be encrypted.
 *
 * Return:
 *  void
 *
 *******************************************************************************/
 
-static void encrypt_message_cfb(uint8_t* message, uint8_t size)
+static void encrypt_message_cfb(uint8_t* dst, uint8_t const* src,
+                                size_t size)
 {
-    cy_stc_cryptolite_aes_state_t aes_state;
-    cy_stc_cryptolite_aes_buffers_t aesBuffers;
-    uint8_t aes_block_count = 0;
+    aes_cfb_ctx_t cfb_ctx;
     cy_en_cryptolite_status_t res;
-    void* result;
+    uint32_t start = op_stats_begin(OP_STATS_AES_CFB);
 
-    aes_block_count =  (size % AES128_ENCRYPTION_LENGTH == 0) ?
-                       (size / AES128_ENCRYPTION_LENGTH)
-                       : (1 + size / AES128_ENCRYPTION_LENGTH);
-
-    /* Initializes the AES operation by setting key and key length */
-    res = Cy_Cryptolite_Aes_Init(CRYPTOLITE, aes_key, &aes_state, &aesBuffers);
-    if(res!=CY_CRYPTOLITE_SUCCESS)
-    {
-        CY_ASSERT(0);
-    }
-
-    result = memcpy(AesCfbIV_copied, AesCfbIV, sizeof(AesCfbIV));
-    if(result == NULL)
-    {
-        perror("Memory failed\r\n");
-    }
-
-    res = Cy_Cryptolite_Aes_Cfb(  CRYPTOLITE,
-                            CY_CRYPTOLITE_ENCRYPT,
-                            aes_block_count * AES128_ENCRYPTION_LENGTH,
-                            AesCfbIV_copied,
-                            encrypted_msg,
-                            message,
-                            &aes_state);
-
-    if(res!=CY_CRYPTOLITE_SUCCESS)
+    /* Partial blocks are carried by the context: no padding is needed and
+     * nothing past the end of the message is read. */
+    res = aes_cfb_init(&cfb_ctx, &aes_session, CY_CRYPTOLITE_ENCRYPT, AesCfbIV);
+    if(res == CY_CRYPTOLITE_SUCCESS)
     {
-        CY_ASSERT(0);
+        res = aes_cfb_update(&cfb_ctx, dst, src, size);
     }
-    res = Cy_Cryptolite_Aes_Free(CRYPTOLITE,&aes_state);
+    aes_cfb_final(&cfb_ctx);
+    op_stats_end(OP_STATS_AES_CFB, start);
     if(res!=CY_CRYPTOLITE_SUCCESS)
     {
         CY_ASSERT(0);
     }
-    printf("\r\nResult of Encryption:\r\n");
-    print_data((uint8_t*) encrypted_msg,
-                aes_block_count * AES128_ENCRYPTION_LENGTH );
+    uart_tx_puts("\r\nResult of Encryption:\r\n");
+    print_data(dst, size);
 
 }
 
@@ -482,58 +918,38 @@ static void encrypt_message_cfb(uint8_t* message, uint8_t size)
 * Summary: Function used to decrypt the message for cfb mode.
 *
 * Parameters:
-*  char * message - pointer to the message to be decrypted
-*  uint8_t size   - size of message to be decrypted.
+*  uint8_t* dst       - plaintext buffer, may equal src
+*  uint8_t const* src - ciphertext to be decrypted
+*  size_t size        - size of message to be decrypted.
 *
 * Return:
 *  void
 *
 *******************************************************************************/
 
-static void decrypt_message_cfb(uint8_t* message, uint8_t size)
+static void decrypt_message_cfb(uint8_t* dst, uint8_t const* src,
+                                size_t size)
 {
-    cy_stc_cryptolite_aes_state_t aes_state;
-    cy_stc_cryptolite_aes_buffers_t aesBuffers;
-    uint8_t aes_block_count = 0;
+    aes_cfb_ctx_t cfb_ctx;
     cy_en_cryptolite_status_t res;
-    void* result;
+    uint32_t start = op_stats_begin(OP_STATS_AES_CFB);
 
-    aes_block_count =  (size % AES128_ENCRYPTION_LENGTH == 0) ?
-                       (size / AES128_ENCRYPTION_LENGTH)
-                       : (1 + size / AES128_ENCRYPTION_LENGTH);
-
-    /* Initializes the AES operation by setting key and key length */
-    res = Cy_Cryptolite_Aes_Init(CRYPTOLITE, aes_key, &aes_state, &aesBuffers);
+    /* Start decryption operation*/
+    res = aes_cfb_init(&cfb_ctx, &aes_session, CY_CRYPTOLITE_DECRYPT, AesCfbIV);
+    if(res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = aes_cfb_update(&cfb_ctx, dst, src, size);
+    }
+    aes_cfb_final(&cfb_ctx);
+    op_stats_end(OP_STATS_AES_CFB, start);
     if(res!=CY_CRYPTOLITE_SUCCESS)
     {
         CY_ASSERT(0);
     }
-    /* Start decryption operation*/
-    result = memcpy(AesCfbIV_copied, AesCfbIV, sizeof(AesCfbIV));
-    if(result == NULL)
-    {
-       perror("Memory failed\r\n");
-    }
-    res = Cy_Cryptolite_Aes_Cfb(CRYPTOLITE,
-                            CY_CRYPTOLITE_DECRYPT,
-                            aes_block_count * AES128_ENCRYPTION_LENGTH,
-                            AesCfbIV_copied,
-                            decrypted_msg,
-                            encrypted_msg,
-                            &aes_state);
-    if(res!=CY_CRYPTOLITE_SUCCESS)
-        {
-            CY_ASSERT(0);
-        }
-    res = Cy_Cryptolite_Aes_Free(CRYPTOLITE,&aes_state);
-    if(res!=CY_CRYPTOLITE_SUCCESS)
-        {
-            CY_ASSERT(0);
-        }
-    decrypted_msg[size]='\0';
+    dst[size]='\0';
     /* Print the decrypted message on the UART terminal */
-    printf("\r\nResult of Decryption:\r\n\n");
-    printf("%s", decrypted_msg);
+    uart_tx_puts("\r\nResult of Decryption:\r\n\n");
+    uart_tx_write(dst, size);
 
 }
 
@@ -543,58 +959,32 @@ static void decrypt_message_cfb(uint8_t* message, uint8_t size)
 * Summary: Function used to encrypt the message through ctr mode.
 *
 * Parameters:
-*  char * message - pointer to the message to be encrypted
-*  uint8_t size   - size of message to be encrypted.
+*  uint8_t* dst       - ciphertext buffer, may equal src
+*  uint8_t const* src - message to be encrypted
+*  size_t size        - size of message to be encrypted.
 *
 * Return:
 *  void
 *
 *******************************************************************************/
 
-static void encrypt_message_ctr(uint8_t* message, uint8_t size)
+static void encrypt_message_ctr(uint8_t* dst, uint8_t const* src,
+                                size_t size)
 {
-    uint32_t srcOffset;
-    cy_stc_cryptolite_aes_state_t aes_state;
-    cy_stc_cryptolite_aes_buffers_t aesBuffers;
-    uint8_t aes_block_count = 0;
     cy_en_cryptolite_status_t res;
-    void* result;
-
-    aes_block_count =  (size % AES128_ENCRYPTION_LENGTH == 0) ?
-                       (size / AES128_ENCRYPTION_LENGTH)
-                       : (1 + size / AES128_ENCRYPTION_LENGTH);
-    /* Initializes the AES operation by setting key and key length */
-     res = Cy_Cryptolite_Aes_Init(CRYPTOLITE, aes_key, &aes_state, &aesBuffers);
-     if(res!=CY_CRYPTOLITE_SUCCESS)
-     {
-       CY_ASSERT(0);
-     }
-
-     srcOffset = 0;
-     result = memcpy(AesCtrIV_copied, AesCtrIV, sizeof(AesCtrIV));
-     if(result == NULL)
-     {
-       perror("Memory failed\r\n");
-     }
-     res = Cy_Cryptolite_Aes_Ctr( CRYPTOLITE,
-                            aes_block_count * AES128_ENCRYPTION_LENGTH,
-                            &srcOffset,
-                            AesCtrIV_copied,
-                            encrypted_msg,
-                            message,
-                            &aes_state);
-     if(res!=CY_CRYPTOLITE_SUCCESS)
-     {
-       CY_ASSERT(0);
-     }
-     res = Cy_Cryptolite_Aes_Free(CRYPTOLITE,&aes_state);
-     if(res!=CY_CRYPTOLITE_SUCCESS)
-     {
-       CY_ASSERT(0);
-     }
-     printf("\r\nResult of Encryption:\r\n");
-     print_data((uint8_t*) encrypted_msg,
-                aes_block_count * AES128_ENCRYPTION_LENGTH );
+    uint32_t start = op_stats_begin(OP_STATS_AES_CTR);
+
+    /* CTR is a stream mode: exactly size bytes are read and produced. The
+     * keystream generated while the message was typed is used first. */
+    res = aes_ctr_cache_crypt(&ctr_cache, &aes_session, AesCtrIV, dst, src,
+                              size);
+    op_stats_end(OP_STATS_AES_CTR, start);
+    if(res!=CY_CRYPTOLITE_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    uart_tx_puts("\r\nResult of Encryption:\r\n");
+    print_data(dst, size);
 
 }
 
@@ -604,66 +994,130 @@ static void encrypt_message_ctr(uint8_t* message, uint8_t size)
 * Summary: Function used to decrypt the message for ctr mode.
 *
 * Parameters:
-*  char * message - pointer to the message to be decrypted
-*  uint8_t size   - size of message to be decrypted.
+*  uint8_t* dst       - plaintext buffer, may equal src
+*  uint8_t const* src - ciphertext to be decrypted
+*  size_t size        - size of message to be decrypted.
 *
 * Return:
 *  void
 *
 *******************************************************************************/
 
-static void decrypt_message_ctr(uint8_t* message, uint8_t size)
+static void decrypt_message_ctr(uint8_t* dst, uint8_t const* src,
+                                size_t size)
 {
-    uint32_t srcOffset;
-    cy_stc_cryptolite_aes_state_t aes_state;
-    cy_stc_cryptolite_aes_buffers_t aesBuffers;
-    uint8_t aes_block_count = 0;
     cy_en_cryptolite_status_t res;
-    void* result;
-    aes_block_count =  (size % AES128_ENCRYPTION_LENGTH == 0) ?
-                       (size / AES128_ENCRYPTION_LENGTH)
-                       : (1 + size / AES128_ENCRYPTION_LENGTH);
+    uint32_t start = op_stats_begin(OP_STATS_AES_CTR);
 
-    /* Initializes the AES operation by setting key and key length */
-    res = Cy_Cryptolite_Aes_Init(CRYPTOLITE, aes_key, &aes_state, &aesBuffers);
+    /* Start decryption operation*/
+    res = aes_ctr_cache_crypt(&ctr_cache, &aes_session, AesCtrIV, dst, src,
+                              size);
+    op_stats_end(OP_STATS_AES_CTR, start);
     if(res!=CY_CRYPTOLITE_SUCCESS)
     {
         CY_ASSERT(0);
     }
-    srcOffset = 0;
-    /* Start decryption operation*/
-    result = memcpy(AesCtrIV_copied, AesCtrIV, sizeof(AesCtrIV));
-    if(result == NULL)
-    {
-        perror("Memory failed\r\n");
-    }
-    res = Cy_Cryptolite_Aes_Ctr(  CRYPTOLITE,
-                            aes_block_count * AES128_ENCRYPTION_LENGTH,
-                            &srcOffset,
-                            AesCtrIV_copied,
-                            decrypted_msg,
-                            encrypted_msg,
-                            &aes_state);
-    if(res!=CY_CRYPTOLITE_SUCCESS)
+    dst[size]='\0';
+    /* Print the decrypted message on the UART terminal */
+    uart_tx_puts("\r\nResult of Decryption:\r\n\n");
+    uart_tx_write(dst, size);
+
+}
+
+/*******************************************************************************
+* Function Name: encrypt_message_ccm
+********************************************************************************
+* Summary: Function used to encrypt and authenticate the message through ccm
+*          mode.
+*
+* Parameters:
+*  uint8_t* dst       - ciphertext buffer, may equal src
+*  uint8_t const* src - message to be encrypted
+*  size_t size        - size of message to be encrypted.
+*  uint8_t* tag       - receives the AES_CCM_TAG_LENGTH byte tag
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+
+static void encrypt_message_ccm(uint8_t* dst, uint8_t const* src,
+                                size_t size, uint8_t* tag)
+{
+    const aes_ccm_params_t params =
+    {
+        .nonce = AesCcmNonce, .nonce_len = AES_CCM_NONCE_LENGTH,
+        .aad = AesCcmAad, .aad_len = sizeof(AesCcmAad) - 1u,
+        .tag_len = AES_CCM_TAG_LENGTH
+    };
+    cy_en_cryptolite_status_t res;
+    uint32_t start = op_stats_begin(OP_STATS_AES_CCM);
+
+    res = aes_ccm_encrypt(&aes_session, &params, dst, src, size, tag);
+    op_stats_end(OP_STATS_AES_CCM, start);
+    if (res != CY_CRYPTOLITE_SUCCESS)
     {
         CY_ASSERT(0);
     }
-    res = Cy_Cryptolite_Aes_Free(CRYPTOLITE,&aes_state);
-    if(res!=CY_CRYPTOLITE_SUCCESS)
+    uart_tx_puts("\r\nResult of Encryption:\r\n");
+    print_data(dst, size);
+    uart_tx_puts("\r\nAuthentication tag:\r\n");
+    print_data(tag, AES_CCM_TAG_LENGTH);
+}
+
+/*******************************************************************************
+* Function Name: decrypt_message_ccm
+********************************************************************************
+* Summary: Function used to decrypt the message for ccm mode and verify its
+*          tag. The message is only printed when the tag matches.
+*
+* Parameters:
+*  uint8_t* dst       - plaintext buffer, may equal src
+*  uint8_t const* src - ciphertext to be decrypted
+*  size_t size        - size of message to be decrypted.
+*  uint8_t const* tag - tag produced by encrypt_message_ccm()
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+
+static void decrypt_message_ccm(uint8_t* dst, uint8_t const* src,
+                                size_t size, uint8_t const* tag)
+{
+    const aes_ccm_params_t params =
+    {
+        .nonce = AesCcmNonce, .nonce_len = AES_CCM_NONCE_LENGTH,
+        .aad = AesCcmAad, .aad_len = sizeof(AesCcmAad) - 1u,
+        .tag_len = AES_CCM_TAG_LENGTH
+    };
+    bool authentic;
+    cy_en_cryptolite_status_t res;
+    uint32_t start = op_stats_begin(OP_STATS_AES_CCM);
+
+    res = aes_ccm_decrypt(&aes_session, &params, dst, src, size, tag,
+                          &authentic);
+    op_stats_end(OP_STATS_AES_CCM, start);
+    if (res != CY_CRYPTOLITE_SUCCESS)
     {
         CY_ASSERT(0);
     }
-    decrypted_msg[size]='\0';
+    if (!authentic)
+    {
+        uart_tx_puts("\r\nTag mismatch: message rejected\r\n");
+        return;
+    }
+    dst[size]='\0';
     /* Print the decrypted message on the UART terminal */
-    printf("\r\nResult of Decryption:\r\n\n");
-    printf("%s", decrypted_msg);
-
+    uart_tx_puts("\r\nTag verified. Result of Decryption:\r\n\n");
+    uart_tx_write(dst, size);
 }
 
 /*******************************************************************************
 * Function Name: generate_password
 ********************************************************************************
-* Summary: This function generates a 8 character long password
+* Summary: This function generates a PASSWORD_LENGTH character long password
+*          from PASSWORD_ALPHABET, with every character equally likely
 *
 * Parameters:
 *  None
@@ -674,70 +1128,1212 @@ static void decrypt_message_ctr(uint8_t* message, uint8_t size)
 *******************************************************************************/
 void generate_password(void)
 {
-    int8_t index;
-    uint32_t random_val;
-    uint8_t temp_value = 0;
+    entropy_pool_stats_t stats;
+    cy_en_cryptolite_status_t cryptolite_status;
 
     /* Array to hold the generated password. Array size is inclusive of
        string NULL terminating character */
-    uint8_t password[PASSWORD_LENGTH + 1]= {0};
+    char password[PASSWORD_LENGTH + 1]= {0};
+    uint32_t start = op_stats_begin(OP_STATS_TRNG);
+
+    /* Random bytes come from the pool, which is refilled from the TRNG only
+       if it has run dry */
+    cryptolite_status = password_gen_generate(&password_gen, PASSWORD_ALPHABET,
+                                              sizeof(PASSWORD_ALPHABET) - 1u,
+                                              password, PASSWORD_LENGTH);
+    op_stats_end(OP_STATS_TRNG, start);
+    if (cryptolite_status == CY_CRYPTOLITE_TRNG_UNHEALTHY)
+    {
+        uart_tx_printf("\nTRNG health test failed (%s), no password "
+                       "generated\r\n\n",
+                       (entropy_pool_health() == TRNG_HEALTH_RCT_FAILURE)
+                           ? "repetition count" : "adaptive proportion");
+        return;
+    }
+    if (cryptolite_status != CY_CRYPTOLITE_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Display the generated password on the UART Terminal */
+    uart_tx_printf("\nRandom Number: %s\r\n\n",password);
+    memset(password, 0, sizeof(password));
 
-    cy_en_cryptolite_status_t cryptolite_status = CY_CRYPTOLITE_SUCCESS;
-    cy_stc_cryptolite_trng_config_t config;
-    cryptolite_status = Cy_Cryptolite_Trng_Init(CRYPTOLITE,&config);
+    entropy_pool_get_stats(&stats);
+    uart_tx_printf("Entropy pool: %lu of %lu requests served from the pool, "
+                   "%lu bytes left\r\n\n",
+                   (unsigned long)stats.hits, (unsigned long)stats.requests,
+                   (unsigned long)stats.available);
+}
 
-    if (cryptolite_status == CY_CRYPTOLITE_SUCCESS)
+/*******************************************************************************
+* Function Name: print_op_stats
+********************************************************************************
+* Summary: Prints the call count and the minimum, mean and maximum duration of
+*          every operation timed so far, in core clock cycles and, for the
+*          mean, in microseconds.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void print_op_stats(void)
+{
+    op_stats_entry_t entry;
+    uint32_t mean;
+    uint64_t mean_ns;
+
+    uart_tx_printf("\r\n\nOperation timing in cycles at %lu Hz:\r\n\n",
+                   (unsigned long)SystemCoreClock);
+    uart_tx_printf("%-12s %8s %10s %10s %10s %12s\r\n", "Operation", "Calls",
+                   "Min", "Mean", "Max", "Mean (us)");
+    for (uint32_t op = 0u; op < (uint32_t)OP_STATS_COUNT; op++)
     {
-        for (index = 0; index < PASSWORD_LENGTH;)
+        op_stats_get((op_stats_id_t)op, &entry);
+        if (entry.count == 0u)
         {
-            /* Generate a random 32 bit number*/
-            cryptolite_status = Cy_Cryptolite_Trng(CRYPTOLITE, &random_val);
-            if(cryptolite_status!=CY_CRYPTOLITE_SUCCESS)
-            {
-            CY_ASSERT(0);
-            }
-            uint8_t bit_position  = 0;
-            for(int8_t j=0;j<4;j++)
-            {
-                /* extract byte from the bit position offset 0, 8, 16, and 24. */
-                temp_value=((random_val>>bit_position )& ASCII_7BIT_MASK);
-                temp_value=check_range(temp_value);
-                password[index++] = temp_value;
-                bit_position  = bit_position  + 8;
-            }
-         }
+            uart_tx_printf("%-12s %8s\r\n", op_stats_name((op_stats_id_t)op),
+                           "-");
+            continue;
+        }
+        mean = (uint32_t)(entry.total_cycles / entry.count);
+        mean_ns = cycle_count_to_ns(mean);
+        uart_tx_printf("%-12s %8lu %10lu %10lu %10lu %8lu.%03lu\r\n",
+                       op_stats_name((op_stats_id_t)op),
+                       (unsigned long)entry.count,
+                       (unsigned long)entry.min_cycles, (unsigned long)mean,
+                       (unsigned long)entry.max_cycles,
+                       (unsigned long)(mean_ns / 1000u),
+                       (unsigned long)(mean_ns % 1000u));
+    }
+}
+
+/*******************************************************************************
+* Function Name: frame_ping
+********************************************************************************
+* Summary: Frame handler that echoes the request payload.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_ping(frame_t const *request, uint8_t *response,
+                                 uint16_t *response_len)
+{
+    memcpy(response, request->payload, request->len);
+    *response_len = request->len;
+    return FRAME_STATUS_OK;
+}
 
-        /* Terminate the password with end of string character */
-        password[index] = '\0';
+/*******************************************************************************
+* Function Name: frame_aes_ctr
+********************************************************************************
+* Summary: Frame handler for AES CTR. The payload is the 16-byte initial
+*          counter block followed by the data; the response is the data
+*          encrypted (or, equivalently, decrypted) with the current key.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_aes_ctr(frame_t const *request, uint8_t *response,
+                                    uint16_t *response_len)
+{
+    aes_ctr_ctx_t ctr_ctx;
+    cy_en_cryptolite_status_t res;
+    uint16_t data_len;
+    uint32_t start;
 
-        /* Display the generated password on the UART Terminal */
-        printf("\nRandom Number: %s\r\n\n",password);
+    if (request->len < AES128_IV_LENGTH)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    data_len = request->len - AES128_IV_LENGTH;
 
-        /* Free the TRNG generator block */
-        Cy_Cryptolite_Trng_DeInit(CRYPTOLITE);
+    start = op_stats_begin(OP_STATS_AES_CTR);
+    res = aes_ctr_init(&ctr_ctx, &aes_session, request->payload);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = aes_ctr_update(&ctr_ctx, response,
+                             &request->payload[AES128_IV_LENGTH], data_len);
     }
+    aes_ctr_final(&ctr_ctx);
+    op_stats_end(OP_STATS_AES_CTR, start);
+
+    *response_len = data_len;
+    return (res == CY_CRYPTOLITE_SUCCESS) ? FRAME_STATUS_OK
+                                          : FRAME_STATUS_CRYPTO_ERROR;
 }
 
 /*******************************************************************************
-* Function Name: check_range
+* Function Name: frame_aes_cfb
 ********************************************************************************
-* Summary: This function check if the generated random number is in the
-*          range of alpha-numeric, special characters ASCII codes.
-*          If not, convert to that range
+* Summary: Frame handler for AES CFB. The payload is the 16-byte IV followed
+*          by the data; FRAME_FLAG_DECRYPT selects decryption.
 *
 * Parameters:
-*  uint8_t
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
 *
-* Return
-*  uint8_t
+* Return:
+*  frame_status_t
 *
 *******************************************************************************/
-uint8_t check_range(uint8_t value)
+static frame_status_t frame_aes_cfb(frame_t const *request, uint8_t *response,
+                                    uint16_t *response_len)
 {
-    if (value < ASCII_VISIBLE_CHARACTER_START)
+    aes_cfb_ctx_t cfb_ctx;
+    cy_en_cryptolite_status_t res;
+    uint16_t data_len;
+    uint32_t start;
+
+    if (request->len < AES128_IV_LENGTH)
     {
-         value += ASCII_VISIBLE_CHARACTER_START;
+        return FRAME_STATUS_BAD_LENGTH;
     }
-     return value;
+    data_len = request->len - AES128_IV_LENGTH;
+
+    start = op_stats_begin(OP_STATS_AES_CFB);
+    res = aes_cfb_init(&cfb_ctx, &aes_session,
+                       ((request->flags & FRAME_FLAG_DECRYPT) != 0u) ?
+                       CY_CRYPTOLITE_DECRYPT : CY_CRYPTOLITE_ENCRYPT,
+                       request->payload);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = aes_cfb_update(&cfb_ctx, response,
+                             &request->payload[AES128_IV_LENGTH], data_len);
+    }
+    aes_cfb_final(&cfb_ctx);
+    op_stats_end(OP_STATS_AES_CFB, start);
+
+    *response_len = data_len;
+    return (res == CY_CRYPTOLITE_SUCCESS) ? FRAME_STATUS_OK
+                                          : FRAME_STATUS_CRYPTO_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: frame_sha256
+********************************************************************************
+* Summary: Frame handler returning the SHA-256 digest of the payload.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_sha256(frame_t const *request, uint8_t *response,
+                                   uint16_t *response_len)
+{
+    cy_stc_cryptolite_context_sha256_t sha_ctx;
+    cy_en_cryptolite_status_t res;
+    uint32_t start = op_stats_begin(OP_STATS_SHA256);
+
+    res = Cy_Cryptolite_Sha256_Run(CRYPTOLITE, request->payload, request->len,
+                                   response, &sha_ctx);
+    op_stats_end(OP_STATS_SHA256, start);
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        return FRAME_STATUS_CRYPTO_ERROR;
+    }
+    *response_len = CRYPTOLITE_MESSAGE_DIGEST_SIZE;
+    return FRAME_STATUS_OK;
+}
+
+/*******************************************************************************
+* Function Name: frame_trng
+********************************************************************************
+* Summary: Frame handler returning random bytes from random_fill(). The
+*          payload is the number of bytes requested as a 16-bit little-endian
+*          value.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_trng(frame_t const *request, uint8_t *response,
+                                 uint16_t *response_len)
+{
+    cy_en_cryptolite_status_t res;
+    uint16_t count;
+    uint32_t start;
+
+    if (request->len != 2u)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    count = (uint16_t)(request->payload[0] | ((uint16_t)request->payload[1] << 8));
+    if (count > FRAME_MAX_PAYLOAD)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+
+    start = op_stats_begin(OP_STATS_TRNG);
+    res = random_fill(response, count);
+    op_stats_end(OP_STATS_TRNG, start);
+
+    *response_len = count;
+    return (res == CY_CRYPTOLITE_SUCCESS) ? FRAME_STATUS_OK
+                                          : FRAME_STATUS_CRYPTO_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: frame_set_key
+********************************************************************************
+* Summary: Frame handler replacing the AES key used by all modes, including
+*          the interactive menu.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_set_key(frame_t const *request, uint8_t *response,
+                                    uint16_t *response_len)
+{
+    (void)response;
+
+    if (request->len != AES128_KEY_LENGTH)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+
+    memcpy(aes_key, request->payload, AES128_KEY_LENGTH);
+    *response_len = 0u;
+    return (aes_session_load(&aes_session, aes_key) == CY_CRYPTOLITE_SUCCESS) ?
+           FRAME_STATUS_OK : FRAME_STATUS_CRYPTO_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: frame_sha256_start
+********************************************************************************
+* Summary: Frame handler starting a streamed SHA-256 digest. Any digest still
+*          in progress is discarded.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_sha256_start(frame_t const *request,
+                                         uint8_t *response,
+                                         uint16_t *response_len)
+{
+    (void)response;
+
+    if (request->len != 0u)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    *response_len = 0u;
+    return (sha256_stream_start(&frame_sha) == CY_CRYPTOLITE_SUCCESS) ?
+           FRAME_STATUS_OK : FRAME_STATUS_CRYPTO_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: frame_sha256_update
+********************************************************************************
+* Summary: Frame handler absorbing the payload into the streamed digest.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_sha256_update(frame_t const *request,
+                                          uint8_t *response,
+                                          uint16_t *response_len)
+{
+    cy_en_cryptolite_status_t res;
+    uint32_t start = op_stats_begin(OP_STATS_SHA256);
+
+    (void)response;
+
+    res = sha256_stream_update(&frame_sha, request->payload, request->len);
+    op_stats_end(OP_STATS_SHA256, start);
+    *response_len = 0u;
+    return (res == CY_CRYPTOLITE_SUCCESS) ? FRAME_STATUS_OK
+                                          : FRAME_STATUS_CRYPTO_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: frame_sha256_finish
+********************************************************************************
+* Summary: Frame handler returning the streamed digest.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_sha256_finish(frame_t const *request,
+                                          uint8_t *response,
+                                          uint16_t *response_len)
+{
+    cy_en_cryptolite_status_t res;
+    uint32_t start;
+
+    if (request->len != 0u)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    start = op_stats_begin(OP_STATS_SHA256);
+    res = sha256_stream_finish(&frame_sha, response);
+    op_stats_end(OP_STATS_SHA256, start);
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        return FRAME_STATUS_CRYPTO_ERROR;
+    }
+    *response_len = SHA256_STREAM_DIGEST_SIZE;
+    return FRAME_STATUS_OK;
+}
+
+/*******************************************************************************
+* Function Name: frame_hmac_set_key
+********************************************************************************
+* Summary: Frame handler keying the HMAC_SHA256 command. The payload is the
+*          key, of any length.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_hmac_set_key(frame_t const *request,
+                                         uint8_t *response,
+                                         uint16_t *response_len)
+{
+    (void)response;
+
+    *response_len = 0u;
+    return (hmac_sha256_set_key(&frame_hmac, request->payload, request->len) ==
+            CY_CRYPTOLITE_SUCCESS) ? FRAME_STATUS_OK
+                                   : FRAME_STATUS_CRYPTO_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: frame_hmac_sha256
+********************************************************************************
+* Summary: Frame handler returning the HMAC-SHA256 of the payload under the
+*          key set by HMAC_SET_KEY.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_hmac_sha256(frame_t const *request,
+                                        uint8_t *response,
+                                        uint16_t *response_len)
+{
+    cy_en_cryptolite_status_t res;
+    uint32_t start = op_stats_begin(OP_STATS_HMAC_SHA256);
+
+    res = hmac_sha256(&frame_hmac, request->payload, request->len, response);
+    op_stats_end(OP_STATS_HMAC_SHA256, start);
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        return FRAME_STATUS_CRYPTO_ERROR;
+    }
+    *response_len = HMAC_SHA256_MAC_SIZE;
+    return FRAME_STATUS_OK;
 }
+
+/*******************************************************************************
+* Function Name: frame_parse_aead
+********************************************************************************
+* Summary: Splits the payload shared by the AES_CCM and AES_GCM commands:
+*            tag length (1) | nonce length (1) | nonce | AAD length (2, LE) |
+*            AAD | data | tag (decryption only)
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  frame_aead_t* aead     - Receives the fields
+*
+* Return:
+*  frame_status_t - FRAME_STATUS_BAD_LENGTH if the fields do not fit the
+*                   payload or the response would not fit its buffer
+*
+*******************************************************************************/
+static frame_status_t frame_parse_aead(frame_t const *request,
+                                       frame_aead_t *aead)
+{
+    uint8_t const *p = request->payload;
+    size_t remaining = request->len;
+
+    aead->decrypt = ((request->flags & FRAME_FLAG_DECRYPT) != 0u);
+    if (remaining < 2u)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    aead->tag_len = p[0];
+    aead->nonce_len = p[1];
+    p += 2u;
+    remaining -= 2u;
+
+    if (remaining < (aead->nonce_len + 2u))
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    aead->nonce = p;
+    p += aead->nonce_len;
+    aead->aad_len = (size_t)(p[0] | ((uint16_t)p[1] << 8));
+    p += 2u;
+    remaining -= aead->nonce_len + 2u;
+
+    if (remaining < (aead->aad_len + (aead->decrypt ? aead->tag_len : 0u)))
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    aead->aad = p;
+    p += aead->aad_len;
+    aead->data = p;
+    aead->data_len = remaining - aead->aad_len -
+                     (aead->decrypt ? aead->tag_len : 0u);
+    aead->tag = &p[aead->data_len];
+
+    if ((aead->data_len + (aead->decrypt ? 0u : aead->tag_len)) >
+        FRAME_MAX_PAYLOAD)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    return FRAME_STATUS_OK;
+}
+
+/*******************************************************************************
+* Function Name: frame_aead_result
+********************************************************************************
+* Summary: Sets the response length and status of an AEAD request.
+*
+*******************************************************************************/
+static frame_status_t frame_aead_result(frame_aead_t const *aead,
+                                        cy_en_cryptolite_status_t res,
+                                        bool authentic,
+                                        uint16_t *response_len)
+{
+    *response_len = 0u;
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        return FRAME_STATUS_CRYPTO_ERROR;
+    }
+    if (!authentic)
+    {
+        return FRAME_STATUS_AUTH_FAILED;
+    }
+    *response_len = (uint16_t)(aead->data_len +
+                               (aead->decrypt ? 0u : aead->tag_len));
+    return FRAME_STATUS_OK;
+}
+
+/*******************************************************************************
+* Function Name: frame_aes_ccm
+********************************************************************************
+* Summary: Frame handler for AES-CCM, see frame_parse_aead() for the payload.
+*          Encryption returns the ciphertext followed by the tag; decryption
+*          returns the plaintext, or FRAME_STATUS_AUTH_FAILED.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_aes_ccm(frame_t const *request, uint8_t *response,
+                                    uint16_t *response_len)
+{
+    frame_aead_t aead;
+    aes_ccm_params_t params;
+    cy_en_cryptolite_status_t res;
+    bool authentic = true;
+    frame_status_t status;
+    uint32_t start;
+
+    status = frame_parse_aead(request, &aead);
+    if (status != FRAME_STATUS_OK)
+    {
+        return status;
+    }
+    params.nonce = aead.nonce;
+    params.nonce_len = aead.nonce_len;
+    params.aad = aead.aad;
+    params.aad_len = aead.aad_len;
+    params.tag_len = aead.tag_len;
+
+    start = op_stats_begin(OP_STATS_AES_CCM);
+    if (aead.decrypt)
+    {
+        res = aes_ccm_decrypt(&aes_session, &params, response, aead.data,
+                              aead.data_len, aead.tag, &authentic);
+    }
+    else
+    {
+        res = aes_ccm_encrypt(&aes_session, &params, response, aead.data,
+                              aead.data_len, &response[aead.data_len]);
+    }
+    op_stats_end(OP_STATS_AES_CCM, start);
+    return frame_aead_result(&aead, res, authentic, response_len);
+}
+
+/*******************************************************************************
+* Function Name: frame_aes_gcm
+********************************************************************************
+* Summary: Frame handler for AES-GCM, see frame_parse_aead() for the payload
+*          (the nonce is the IV). Encryption returns the ciphertext followed
+*          by the tag; decryption returns the plaintext, or
+*          FRAME_STATUS_AUTH_FAILED.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_aes_gcm(frame_t const *request, uint8_t *response,
+                                    uint16_t *response_len)
+{
+    frame_aead_t aead;
+    aes_gcm_params_t params;
+    cy_en_cryptolite_status_t res;
+    bool authentic = true;
+    frame_status_t status;
+    uint32_t start;
+
+    status = frame_parse_aead(request, &aead);
+    if (status != FRAME_STATUS_OK)
+    {
+        return status;
+    }
+    params.iv = aead.nonce;
+    params.iv_len = aead.nonce_len;
+    params.aad = aead.aad;
+    params.aad_len = aead.aad_len;
+    params.tag_len = aead.tag_len;
+
+    start = op_stats_begin(OP_STATS_AES_GCM);
+    if (aead.decrypt)
+    {
+        res = aes_gcm_decrypt(&gcm_key, &params, response, aead.data,
+                              aead.data_len, aead.tag, &authentic);
+    }
+    else
+    {
+        res = aes_gcm_encrypt(&gcm_key, &params, response, aead.data,
+                              aead.data_len, &response[aead.data_len]);
+    }
+    op_stats_end(OP_STATS_AES_GCM, start);
+    return frame_aead_result(&aead, res, authentic, response_len);
+}
+
+/*******************************************************************************
+* Function Name: frame_aes_cmac
+********************************************************************************
+* Summary: Frame handler returning the AES-CMAC of the payload under the key
+*          set by SET_KEY.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_aes_cmac(frame_t const *request, uint8_t *response,
+                                     uint16_t *response_len)
+{
+    cy_en_cryptolite_status_t res;
+    uint32_t start = op_stats_begin(OP_STATS_AES_CMAC);
+
+    res = aes_cmac(&cmac_key, request->payload, request->len, response);
+    op_stats_end(OP_STATS_AES_CMAC, start);
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        return FRAME_STATUS_CRYPTO_ERROR;
+    }
+    *response_len = AES_CMAC_MAC_SIZE;
+    return FRAME_STATUS_OK;
+}
+
+/*******************************************************************************
+* Function Name: put_le32
+********************************************************************************
+* Summary: Stores a 32-bit value least significant byte first.
+*
+*******************************************************************************/
+static void put_le32(uint8_t *p, uint32_t value)
+{
+    for (uint32_t i = 0u; i < 4u; i++)
+    {
+        p[i] = (uint8_t)(value >> (8u * i));
+    }
+}
+
+/*******************************************************************************
+* Function Name: frame_aes_batch
+********************************************************************************
+* Summary: Frame handler for a batch of AES CTR or CFB jobs under the SET_KEY
+*          key. All job headers are checked before anything is run. The
+*          response starts with the timing of the batch and of each job,
+*          followed by the output of the jobs in request order.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_aes_batch(frame_t const *request,
+                                      uint8_t *response,
+                                      uint16_t *response_len)
+{
+    aes_batch_stats_t stats;
+    aes_batch_mode_t batch_mode;
+    uint8_t const *p = request->payload;
+    size_t remaining = request->len;
+    uint32_t count;
+    uint8_t *out;
+
+    if (remaining < 2u)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    if (p[0] > (uint8_t)AES_BATCH_CFB_DECRYPT)
+    {
+        return FRAME_STATUS_BAD_COMMAND;
+    }
+    batch_mode = (aes_batch_mode_t)p[0];
+    count = p[1];
+    if ((count == 0u) || (count > FRAME_MAX_BATCH_JOBS))
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    p += 2u;
+    remaining -= 2u;
+
+    /* Timing header, then the jobs' output back to back */
+    out = &response[12u + (4u * count)];
+    for (uint32_t i = 0u; i < count; i++)
+    {
+        aes_batch_job_t *job = &frame_batch_jobs[i];
+
+        if (remaining < (AES_BATCH_IV_SIZE + 2u))
+        {
+            return FRAME_STATUS_BAD_LENGTH;
+        }
+        job->iv = p;
+        job->len = (size_t)(p[AES_BATCH_IV_SIZE] |
+                            ((uint16_t)p[AES_BATCH_IV_SIZE + 1u] << 8));
+        p += AES_BATCH_IV_SIZE + 2u;
+        remaining -= AES_BATCH_IV_SIZE + 2u;
+        if (remaining < job->len)
+        {
+            return FRAME_STATUS_BAD_LENGTH;
+        }
+        job->src = p;
+        job->dst = out;
+        p += job->len;
+        out += job->len;
+        remaining -= job->len;
+    }
+    if (remaining != 0u)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+
+    if (aes_batch_run(&aes_session, NULL, batch_mode, frame_batch_jobs, count,
+                      &stats) != CY_CRYPTOLITE_SUCCESS)
+    {
+        return FRAME_STATUS_CRYPTO_ERROR;
+    }
+
+    put_le32(&response[0], SystemCoreClock);
+    put_le32(&response[4], stats.key_cycles);
+    put_le32(&response[8], stats.total_cycles);
+    for (uint32_t i = 0u; i < count; i++)
+    {
+        put_le32(&response[12u + (4u * i)], frame_batch_jobs[i].cycles);
+    }
+    *response_len = (uint16_t)(out - response);
+    return FRAME_STATUS_OK;
+}
+
+/*******************************************************************************
+* Function Name: frame_trng_stats
+********************************************************************************
+* Summary: Frame handler returning the entropy pool counters, so that a host
+*          can see how many TRNG requests were served without waiting on the
+*          TRNG, what the refills cost and how the health tests stand.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_trng_stats(frame_t const *request,
+                                       uint8_t *response,
+                                       uint16_t *response_len)
+{
+    entropy_pool_stats_t stats;
+
+    if (request->len != 0u)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+
+    entropy_pool_get_stats(&stats);
+    put_le32(&response[0], SystemCoreClock);
+    put_le32(&response[4], stats.requests);
+    put_le32(&response[8], stats.hits);
+    put_le32(&response[12], stats.bytes_served);
+    put_le32(&response[16], stats.refills);
+    put_le32(&response[20], stats.refill_words);
+    put_le32(&response[24], (uint32_t)stats.refill_cycles);
+    put_le32(&response[28], (uint32_t)(stats.refill_cycles >> 32));
+    put_le32(&response[32], stats.max_refill_cycles);
+    put_le32(&response[36], stats.available);
+    put_le32(&response[40], (uint32_t)stats.health);
+    put_le32(&response[44], stats.health_samples);
+    put_le32(&response[48], stats.max_rct_count);
+    put_le32(&response[52], stats.max_apt_count);
+
+    *response_len = 56u;
+    return FRAME_STATUS_OK;
+}
+
+/*******************************************************************************
+* Function Name: frame_drbg
+********************************************************************************
+* Summary: Frame handler returning CTR_DRBG output. The payload is the number
+*          of bytes requested as a 16-bit little-endian value, optionally
+*          followed by up to CTR_DRBG_SEED_SIZE bytes of additional input.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_drbg(frame_t const *request, uint8_t *response,
+                                 uint16_t *response_len)
+{
+    cy_en_cryptolite_status_t res;
+    uint16_t count;
+    uint32_t start;
+
+    if ((request->len < 2u) || (request->len > (2u + CTR_DRBG_SEED_SIZE)))
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    count = (uint16_t)(request->payload[0] | ((uint16_t)request->payload[1] << 8));
+    if (count > FRAME_MAX_PAYLOAD)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+
+    start = op_stats_begin(OP_STATS_DRBG);
+    res = ctr_drbg_generate(&drbg, response, count, &request->payload[2],
+                            request->len - 2u);
+    op_stats_end(OP_STATS_DRBG, start);
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        return FRAME_STATUS_CRYPTO_ERROR;
+    }
+    *response_len = count;
+    return FRAME_STATUS_OK;
+}
+
+/*******************************************************************************
+* Function Name: frame_rng_bench
+********************************************************************************
+* Summary: Frame handler timing the production of the same number of random
+*          bytes straight from the TRNG and from the CTR_DRBG, using the
+*          response buffer as scratch. The payload is the byte count as a
+*          32-bit little-endian value; the response holds the core clock in
+*          Hz followed by the TRNG and DRBG cycle counts.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_rng_bench(frame_t const *request,
+                                      uint8_t *response,
+                                      uint16_t *response_len)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+    uint32_t count;
+    uint32_t start;
+    uint32_t trng_cycles;
+    uint32_t drbg_cycles;
+    uint32_t random_val;
+    uint32_t chunk;
+
+    if (request->len != 4u)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    count = (uint32_t)request->payload[0] |
+            ((uint32_t)request->payload[1] << 8) |
+            ((uint32_t)request->payload[2] << 16) |
+            ((uint32_t)request->payload[3] << 24);
+    if (count > RNG_BENCH_MAX_BYTES)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+
+    /* Both fill the response buffer a chunk at a time. The TRNG is kept
+     * running by the entropy pool, which is bypassed here. */
+    start = cycle_count_now();
+    for (uint32_t i = 0u; (i < count) && (res == CY_CRYPTOLITE_SUCCESS); i += chunk)
+    {
+        chunk = ((count - i) < FRAME_MAX_PAYLOAD) ? (count - i)
+                                                  : FRAME_MAX_PAYLOAD;
+        for (uint32_t j = 0u; (j < chunk) && (res == CY_CRYPTOLITE_SUCCESS); j += 4u)
+        {
+            res = Cy_Cryptolite_Trng(CRYPTOLITE, &random_val);
+            memcpy(&response[j], &random_val,
+                   ((chunk - j) < 4u) ? (chunk - j) : 4u);
+        }
+    }
+    trng_cycles = cycle_count_since(start);
+
+    start = cycle_count_now();
+    for (uint32_t i = 0u; (i < count) && (res == CY_CRYPTOLITE_SUCCESS); i += chunk)
+    {
+        chunk = ((count - i) < FRAME_MAX_PAYLOAD) ? (count - i)
+                                                  : FRAME_MAX_PAYLOAD;
+        res = ctr_drbg_generate(&drbg, response, chunk, NULL, 0u);
+    }
+    drbg_cycles = cycle_count_since(start);
+
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        return FRAME_STATUS_CRYPTO_ERROR;
+    }
+    put_le32(&response[0], SystemCoreClock);
+    put_le32(&response[4], trng_cycles);
+    put_le32(&response[8], drbg_cycles);
+    *response_len = 12u;
+    return FRAME_STATUS_OK;
+}
+
+/*******************************************************************************
+* Function Name: frame_password
+********************************************************************************
+* Summary: Frame handler generating a password. The payload is the length
+*          (1 byte), optionally followed by the alphabet to use instead of
+*          PASSWORD_ALPHABET.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_password(frame_t const *request,
+                                     uint8_t *response,
+                                     uint16_t *response_len)
+{
+    char const *alphabet = PASSWORD_ALPHABET;
+    size_t alphabet_len = sizeof(PASSWORD_ALPHABET) - 1u;
+    cy_en_cryptolite_status_t res;
+    uint8_t len;
+    uint32_t start;
+
+    if ((request->len < 1u) || (request->len > (1u + 256u)))
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    len = request->payload[0];
+    /* The password and its terminating NUL must fit the response buffer.
+     * Any 1-byte length does with the default FRAME_MAX_DATA; smaller
+     * builds rely on this check, done in uint32_t so it is not vacuous. */
+    if (((uint32_t)len + 1u) > FRAME_MAX_PAYLOAD)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    if (request->len > 1u)
+    {
+        alphabet = (char const *)&request->payload[1];
+        alphabet_len = request->len - 1u;
+    }
+
+    start = op_stats_begin(OP_STATS_TRNG);
+    res = password_gen_generate(&password_gen, alphabet, alphabet_len,
+                                (char *)response, len);
+    op_stats_end(OP_STATS_TRNG, start);
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        return FRAME_STATUS_CRYPTO_ERROR;
+    }
+    *response_len = len;
+    return FRAME_STATUS_OK;
+}
+
+/*******************************************************************************
+* Function Name: frame_op_stats
+********************************************************************************
+* Summary: Frame handler returning the operation timing statistics. An
+*          optional 1-byte payload of 1 clears them after they are read.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_op_stats(frame_t const *request,
+                                     uint8_t *response,
+                                     uint16_t *response_len)
+{
+    op_stats_entry_t entry;
+    uint8_t *p = &response[8];
+
+    if ((request->len > 1u) ||
+        ((request->len == 1u) && (request->payload[0] > 1u)))
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    if ((8u + ((uint32_t)OP_STATS_COUNT * 20u)) > FRAME_MAX_PAYLOAD)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+
+    put_le32(&response[0], SystemCoreClock);
+    put_le32(&response[4], (uint32_t)OP_STATS_COUNT);
+    for (uint32_t op = 0u; op < (uint32_t)OP_STATS_COUNT; op++)
+    {
+        op_stats_get((op_stats_id_t)op, &entry);
+        put_le32(&p[0], entry.count);
+        put_le32(&p[4], entry.min_cycles);
+        put_le32(&p[8], entry.max_cycles);
+        put_le32(&p[12], (uint32_t)entry.total_cycles);
+        put_le32(&p[16], (uint32_t)(entry.total_cycles >> 32));
+        p += 20u;
+    }
+    if ((request->len == 1u) && (request->payload[0] == 1u))
+    {
+        op_stats_reset();
+    }
+
+    *response_len = (uint16_t)(p - response);
+    return FRAME_STATUS_OK;
+}
+
+/*******************************************************************************
+* Function Name: frame_trace_dump
+********************************************************************************
+* Summary: Frame handler reading the trace ring a page at a time. The payload
+*          is the sequence number of the first event wanted (4 bytes); the
+*          response starts at the oldest event still held if that one has
+*          been overwritten.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_trace_dump(frame_t const *request,
+                                       uint8_t *response,
+                                       uint16_t *response_len)
+{
+    trace_event_t events[(FRAME_MAX_PAYLOAD - 12u) / TRACE_EVENT_SIZE];
+    uint32_t first;
+    uint32_t count;
+    uint8_t *p = &response[12];
+
+    if (request->len != 4u)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    first = (uint32_t)request->payload[0] |
+            ((uint32_t)request->payload[1] << 8) |
+            ((uint32_t)request->payload[2] << 16) |
+            ((uint32_t)request->payload[3] << 24);
+
+    count = trace_ring_read(first, events, sizeof(events) / sizeof(events[0]),
+                            &first);
+    put_le32(&response[0], SystemCoreClock);
+    put_le32(&response[4], trace_ring_head());
+    put_le32(&response[8], first);
+    for (uint32_t i = 0u; i < count; i++)
+    {
+        put_le32(&p[0], events[i].timestamp);
+        put_le32(&p[4], events[i].info);
+        p += TRACE_EVENT_SIZE;
+    }
+
+    *response_len = (uint16_t)(p - response);
+    return FRAME_STATUS_OK;
+}
+
+/*******************************************************************************
+* Function Name: frame_ble_sc
+********************************************************************************
+* Summary: Frame handler running one of the LE Secure Connections functions
+*          f4, f5, f6 or g2 on the inputs in the payload, see
+*          frame_protocol.h for the layouts.
+*
+* Parameters:
+*  frame_t const* request - Received request
+*  uint8_t* response      - Response payload buffer
+*  uint16_t* response_len - Set to the response payload length
+*
+* Return:
+*  frame_status_t
+*
+*******************************************************************************/
+static frame_status_t frame_ble_sc(frame_t const *request, uint8_t *response,
+                                   uint16_t *response_len)
+{
+    /* Input bytes after the function byte, indexed by frame_ble_sc_t */
+    static const uint16_t input_len[] =
+    {
+        [FRAME_BLE_SC_F4] = (2u * BLE_SC_PUBLIC_KEY_X_SIZE) +
+                            BLE_SC_NONCE_SIZE + 1u,
+        [FRAME_BLE_SC_F5] = BLE_SC_DHKEY_SIZE + (2u * BLE_SC_NONCE_SIZE) +
+                            (2u * BLE_SC_ADDRESS_SIZE),
+        [FRAME_BLE_SC_F6] = BLE_SC_KEY_SIZE + (3u * BLE_SC_NONCE_SIZE) +
+                            BLE_SC_IO_CAP_SIZE + (2u * BLE_SC_ADDRESS_SIZE),
+        [FRAME_BLE_SC_G2] = (2u * BLE_SC_PUBLIC_KEY_X_SIZE) +
+                            (2u * BLE_SC_NONCE_SIZE),
+    };
+    cy_en_cryptolite_status_t res;
+    uint8_t const *in = &request->payload[1];
+    uint32_t value;
+    uint32_t start;
+
+    if (request->len < 1u)
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+    if (request->payload[0] >= (sizeof(input_len) / sizeof(input_len[0])))
+    {
+        return FRAME_STATUS_BAD_COMMAND;
+    }
+    if ((request->len - 1u) != input_len[request->payload[0]])
+    {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+
+    start = op_stats_begin(OP_STATS_BLE_SC);
+    switch ((frame_ble_sc_t)request->payload[0])
+    {
+        case FRAME_BLE_SC_F4:
+            res = ble_sc_f4(&ble_sc, &in[0], &in[32], &in[64], in[80],
+                            response);
+            *response_len = BLE_SC_KEY_SIZE;
+            break;
+
+        case FRAME_BLE_SC_F5:
+            res = ble_sc_f5(&ble_sc, &in[0], &in[32], &in[48], &in[64],
+                            &in[71], &response[0], &response[16]);
+            *response_len = 2u * BLE_SC_KEY_SIZE;
+            break;
+
+        case FRAME_BLE_SC_F6:
+            res = ble_sc_f6(&ble_sc, &in[0], &in[16], &in[32], &in[48],
+                            &in[64], &in[67], &in[74], response);
+            *response_len = BLE_SC_KEY_SIZE;
+            break;
+
+        case FRAME_BLE_SC_G2:
+        default:
+            res = ble_sc_g2(&ble_sc, &in[0], &in[32], &in[64], &in[80],
+                            &value);
+            /* Most significant byte first like the other values */
+            response[0] = (uint8_t)(value >> 24);
+            response[1] = (uint8_t)(value >> 16);
+            response[2] = (uint8_t)(value >> 8);
+            response[3] = (uint8_t)value;
+            *response_len = 4u;
+            break;
+    }
+    op_stats_end(OP_STATS_BLE_SC, start);
+
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        *response_len = 0u;
+        return FRAME_STATUS_CRYPTO_ERROR;
+    }
+    return FRAME_STATUS_OK;
+}
+
 /* [] END OF FILE */
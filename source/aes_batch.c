@@ -0,0 +1,184 @@
+/******************************************************************************
+* File Name: aes_batch.c
+*
+* Description: Batched AES CTR/CFB, see aes_batch.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_batch.h"
+#include "aes_ctr.h"
+#include "aes_cfb.h"
+#include "cycle_count.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: batch_job
+********************************************************************************
+* Summary: Runs one job from its IV to the end of its data.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t batch_job(aes_session_t *session,
+                                           aes_batch_mode_t mode,
+                                           aes_batch_job_t const *job)
+{
+    cy_en_cryptolite_status_t res;
+    aes_ctr_ctx_t ctr_ctx;
+    aes_cfb_ctx_t cfb_ctx;
+
+    if (mode == AES_BATCH_CTR)
+    {
+        res = aes_ctr_init(&ctr_ctx, session, job->iv);
+        if (res == CY_CRYPTOLITE_SUCCESS)
+        {
+            res = aes_ctr_update(&ctr_ctx, job->dst, job->src, job->len);
+        }
+        aes_ctr_final(&ctr_ctx);
+    }
+    else
+    {
+        res = aes_cfb_init(&cfb_ctx, session,
+                           (mode == AES_BATCH_CFB_ENCRYPT) ?
+                           CY_CRYPTOLITE_ENCRYPT : CY_CRYPTOLITE_DECRYPT,
+                           job->iv);
+        if (res == CY_CRYPTOLITE_SUCCESS)
+        {
+            res = aes_cfb_update(&cfb_ctx, job->dst, job->src, job->len);
+        }
+        aes_cfb_final(&cfb_ctx);
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_batch_run
+********************************************************************************
+* Summary: Loads the key once and processes every job in order. A failing
+*          job does not stop the batch; its status is recorded and the next
+*          job is run.
+*
+* Parameters:
+*  aes_session_t* session    - AES session to run the batch on
+*  uint8_t const* key        - 128-bit key, or NULL to use the key already
+*                              loaded into the session
+*  aes_batch_mode_t mode     - Cipher mode and direction of all jobs
+*  aes_batch_job_t* jobs     - Job descriptors; status and cycles are set
+*  size_t count              - Number of jobs
+*  aes_batch_stats_t* stats  - Batch timing, may be NULL
+*
+* Return:
+*  cy_en_cryptolite_status_t - Status of the key load, otherwise of the first
+*                              failing job
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_batch_run(aes_session_t *session,
+                                        uint8_t const *key,
+                                        aes_batch_mode_t mode,
+                                        aes_batch_job_t *jobs, size_t count,
+                                        aes_batch_stats_t *stats)
+{
+    cy_en_cryptolite_status_t key_res = CY_CRYPTOLITE_SUCCESS;
+    cy_en_cryptolite_status_t res;
+    aes_batch_stats_t batch;
+    uint32_t batch_start;
+    uint32_t job_start;
+
+    if ((session == NULL) || ((count != 0u) && (jobs == NULL)) ||
+        (mode > AES_BATCH_CFB_DECRYPT))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    memset(&batch, 0, sizeof(batch));
+    batch_start = cycle_count_now();
+
+    if (key != NULL)
+    {
+        key_res = aes_session_load(session, key);
+        batch.key_cycles = cycle_count_since(batch_start);
+    }
+    else if (!session->loaded)
+    {
+        key_res = CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+    res = key_res;
+
+    for (size_t i = 0u; i < count; i++)
+    {
+        aes_batch_job_t *job = &jobs[i];
+
+        if (key_res == CY_CRYPTOLITE_SUCCESS)
+        {
+            job_start = cycle_count_now();
+            job->status = batch_job(session, mode, job);
+            job->cycles = cycle_count_since(job_start);
+        }
+        else
+        {
+            /* No key, nothing was run */
+            job->status = res;
+            job->cycles = 0u;
+        }
+        if (res == CY_CRYPTOLITE_SUCCESS)
+        {
+            res = job->status;
+        }
+
+        if (job->status == CY_CRYPTOLITE_SUCCESS)
+        {
+            batch.bytes += job->len;
+        }
+        else
+        {
+            batch.failed_jobs++;
+        }
+        if (job->cycles > batch.max_job_cycles)
+        {
+            batch.max_job_cycles = job->cycles;
+        }
+    }
+
+    batch.total_cycles = cycle_count_since(batch_start);
+    if (stats != NULL)
+    {
+        *stats = batch;
+    }
+    return res;
+}
+
+/* [] END OF FILE */
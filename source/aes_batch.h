@@ -0,0 +1,104 @@
+/******************************************************************************
+* File Name: aes_batch.h
+*
+* Description: Batched AES CTR/CFB. A batch is an array of job descriptors,
+* each with its own IV, source and destination, processed back to back under
+* one key with a single key load. Every job and the batch as a whole are timed
+* with the cycle counter, so the cost of a batch can be budgeted against a
+* connection interval.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_AES_BATCH_H_
+#define SOURCE_AES_BATCH_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_session.h"
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define AES_BATCH_IV_SIZE                    (16u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef enum
+{
+    AES_BATCH_CTR,
+    AES_BATCH_CFB_ENCRYPT,
+    AES_BATCH_CFB_DECRYPT
+} aes_batch_mode_t;
+
+/* One message of a batch. dst may equal src. */
+typedef struct
+{
+    uint8_t const            *iv;
+    uint8_t const            *src;
+    uint8_t                  *dst;
+    size_t                    len;
+    /* Filled in by aes_batch_run() */
+    cy_en_cryptolite_status_t status;
+    uint32_t                  cycles;
+} aes_batch_job_t;
+
+/* Timing of a whole batch */
+typedef struct
+{
+    /* Key load, zero when the key was already loaded */
+    uint32_t key_cycles;
+    /* Key load plus all jobs */
+    uint32_t total_cycles;
+    uint32_t max_job_cycles;
+    size_t   bytes;
+    size_t   failed_jobs;
+} aes_batch_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_batch_run(aes_session_t *session,
+                                        uint8_t const *key,
+                                        aes_batch_mode_t mode,
+                                        aes_batch_job_t *jobs, size_t count,
+                                        aes_batch_stats_t *stats);
+
+#endif /* SOURCE_AES_BATCH_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,379 @@
+/******************************************************************************
+* File Name: aes_ccm.c
+*
+* Description: AES-128 CCM, see aes_ccm.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_ccm.h"
+#include "mem_xor.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Associated data lengths from this value on use the 6-byte encoding */
+#define CCM_AAD_LONG_THRESHOLD               (0xFF00u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef struct
+{
+    aes_session_t *session;
+    /* CBC-MAC chaining value */
+    uint8_t        mac[AES_CCM_BLOCK_SIZE];
+    /* Counter block A_i */
+    uint8_t        counter[AES_CCM_BLOCK_SIZE];
+    /* Bytes of the counter block holding the block index */
+    uint32_t       length_size;
+} ccm_state_t;
+
+/*******************************************************************************
+* Function Name: ccm_encrypt_block
+********************************************************************************
+* Summary: Runs one block through the session's key.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t ccm_encrypt_block(ccm_state_t *ccm,
+                                                   uint8_t *dst,
+                                                   uint8_t const *src)
+{
+    return Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, dst, src,
+                                 &ccm->session->state);
+}
+
+/*******************************************************************************
+* Function Name: ccm_mac_absorb
+********************************************************************************
+* Summary: Adds up to one block to the CBC-MAC. A short block is implicitly
+*          zero padded.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t ccm_mac_absorb(ccm_state_t *ccm,
+                                                uint8_t const *data,
+                                                size_t len)
+{
+    for (size_t i = 0u; i < len; i++)
+    {
+        ccm->mac[i] ^= data[i];
+    }
+    return ccm_encrypt_block(ccm, ccm->mac, ccm->mac);
+}
+
+/*******************************************************************************
+* Function Name: ccm_start
+********************************************************************************
+* Summary: Checks the parameters, absorbs B0 and the associated data, and
+*          sets up counter block A0.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t ccm_start(ccm_state_t *ccm,
+                                           aes_session_t *session,
+                                           aes_ccm_params_t const *params,
+                                           size_t len)
+{
+    cy_en_cryptolite_status_t res;
+    uint8_t block[AES_CCM_BLOCK_SIZE];
+    size_t aad_len;
+    size_t used;
+    size_t fill;
+    uint8_t const *aad;
+    uint32_t length_size;
+
+    if ((session == NULL) || (params == NULL) || (params->nonce == NULL) ||
+        ((params->aad_len != 0u) && (params->aad == NULL)) ||
+        (params->nonce_len < AES_CCM_MIN_NONCE_LENGTH) ||
+        (params->nonce_len > AES_CCM_MAX_NONCE_LENGTH) ||
+        (params->tag_len < AES_CCM_MIN_TAG_LENGTH) ||
+        (params->tag_len > AES_CCM_MAX_TAG_LENGTH) ||
+        ((params->tag_len % 2u) != 0u))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!session->loaded)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    /* The message length must fit the length field */
+    length_size = AES_CCM_BLOCK_SIZE - 1u - (uint32_t)params->nonce_len;
+    if ((length_size < sizeof(size_t)) &&
+        ((len >> (8u * length_size)) != 0u))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    ccm->session = session;
+    ccm->length_size = length_size;
+
+    /* B0 = flags | nonce | message length */
+    memset(ccm->mac, 0, AES_CCM_BLOCK_SIZE);
+    ccm->mac[0] = (uint8_t)(((params->aad_len != 0u) ? 0x40u : 0u) |
+                            (((params->tag_len - 2u) / 2u) << 3) |
+                            (length_size - 1u));
+    memcpy(&ccm->mac[1], params->nonce, params->nonce_len);
+    for (uint32_t i = 0u; (i < length_size) && (i < sizeof(size_t)); i++)
+    {
+        ccm->mac[AES_CCM_BLOCK_SIZE - 1u - i] = (uint8_t)(len >> (8u * i));
+    }
+    res = ccm_encrypt_block(ccm, ccm->mac, ccm->mac);
+
+    /* Associated data, preceded by its encoded length */
+    aad = params->aad;
+    aad_len = params->aad_len;
+    if ((res == CY_CRYPTOLITE_SUCCESS) && (aad_len != 0u))
+    {
+        if (aad_len < CCM_AAD_LONG_THRESHOLD)
+        {
+            block[0] = (uint8_t)(aad_len >> 8);
+            block[1] = (uint8_t)aad_len;
+            used = 2u;
+        }
+        else
+        {
+            block[0] = 0xFFu;
+            block[1] = 0xFEu;
+            for (uint32_t i = 0u; i < 4u; i++)
+            {
+                block[2u + i] = (uint8_t)((uint64_t)aad_len >> (24u - (8u * i)));
+            }
+            used = 6u;
+        }
+
+        while ((res == CY_CRYPTOLITE_SUCCESS) && ((aad_len != 0u) || (used != 0u)))
+        {
+            fill = AES_CCM_BLOCK_SIZE - used;
+            fill = (aad_len < fill) ? aad_len : fill;
+            memcpy(&block[used], aad, fill);
+            res = ccm_mac_absorb(ccm, block, used + fill);
+            aad += fill;
+            aad_len -= fill;
+            used = 0u;
+        }
+    }
+
+    /* A0 = flags | nonce | 0 */
+    memset(ccm->counter, 0, AES_CCM_BLOCK_SIZE);
+    ccm->counter[0] = (uint8_t)(length_size - 1u);
+    memcpy(&ccm->counter[1], params->nonce, params->nonce_len);
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: ccm_next_keystream
+********************************************************************************
+* Summary: Increments the block index of the counter block and encrypts it.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t ccm_next_keystream(ccm_state_t *ccm,
+                                                    uint8_t *keystream)
+{
+    for (uint32_t i = 0u; i < ccm->length_size; i++)
+    {
+        uint8_t *b = &ccm->counter[AES_CCM_BLOCK_SIZE - 1u - i];
+
+        (*b)++;
+        if (*b != 0u)
+        {
+            break;
+        }
+    }
+    return ccm_encrypt_block(ccm, keystream, ccm->counter);
+}
+
+/*******************************************************************************
+* Function Name: ccm_crypt
+********************************************************************************
+* Summary: Single pass over the message: every block is added to the CBC-MAC
+*          (as plaintext) and XORed with the next keystream block. The tag is
+*          then encrypted with the keystream of A0.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t ccm_crypt(ccm_state_t *ccm, bool encrypt,
+                                           uint8_t *dst, uint8_t const *src,
+                                           size_t len, uint8_t *tag)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+    uint8_t keystream[AES_CCM_BLOCK_SIZE];
+    uint8_t plain[AES_CCM_BLOCK_SIZE];
+
+    while ((res == CY_CRYPTOLITE_SUCCESS) && (len != 0u))
+    {
+        size_t chunk = (len < AES_CCM_BLOCK_SIZE) ? len : AES_CCM_BLOCK_SIZE;
+
+        res = ccm_next_keystream(ccm, keystream);
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            break;
+        }
+        /* Copy first when encrypting: dst may equal src */
+        if (encrypt)
+        {
+            memcpy(plain, src, chunk);
+        }
+        mem_xor(dst, src, keystream, chunk);
+        if (!encrypt)
+        {
+            memcpy(plain, dst, chunk);
+        }
+        res = ccm_mac_absorb(ccm, plain, chunk);
+        dst += chunk;
+        src += chunk;
+        len -= chunk;
+    }
+
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        /* Keystream of A0 */
+        memset(&ccm->counter[AES_CCM_BLOCK_SIZE - ccm->length_size], 0,
+               ccm->length_size);
+        res = ccm_encrypt_block(ccm, keystream, ccm->counter);
+        mem_xor(tag, ccm->mac, keystream, AES_CCM_BLOCK_SIZE);
+    }
+
+    memset(keystream, 0, sizeof(keystream));
+    memset(plain, 0, sizeof(plain));
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_ccm_encrypt
+********************************************************************************
+* Summary: Encrypts len bytes and produces the authentication tag.
+*
+* Parameters:
+*  aes_session_t* session         - Loaded AES session
+*  aes_ccm_params_t const* params - Nonce, associated data and tag length
+*  uint8_t* dst                   - Ciphertext, len bytes; may equal src
+*  uint8_t const* src             - Plaintext, len bytes
+*  size_t len                     - Message length
+*  uint8_t* tag                   - Receives params->tag_len bytes
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_ccm_encrypt(aes_session_t *session,
+                                          aes_ccm_params_t const *params,
+                                          uint8_t *dst, uint8_t const *src,
+                                          size_t len, uint8_t *tag)
+{
+    cy_en_cryptolite_status_t res;
+    ccm_state_t ccm;
+    uint8_t full_tag[AES_CCM_BLOCK_SIZE];
+
+    if ((tag == NULL) || ((len != 0u) && ((dst == NULL) || (src == NULL))))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    res = ccm_start(&ccm, session, params, len);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = ccm_crypt(&ccm, true, dst, src, len, full_tag);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        memcpy(tag, full_tag, params->tag_len);
+    }
+    memset(&ccm, 0, sizeof(ccm));
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_ccm_decrypt
+********************************************************************************
+* Summary: Decrypts len bytes and checks the tag in constant time. When the
+*          tag does not match, the output is wiped and *authentic is false.
+*
+* Parameters:
+*  aes_session_t* session         - Loaded AES session
+*  aes_ccm_params_t const* params - Nonce, associated data and tag length
+*  uint8_t* dst                   - Plaintext, len bytes; may equal src
+*  uint8_t const* src             - Ciphertext, len bytes
+*  size_t len                     - Message length
+*  uint8_t const* tag             - Received tag, params->tag_len bytes
+*  bool* authentic                - Set to the result of the tag check
+*
+* Return:
+*  cy_en_cryptolite_status_t - CY_CRYPTOLITE_SUCCESS also when the tag does
+*                              not match; check *authentic
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_ccm_decrypt(aes_session_t *session,
+                                          aes_ccm_params_t const *params,
+                                          uint8_t *dst, uint8_t const *src,
+                                          size_t len, uint8_t const *tag,
+                                          bool *authentic)
+{
+    cy_en_cryptolite_status_t res;
+    ccm_state_t ccm;
+    uint8_t full_tag[AES_CCM_BLOCK_SIZE];
+    uint8_t diff = 0u;
+
+    if ((tag == NULL) || (authentic == NULL) ||
+        ((len != 0u) && ((dst == NULL) || (src == NULL))))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    *authentic = false;
+
+    res = ccm_start(&ccm, session, params, len);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = ccm_crypt(&ccm, false, dst, src, len, full_tag);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        for (size_t i = 0u; i < params->tag_len; i++)
+        {
+            diff |= full_tag[i] ^ tag[i];
+        }
+        *authentic = (diff == 0u);
+    }
+    if ((!*authentic) && (len != 0u))
+    {
+        memset(dst, 0, len);
+    }
+    memset(&ccm, 0, sizeof(ccm));
+    return res;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,97 @@
+/******************************************************************************
+* File Name: aes_ccm.h
+*
+* Description: AES-128 CCM authenticated encryption (NIST SP 800-38C, RFC 3610)
+* on a loaded AES session. The CBC-MAC and CTR passes are fused into one loop
+* over the data, so each block is read once and both AES operations use the
+* same key context.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_AES_CCM_H_
+#define SOURCE_AES_CCM_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_session.h"
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define AES_CCM_BLOCK_SIZE                   (16u)
+
+/* Valid nonce lengths. The length field takes the remaining 15 - nonce_len
+ * bytes of the counter block, so a 13-byte nonce (as in BLE) limits a
+ * message to 65535 bytes. */
+#define AES_CCM_MIN_NONCE_LENGTH             (7u)
+#define AES_CCM_MAX_NONCE_LENGTH             (13u)
+
+/* Valid tag lengths are the even values 4..16 */
+#define AES_CCM_MIN_TAG_LENGTH               (4u)
+#define AES_CCM_MAX_TAG_LENGTH               (16u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+/* Parameters shared by encryption and decryption */
+typedef struct
+{
+    uint8_t const *nonce;
+    size_t         nonce_len;
+    /* Associated data, authenticated but not encrypted */
+    uint8_t const *aad;
+    size_t         aad_len;
+    size_t         tag_len;
+} aes_ccm_params_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_ccm_encrypt(aes_session_t *session,
+                                          aes_ccm_params_t const *params,
+                                          uint8_t *dst, uint8_t const *src,
+                                          size_t len, uint8_t *tag);
+cy_en_cryptolite_status_t aes_ccm_decrypt(aes_session_t *session,
+                                          aes_ccm_params_t const *params,
+                                          uint8_t *dst, uint8_t const *src,
+                                          size_t len, uint8_t const *tag,
+                                          bool *authentic);
+
+#endif /* SOURCE_AES_CCM_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,286 @@
+/******************************************************************************
+* File Name: aes_cfb.c
+*
+* Description: Incremental AES-128 CFB-128 mode on top of the Cryptolite block.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_cfb.h"
+#include "mem_xor.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: cfb_process_bytes
+********************************************************************************
+* Summary: Processes len bytes through the feedback register a run at a time,
+*          producing a new keystream block whenever a block boundary is
+*          crossed. Within a run the register holds keystream, which turns
+*          into ciphertext by XORing in the plaintext:
+*          encrypt: reg ^= plaintext, dst = reg
+*          decrypt: dst = ciphertext ^ reg, reg ^= dst
+*          Both orders stay correct when dst equals src.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t cfb_process_bytes(aes_cfb_ctx_t *ctx,
+                                                   uint8_t *dst,
+                                                   uint8_t const *src,
+                                                   size_t len)
+{
+    cy_en_cryptolite_status_t res;
+    uint8_t *reg;
+    uint32_t run;
+
+    while (len != 0u)
+    {
+        if (ctx->offset == 0u)
+        {
+            res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, ctx->reg, ctx->reg,
+                                        &ctx->session->state);
+            if (res != CY_CRYPTOLITE_SUCCESS)
+            {
+                return res;
+            }
+        }
+        run = AES_CFB_BLOCK_SIZE - ctx->offset;
+        run = (len < run) ? (uint32_t)len : run;
+        reg = &ctx->reg[ctx->offset];
+
+        if (ctx->dir == CY_CRYPTOLITE_ENCRYPT)
+        {
+            mem_xor(reg, reg, src, run);
+            memcpy(dst, reg, run);
+        }
+        else
+        {
+            mem_xor(dst, src, reg, run);
+            mem_xor(reg, reg, dst, run);
+        }
+
+        ctx->offset = (ctx->offset + run) % AES_CFB_BLOCK_SIZE;
+        dst += run;
+        src += run;
+        len -= run;
+    }
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: aes_cfb_init
+********************************************************************************
+* Summary: Starts a CFB-128 stream under the session's key.
+*
+* Parameters:
+*  aes_cfb_ctx_t* ctx              - Context to initialize
+*  aes_session_t* session          - Loaded AES session
+*  cy_en_cryptolite_dir_mode_t dir - CY_CRYPTOLITE_ENCRYPT or _DECRYPT
+*  uint8_t const* iv               - 16-byte initialization vector
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_cfb_init(aes_cfb_ctx_t *ctx,
+                                       aes_session_t *session,
+                                       cy_en_cryptolite_dir_mode_t dir,
+                                       uint8_t const *iv)
+{
+    if ((ctx == NULL) || (session == NULL) || (iv == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!session->loaded)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    ctx->session = session;
+    ctx->dir = dir;
+    memcpy(ctx->reg, iv, AES_CFB_BLOCK_SIZE);
+    ctx->offset = 0u;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: aes_cfb_update
+********************************************************************************
+* Summary: Encrypts or decrypts the next len bytes of the stream. A partial
+*          block left by the previous call is completed first, whole blocks
+*          are processed by Cy_Cryptolite_Aes_Cfb() and a trailing partial
+*          block is carried in the context. dst may equal src.
+*
+* Parameters:
+*  aes_cfb_ctx_t* ctx - Initialized context
+*  uint8_t* dst       - Output buffer of len bytes
+*  uint8_t const* src - Input buffer of len bytes
+*  size_t len         - Number of bytes to process
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_cfb_update(aes_cfb_ctx_t *ctx, uint8_t *dst,
+                                         uint8_t const *src, size_t len)
+{
+    cy_en_cryptolite_status_t res;
+    uint8_t iv[AES_CFB_BLOCK_SIZE];
+    uint8_t last_ct[AES_CFB_BLOCK_SIZE];
+    size_t head;
+    uint32_t bulk;
+
+    if ((ctx == NULL) || (ctx->session == NULL) ||
+        ((len != 0u) && ((dst == NULL) || (src == NULL))))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    /* Finish the block left open by the previous call */
+    head = (ctx->offset == 0u) ? 0u : (AES_CFB_BLOCK_SIZE - ctx->offset);
+    head = (head < len) ? head : len;
+    res = cfb_process_bytes(ctx, dst, src, head);
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        return res;
+    }
+    dst += head;
+    src += head;
+    len -= head;
+
+    while (len >= AES_CFB_BLOCK_SIZE)
+    {
+        bulk = (len > AES_CFB_MAX_CHUNK) ? AES_CFB_MAX_CHUNK :
+               (uint32_t)(len - (len % AES_CFB_BLOCK_SIZE));
+
+        /* The last ciphertext block becomes the next feedback value. For
+         * in-place decryption it must be saved before it is overwritten. */
+        bool encrypt = (ctx->dir == CY_CRYPTOLITE_ENCRYPT);
+
+        memcpy(last_ct, &src[bulk - AES_CFB_BLOCK_SIZE], AES_CFB_BLOCK_SIZE);
+        memcpy(iv, ctx->reg, AES_CFB_BLOCK_SIZE);
+        res = Cy_Cryptolite_Aes_Cfb(CRYPTOLITE, ctx->dir, bulk, iv, dst, src,
+                                    &ctx->session->state);
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            return res;
+        }
+        if (encrypt)
+        {
+            memcpy(last_ct, &dst[bulk - AES_CFB_BLOCK_SIZE], AES_CFB_BLOCK_SIZE);
+        }
+        memcpy(ctx->reg, last_ct, AES_CFB_BLOCK_SIZE);
+        dst += bulk;
+        src += bulk;
+        len -= bulk;
+    }
+
+    /* Start the trailing partial block and carry it to the next call */
+    return cfb_process_bytes(ctx, dst, src, len);
+}
+
+/*******************************************************************************
+* Function Name: aes_cfb_update_sg
+********************************************************************************
+* Summary: Same as aes_cfb_update() for a stream described by scatter/gather
+*          lists. The segment boundaries of dst and src need not line up; the
+*          runs they have in common are passed to aes_cfb_update() in turn.
+*
+* Parameters:
+*  aes_cfb_ctx_t* ctx   - Initialized context
+*  sg_list_t const* dst - Output segments
+*  sg_list_t const* src - Input segments, same total length as dst
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_cfb_update_sg(aes_cfb_ctx_t *ctx,
+                                            sg_list_t const *dst,
+                                            sg_list_t const *src)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+    sg_cursor_t out;
+    sg_cursor_t in;
+    uint8_t *out_run;
+    uint8_t *in_run;
+    size_t out_len;
+    size_t in_len;
+    size_t run;
+
+    if ((dst == NULL) || (src == NULL) ||
+        (sg_list_length(dst) != sg_list_length(src)))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    sg_cursor_init(&out, dst);
+    sg_cursor_init(&in, src);
+    while (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        out_len = sg_cursor_run(&out, &out_run);
+        in_len = sg_cursor_run(&in, &in_run);
+        run = (out_len < in_len) ? out_len : in_len;
+        if (run == 0u)
+        {
+            break;
+        }
+        res = aes_cfb_update(ctx, out_run, in_run, run);
+        sg_cursor_advance(&out, run);
+        sg_cursor_advance(&in, run);
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_cfb_final
+********************************************************************************
+* Summary: Ends the stream and wipes the feedback register.
+*
+* Parameters:
+*  aes_cfb_ctx_t* ctx - Context to clear
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void aes_cfb_final(aes_cfb_ctx_t *ctx)
+{
+    if (ctx != NULL)
+    {
+        memset(ctx, 0, sizeof(*ctx));
+    }
+}
@@ -0,0 +1,300 @@
+/******************************************************************************
+* File Name: aes_cmac.c
+*
+* Description: AES-128 CMAC, see aes_cmac.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_cmac.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Reduction constant for doubling in GF(2^128) */
+#define CMAC_RB                              (0x87u)
+
+/*******************************************************************************
+* Function Name: cmac_double
+********************************************************************************
+* Summary: dst = src * x in GF(2^128), big-endian bit order.
+*
+*******************************************************************************/
+static void cmac_double(uint8_t *dst, uint8_t const *src)
+{
+    uint8_t carry = (uint8_t)(src[0] >> 7);
+
+    for (uint32_t i = 0u; i < (AES_CMAC_BLOCK_SIZE - 1u); i++)
+    {
+        dst[i] = (uint8_t)((src[i] << 1) | (src[i + 1u] >> 7));
+    }
+    dst[AES_CMAC_BLOCK_SIZE - 1u] =
+        (uint8_t)((src[AES_CMAC_BLOCK_SIZE - 1u] << 1) ^ (carry * CMAC_RB));
+}
+
+/*******************************************************************************
+* Function Name: aes_cmac_setup
+********************************************************************************
+* Summary: Derives the subkeys K1 and K2 from the session's key and binds the
+*          key state to the session. If a different key is loaded into the
+*          session later, the subkeys are derived again on the next
+*          aes_cmac_start().
+*
+* Parameters:
+*  aes_cmac_key_t* key    - Key state to fill
+*  aes_session_t* session - Loaded AES session
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_cmac_setup(aes_cmac_key_t *key,
+                                         aes_session_t *session)
+{
+    cy_en_cryptolite_status_t res;
+    uint8_t l[AES_CMAC_BLOCK_SIZE] = {0u};
+
+    if ((key == NULL) || (session == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!session->loaded)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    /* L = AES(K, 0), K1 = L * x, K2 = L * x^2 */
+    res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, l, l, &session->state);
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        return res;
+    }
+    cmac_double(key->k1, l);
+    cmac_double(key->k2, key->k1);
+
+    key->session = session;
+    key->generation = session->generation;
+    memset(l, 0, sizeof(l));
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: aes_cmac_start
+********************************************************************************
+* Summary: Begins a new MAC computation, refreshing stale subkeys first.
+*
+* Parameters:
+*  aes_cmac_t* cmac    - Computation state
+*  aes_cmac_key_t* key - Key state set up with aes_cmac_setup()
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_cmac_start(aes_cmac_t *cmac,
+                                         aes_cmac_key_t *key)
+{
+    cy_en_cryptolite_status_t res;
+
+    if ((cmac == NULL) || (key == NULL) || (key->session == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!key->session->loaded)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+    if (key->generation != key->session->generation)
+    {
+        res = aes_cmac_setup(key, key->session);
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            return res;
+        }
+    }
+
+    cmac->key = key;
+    memset(cmac->mac, 0, AES_CMAC_BLOCK_SIZE);
+    cmac->used = 0u;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: aes_cmac_update
+********************************************************************************
+* Summary: Absorbs more of the message. A full block is encrypted only once
+*          further data shows it is not the last one.
+*
+* Parameters:
+*  aes_cmac_t* cmac    - Computation state
+*  uint8_t const* data - Message bytes
+*  size_t len          - Number of bytes
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_cmac_update(aes_cmac_t *cmac,
+                                          uint8_t const *data, size_t len)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+
+    if ((cmac == NULL) || (cmac->key == NULL) ||
+        ((len != 0u) && (data == NULL)))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    while ((res == CY_CRYPTOLITE_SUCCESS) && (len != 0u))
+    {
+        if (cmac->used == AES_CMAC_BLOCK_SIZE)
+        {
+            res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, cmac->mac, cmac->mac,
+                                        &cmac->key->session->state);
+            cmac->used = 0u;
+        }
+        while ((cmac->used < AES_CMAC_BLOCK_SIZE) && (len != 0u))
+        {
+            cmac->mac[cmac->used++] ^= *data++;
+            len--;
+        }
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_cmac_finish
+********************************************************************************
+* Summary: Applies K1 to a complete last block, or pads a partial one and
+*          applies K2, and produces the MAC.
+*
+* Parameters:
+*  aes_cmac_t* cmac - Computation state
+*  uint8_t* mac     - AES_CMAC_MAC_SIZE bytes of output
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_cmac_finish(aes_cmac_t *cmac, uint8_t *mac)
+{
+    cy_en_cryptolite_status_t res;
+    uint8_t const *subkey;
+
+    if ((cmac == NULL) || (cmac->key == NULL) || (mac == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    if (cmac->used == AES_CMAC_BLOCK_SIZE)
+    {
+        subkey = cmac->key->k1;
+    }
+    else
+    {
+        cmac->mac[cmac->used] ^= 0x80u;
+        subkey = cmac->key->k2;
+    }
+    for (uint32_t i = 0u; i < AES_CMAC_BLOCK_SIZE; i++)
+    {
+        cmac->mac[i] ^= subkey[i];
+    }
+
+    res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, mac, cmac->mac,
+                                &cmac->key->session->state);
+    memset(cmac->mac, 0, AES_CMAC_BLOCK_SIZE);
+    cmac->used = 0u;
+    cmac->key = NULL;
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_cmac
+********************************************************************************
+* Summary: Computes the MAC of a contiguous message in one call.
+*
+* Parameters:
+*  aes_cmac_key_t* key - Key state set up with aes_cmac_setup()
+*  uint8_t const* data - Message
+*  size_t len          - Message length
+*  uint8_t* mac        - AES_CMAC_MAC_SIZE bytes of output
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_cmac(aes_cmac_key_t *key, uint8_t const *data,
+                                   size_t len, uint8_t *mac)
+{
+    cy_en_cryptolite_status_t res;
+    aes_cmac_t cmac;
+
+    res = aes_cmac_start(&cmac, key);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = aes_cmac_update(&cmac, data, len);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = aes_cmac_finish(&cmac, mac);
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_cmac_clear
+********************************************************************************
+* Summary: Wipes the subkeys.
+*
+* Parameters:
+*  aes_cmac_key_t* key - Key state to clear
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void aes_cmac_clear(aes_cmac_key_t *key)
+{
+    if (key != NULL)
+    {
+        memset(key, 0, sizeof(*key));
+    }
+}
+
+/* [] END OF FILE */
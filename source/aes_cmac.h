@@ -0,0 +1,99 @@
+/******************************************************************************
+* File Name: aes_cmac.h
+*
+* Description: AES-128 CMAC (NIST SP 800-38B, RFC 4493) on a loaded AES
+* session. The K1/K2 subkeys are derived once per key and kept with the key
+* state, so each MAC only costs one AES block operation per 16 bytes of
+* message.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_AES_CMAC_H_
+#define SOURCE_AES_CMAC_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_session.h"
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define AES_CMAC_BLOCK_SIZE                  (16u)
+#define AES_CMAC_MAC_SIZE                    (16u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+/* Per-key CMAC state */
+typedef struct
+{
+    aes_session_t *session;
+    /* session->generation the subkeys were derived for */
+    uint32_t       generation;
+    uint8_t        k1[AES_CMAC_BLOCK_SIZE];
+    uint8_t        k2[AES_CMAC_BLOCK_SIZE];
+} aes_cmac_key_t;
+
+/* Incremental MAC computation. The message bytes are XORed straight into
+ * the chaining value; the last block is only encrypted by aes_cmac_finish()
+ * because it needs the subkey. */
+typedef struct
+{
+    aes_cmac_key_t *key;
+    uint8_t         mac[AES_CMAC_BLOCK_SIZE];
+    /* Bytes of the current block absorbed so far, 0..16 */
+    size_t          used;
+} aes_cmac_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_cmac_setup(aes_cmac_key_t *key,
+                                         aes_session_t *session);
+cy_en_cryptolite_status_t aes_cmac_start(aes_cmac_t *cmac,
+                                         aes_cmac_key_t *key);
+cy_en_cryptolite_status_t aes_cmac_update(aes_cmac_t *cmac,
+                                          uint8_t const *data, size_t len);
+cy_en_cryptolite_status_t aes_cmac_finish(aes_cmac_t *cmac, uint8_t *mac);
+cy_en_cryptolite_status_t aes_cmac(aes_cmac_key_t *key, uint8_t const *data,
+                                   size_t len, uint8_t *mac);
+void aes_cmac_clear(aes_cmac_key_t *key);
+
+#endif /* SOURCE_AES_CMAC_H_ */
+
+/* [] END OF FILE */
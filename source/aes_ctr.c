@@ -0,0 +1,247 @@
+/******************************************************************************
+* File Name: aes_ctr.c
+*
+* Description: Incremental AES-128 CTR mode on top of the Cryptolite block.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_ctr.h"
+#include "mem_xor.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: ctr_increment
+********************************************************************************
+* Summary: Increments the 128-bit big-endian counter block the same way
+*          Cy_Cryptolite_Aes_Ctr() does.
+*
+*******************************************************************************/
+static void ctr_increment(uint8_t counter[AES_CTR_BLOCK_SIZE])
+{
+    for (int32_t i = AES_CTR_BLOCK_SIZE - 1; i >= 0; i--)
+    {
+        counter[i]++;
+        if (counter[i] != 0u)
+        {
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: aes_ctr_init
+********************************************************************************
+* Summary: Starts a CTR stream under the session's key.
+*
+* Parameters:
+*  aes_ctr_ctx_t* ctx     - Context to initialize
+*  aes_session_t* session - Loaded AES session
+*  uint8_t const* iv      - Initial 16-byte counter block
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_ctr_init(aes_ctr_ctx_t *ctx,
+                                       aes_session_t *session,
+                                       uint8_t const *iv)
+{
+    if ((ctx == NULL) || (session == NULL) || (iv == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!session->loaded)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    ctx->session = session;
+    memcpy(ctx->counter, iv, AES_CTR_BLOCK_SIZE);
+    ctx->offset = 0u;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: aes_ctr_update
+********************************************************************************
+* Summary: Encrypts or decrypts the next len bytes of the stream. Leftover
+*          keystream from the previous call is used first, whole blocks are
+*          processed by Cy_Cryptolite_Aes_Ctr() and a trailing partial block
+*          is kept in the context for the next call. dst may equal src.
+*
+* Parameters:
+*  aes_ctr_ctx_t* ctx - Initialized context
+*  uint8_t* dst       - Output buffer of len bytes
+*  uint8_t const* src - Input buffer of len bytes
+*  size_t len         - Number of bytes to process
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_ctr_update(aes_ctr_ctx_t *ctx, uint8_t *dst,
+                                         uint8_t const *src, size_t len)
+{
+    cy_en_cryptolite_status_t res;
+    uint32_t bulk;
+    uint32_t run;
+    uint32_t src_offset = 0u;
+
+    if ((ctx == NULL) || (ctx->session == NULL) ||
+        ((len != 0u) && ((dst == NULL) || (src == NULL))))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    /* Finish the keystream block left over by the previous call */
+    if (ctx->offset != 0u)
+    {
+        run = AES_CTR_BLOCK_SIZE - ctx->offset;
+        run = (len < run) ? (uint32_t)len : run;
+        mem_xor(dst, src, &ctx->stream_block[ctx->offset], run);
+        ctx->offset = (ctx->offset + run) % AES_CTR_BLOCK_SIZE;
+        dst += run;
+        src += run;
+        len -= run;
+    }
+
+    while (len >= AES_CTR_BLOCK_SIZE)
+    {
+        bulk = (len > AES_CTR_MAX_CHUNK) ? AES_CTR_MAX_CHUNK :
+               (uint32_t)(len - (len % AES_CTR_BLOCK_SIZE));
+        res = Cy_Cryptolite_Aes_Ctr(CRYPTOLITE, bulk, &src_offset, ctx->counter,
+                                    dst, src, &ctx->session->state);
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            return res;
+        }
+        dst += bulk;
+        src += bulk;
+        len -= bulk;
+    }
+
+    if (len != 0u)
+    {
+        res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, ctx->stream_block, ctx->counter,
+                                    &ctx->session->state);
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            return res;
+        }
+        ctr_increment(ctx->counter);
+
+        mem_xor(dst, src, ctx->stream_block, len);
+        ctx->offset = (uint32_t)len;
+    }
+
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: aes_ctr_update_sg
+********************************************************************************
+* Summary: Same as aes_ctr_update() for a stream described by scatter/gather
+*          lists. The segment boundaries of dst and src need not line up; the
+*          runs they have in common are passed to aes_ctr_update() in turn.
+*
+* Parameters:
+*  aes_ctr_ctx_t* ctx   - Initialized context
+*  sg_list_t const* dst - Output segments
+*  sg_list_t const* src - Input segments, same total length as dst
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_ctr_update_sg(aes_ctr_ctx_t *ctx,
+                                            sg_list_t const *dst,
+                                            sg_list_t const *src)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+    sg_cursor_t out;
+    sg_cursor_t in;
+    uint8_t *out_run;
+    uint8_t *in_run;
+    size_t out_len;
+    size_t in_len;
+    size_t run;
+
+    if ((dst == NULL) || (src == NULL) ||
+        (sg_list_length(dst) != sg_list_length(src)))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    sg_cursor_init(&out, dst);
+    sg_cursor_init(&in, src);
+    while (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        out_len = sg_cursor_run(&out, &out_run);
+        in_len = sg_cursor_run(&in, &in_run);
+        run = (out_len < in_len) ? out_len : in_len;
+        if (run == 0u)
+        {
+            break;
+        }
+        res = aes_ctr_update(ctx, out_run, in_run, run);
+        sg_cursor_advance(&out, run);
+        sg_cursor_advance(&in, run);
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_ctr_final
+********************************************************************************
+* Summary: Ends the stream and wipes the counter and leftover keystream.
+*
+* Parameters:
+*  aes_ctr_ctx_t* ctx - Context to clear
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void aes_ctr_final(aes_ctr_ctx_t *ctx)
+{
+    if (ctx != NULL)
+    {
+        memset(ctx, 0, sizeof(*ctx));
+    }
+}
@@ -0,0 +1,88 @@
+/******************************************************************************
+* File Name: aes_ctr.h
+*
+* Description: Incremental AES-128 CTR mode on top of the Cryptolite block. The
+* context carries the counter block and the offset into the current keystream
+* block between calls, so a stream of any length can be processed chunk by
+* chunk in constant RAM with no alignment requirement on the chunk sizes.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_AES_CTR_H_
+#define SOURCE_AES_CTR_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_session.h"
+#include "sg_list.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define AES_CTR_BLOCK_SIZE                   (16u)
+
+/* Largest run handed to a single PDL call, whose length is 32-bit */
+#define AES_CTR_MAX_CHUNK                    (0xFFFFFFF0u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef struct
+{
+    aes_session_t *session;
+    /* Counter value for the next keystream block */
+    uint8_t        counter[AES_CTR_BLOCK_SIZE];
+    /* Keystream of the counter value before 'counter' */
+    uint8_t        stream_block[AES_CTR_BLOCK_SIZE];
+    /* Number of stream_block bytes already used (srcOffset of the PDL) */
+    uint32_t       offset;
+} aes_ctr_ctx_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_ctr_init(aes_ctr_ctx_t *ctx,
+                                       aes_session_t *session,
+                                       uint8_t const *iv);
+cy_en_cryptolite_status_t aes_ctr_update(aes_ctr_ctx_t *ctx, uint8_t *dst,
+                                         uint8_t const *src, size_t len);
+cy_en_cryptolite_status_t aes_ctr_update_sg(aes_ctr_ctx_t *ctx,
+                                            sg_list_t const *dst,
+                                            sg_list_t const *src);
+void aes_ctr_final(aes_ctr_ctx_t *ctx);
+
+#endif /* SOURCE_AES_CTR_H_ */
@@ -0,0 +1,303 @@
+/******************************************************************************
+* File Name: aes_ctr_cache.c
+*
+* Description: Precomputed AES CTR keystream, see aes_ctr_cache.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_ctr_cache.h"
+#include "mem_xor.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: cache_current
+********************************************************************************
+* Summary: Tells whether the cached keystream still belongs to the key now
+*          loaded into the bound session.
+*
+*******************************************************************************/
+static bool cache_current(aes_ctr_cache_t const *cache)
+{
+    return (cache->session != NULL) && cache->session->loaded &&
+           (cache->generation == cache->session->generation);
+}
+
+/*******************************************************************************
+* Function Name: cache_reset
+********************************************************************************
+* Summary: Drops the keystream and restarts generation at the IV.
+*
+*******************************************************************************/
+static void cache_reset(aes_ctr_cache_t *cache)
+{
+    if (cache->blocks != 0u)
+    {
+        memset(cache->keystream, 0, cache->blocks * AES_CTR_BLOCK_SIZE);
+    }
+    memcpy(cache->counter, cache->iv, AES_CTR_BLOCK_SIZE);
+    cache->generation = cache->session->generation;
+    cache->blocks = 0u;
+}
+
+/*******************************************************************************
+* Function Name: aes_ctr_cache_init
+********************************************************************************
+* Summary: Sets up an empty cache on caller-provided storage.
+*
+* Parameters:
+*  aes_ctr_cache_t* cache - Cache to initialize
+*  uint8_t* buffer        - Storage of blocks * AES_CTR_BLOCK_SIZE bytes
+*  size_t blocks          - Number of keystream blocks to keep
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void aes_ctr_cache_init(aes_ctr_cache_t *cache, uint8_t *buffer,
+                        size_t blocks)
+{
+    if (cache != NULL)
+    {
+        memset(cache, 0, sizeof(*cache));
+        cache->keystream = buffer;
+        cache->capacity = (buffer != NULL) ? blocks : 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: aes_ctr_cache_prepare
+********************************************************************************
+* Summary: Selects the session and IV to generate keystream for. Keystream
+*          already cached for the same session, key and IV is kept.
+*
+* Parameters:
+*  aes_ctr_cache_t* cache - Initialized cache
+*  aes_session_t* session - Loaded AES session
+*  uint8_t const* iv      - Initial 16-byte counter block
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_ctr_cache_prepare(aes_ctr_cache_t *cache,
+                                                aes_session_t *session,
+                                                uint8_t const *iv)
+{
+    if ((cache == NULL) || (session == NULL) || (iv == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!session->loaded)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    if ((cache->session != session) || !cache_current(cache) ||
+        (memcmp(cache->iv, iv, AES_CTR_BLOCK_SIZE) != 0))
+    {
+        cache->session = session;
+        memcpy(cache->iv, iv, AES_CTR_BLOCK_SIZE);
+        cache_reset(cache);
+    }
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: aes_ctr_cache_pending
+********************************************************************************
+* Summary: Tells whether aes_ctr_cache_fill() has work to do: the cache is
+*          prepared and either not yet full or generated with a key that has
+*          since been replaced.
+*
+* Parameters:
+*  aes_ctr_cache_t const* cache - Cache to check
+*
+* Return:
+*  bool - True if more keystream can be generated
+*
+*******************************************************************************/
+bool aes_ctr_cache_pending(aes_ctr_cache_t const *cache)
+{
+    return (cache != NULL) && (cache->session != NULL) &&
+           cache->session->loaded &&
+           (!cache_current(cache) || (cache->blocks < cache->capacity));
+}
+
+/*******************************************************************************
+* Function Name: aes_ctr_cache_fill
+********************************************************************************
+* Summary: Generates up to max_blocks further keystream blocks. Keeping
+*          max_blocks small bounds the time spent per call when filling from
+*          an idle loop.
+*
+* Parameters:
+*  aes_ctr_cache_t* cache - Prepared cache
+*  size_t max_blocks      - Most blocks to generate in this call
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_ctr_cache_fill(aes_ctr_cache_t *cache,
+                                             size_t max_blocks)
+{
+    cy_en_cryptolite_status_t res;
+    uint32_t offset = 0u;
+    uint8_t *stream;
+    size_t count;
+
+    if (!aes_ctr_cache_pending(cache))
+    {
+        return (cache == NULL) ? CY_CRYPTOLITE_BAD_PARAMS
+                               : CY_CRYPTOLITE_SUCCESS;
+    }
+    if (!cache_current(cache))
+    {
+        cache_reset(cache);
+    }
+
+    count = cache->capacity - cache->blocks;
+    count = (max_blocks < count) ? max_blocks : count;
+    if (count == 0u)
+    {
+        return CY_CRYPTOLITE_SUCCESS;
+    }
+
+    /* Keystream is the encryption of zeros */
+    stream = &cache->keystream[cache->blocks * AES_CTR_BLOCK_SIZE];
+    memset(stream, 0, count * AES_CTR_BLOCK_SIZE);
+    res = Cy_Cryptolite_Aes_Ctr(CRYPTOLITE,
+                                (uint32_t)(count * AES_CTR_BLOCK_SIZE),
+                                &offset, cache->counter, stream, stream,
+                                &cache->session->state);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        cache->blocks += count;
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_ctr_cache_crypt
+********************************************************************************
+* Summary: Encrypts or decrypts a whole message in CTR mode, like
+*          aes_ctr_init() and aes_ctr_update(). If the cache holds keystream
+*          for this session, key and IV, the covered part of the message is
+*          XORed with it and only the rest is run through the Cryptolite
+*          block. The cache is not consumed. dst may equal src.
+*
+* Parameters:
+*  aes_ctr_cache_t* cache - Initialized cache
+*  aes_session_t* session - Loaded AES session
+*  uint8_t const* iv      - Initial 16-byte counter block
+*  uint8_t* dst           - Output buffer of len bytes
+*  uint8_t const* src     - Input buffer of len bytes
+*  size_t len             - Number of bytes to process
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_ctr_cache_crypt(aes_ctr_cache_t *cache,
+                                              aes_session_t *session,
+                                              uint8_t const *iv,
+                                              uint8_t *dst,
+                                              uint8_t const *src, size_t len)
+{
+    cy_en_cryptolite_status_t res;
+    aes_ctr_ctx_t ctr_ctx;
+    uint8_t const *counter = iv;
+    size_t cached = 0u;
+
+    if ((cache == NULL) || (session == NULL) || (iv == NULL) ||
+        ((len != 0u) && ((dst == NULL) || (src == NULL))))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    if ((cache->session == session) && cache_current(cache) &&
+        (memcmp(cache->iv, iv, AES_CTR_BLOCK_SIZE) == 0))
+    {
+        cached = cache->blocks * AES_CTR_BLOCK_SIZE;
+        cached = (len < cached) ? len : cached;
+        mem_xor(dst, src, cache->keystream, cached);
+        /* Whole blocks were used, so the rest starts at the next counter */
+        counter = cache->counter;
+    }
+    if (cached == len)
+    {
+        return CY_CRYPTOLITE_SUCCESS;
+    }
+
+    res = aes_ctr_init(&ctr_ctx, session, counter);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = aes_ctr_update(&ctr_ctx, &dst[cached], &src[cached],
+                             len - cached);
+    }
+    aes_ctr_final(&ctr_ctx);
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_ctr_cache_clear
+********************************************************************************
+* Summary: Wipes the keystream and unbinds the cache; the storage stays
+*          attached.
+*
+* Parameters:
+*  aes_ctr_cache_t* cache - Cache to clear
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void aes_ctr_cache_clear(aes_ctr_cache_t *cache)
+{
+    if (cache != NULL)
+    {
+        aes_ctr_cache_init(cache, cache->keystream, cache->capacity);
+        if (cache->keystream != NULL)
+        {
+            memset(cache->keystream, 0, cache->capacity * AES_CTR_BLOCK_SIZE);
+        }
+    }
+}
+
+/* [] END OF FILE */
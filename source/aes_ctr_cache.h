@@ -0,0 +1,95 @@
+/******************************************************************************
+* File Name: aes_ctr_cache.h
+*
+* Description: Precomputed AES CTR keystream. The keystream depends only on the
+* key and the initial counter block, so it can be generated ahead of time, for
+* example while waiting for user input. An encryption or decryption with the
+* same key and IV is then an XOR against the ready buffer, and only the part of
+* a message beyond the cached blocks goes through the Cryptolite block.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_AES_CTR_CACHE_H_
+#define SOURCE_AES_CTR_CACHE_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_ctr.h"
+#include <stddef.h>
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+/* The cached keystream is only used for the IV it was generated from. As
+ * with plain CTR, encrypting different messages under one key and IV reuses
+ * the keystream; choosing IVs is up to the caller. */
+typedef struct
+{
+    aes_session_t *session;
+    /* session->generation the keystream was generated with */
+    uint32_t       generation;
+    uint8_t        iv[AES_CTR_BLOCK_SIZE];
+    /* Counter block of the next keystream block to generate */
+    uint8_t        counter[AES_CTR_BLOCK_SIZE];
+    /* Caller-provided storage of capacity blocks */
+    uint8_t       *keystream;
+    size_t         capacity;
+    /* Blocks generated so far */
+    size_t         blocks;
+} aes_ctr_cache_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void aes_ctr_cache_init(aes_ctr_cache_t *cache, uint8_t *buffer,
+                        size_t blocks);
+cy_en_cryptolite_status_t aes_ctr_cache_prepare(aes_ctr_cache_t *cache,
+                                                aes_session_t *session,
+                                                uint8_t const *iv);
+bool aes_ctr_cache_pending(aes_ctr_cache_t const *cache);
+cy_en_cryptolite_status_t aes_ctr_cache_fill(aes_ctr_cache_t *cache,
+                                             size_t max_blocks);
+cy_en_cryptolite_status_t aes_ctr_cache_crypt(aes_ctr_cache_t *cache,
+                                              aes_session_t *session,
+                                              uint8_t const *iv,
+                                              uint8_t *dst,
+                                              uint8_t const *src, size_t len);
+void aes_ctr_cache_clear(aes_ctr_cache_t *cache);
+
+#endif /* SOURCE_AES_CTR_CACHE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,567 @@
+/******************************************************************************
+* File Name: aes_gcm.c
+*
+* Description: AES-128 GCM, see aes_gcm.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_gcm.h"
+#include <string.h>
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Reduction of the bits shifted out of a field element when multiplying it by
+ * x^AES_GCM_GHASH_TABLE_BITS, aligned to the top 16 bits */
+#if (AES_GCM_GHASH_TABLE_BITS == 8u)
+static const uint16_t ghash_reduce[256] =
+{
+    0x0000u, 0x01C2u, 0x0384u, 0x0246u, 0x0708u, 0x06CAu, 0x048Cu, 0x054Eu,
+    0x0E10u, 0x0FD2u, 0x0D94u, 0x0C56u, 0x0918u, 0x08DAu, 0x0A9Cu, 0x0B5Eu,
+    0x1C20u, 0x1DE2u, 0x1FA4u, 0x1E66u, 0x1B28u, 0x1AEAu, 0x18ACu, 0x196Eu,
+    0x1230u, 0x13F2u, 0x11B4u, 0x1076u, 0x1538u, 0x14FAu, 0x16BCu, 0x177Eu,
+    0x3840u, 0x3982u, 0x3BC4u, 0x3A06u, 0x3F48u, 0x3E8Au, 0x3CCCu, 0x3D0Eu,
+    0x3650u, 0x3792u, 0x35D4u, 0x3416u, 0x3158u, 0x309Au, 0x32DCu, 0x331Eu,
+    0x2460u, 0x25A2u, 0x27E4u, 0x2626u, 0x2368u, 0x22AAu, 0x20ECu, 0x212Eu,
+    0x2A70u, 0x2BB2u, 0x29F4u, 0x2836u, 0x2D78u, 0x2CBAu, 0x2EFCu, 0x2F3Eu,
+    0x7080u, 0x7142u, 0x7304u, 0x72C6u, 0x7788u, 0x764Au, 0x740Cu, 0x75CEu,
+    0x7E90u, 0x7F52u, 0x7D14u, 0x7CD6u, 0x7998u, 0x785Au, 0x7A1Cu, 0x7BDEu,
+    0x6CA0u, 0x6D62u, 0x6F24u, 0x6EE6u, 0x6BA8u, 0x6A6Au, 0x682Cu, 0x69EEu,
+    0x62B0u, 0x6372u, 0x6134u, 0x60F6u, 0x65B8u, 0x647Au, 0x663Cu, 0x67FEu,
+    0x48C0u, 0x4902u, 0x4B44u, 0x4A86u, 0x4FC8u, 0x4E0Au, 0x4C4Cu, 0x4D8Eu,
+    0x46D0u, 0x4712u, 0x4554u, 0x4496u, 0x41D8u, 0x401Au, 0x425Cu, 0x439Eu,
+    0x54E0u, 0x5522u, 0x5764u, 0x56A6u, 0x53E8u, 0x522Au, 0x506Cu, 0x51AEu,
+    0x5AF0u, 0x5B32u, 0x5974u, 0x58B6u, 0x5DF8u, 0x5C3Au, 0x5E7Cu, 0x5FBEu,
+    0xE100u, 0xE0C2u, 0xE284u, 0xE346u, 0xE608u, 0xE7CAu, 0xE58Cu, 0xE44Eu,
+    0xEF10u, 0xEED2u, 0xEC94u, 0xED56u, 0xE818u, 0xE9DAu, 0xEB9Cu, 0xEA5Eu,
+    0xFD20u, 0xFCE2u, 0xFEA4u, 0xFF66u, 0xFA28u, 0xFBEAu, 0xF9ACu, 0xF86Eu,
+    0xF330u, 0xF2F2u, 0xF0B4u, 0xF176u, 0xF438u, 0xF5FAu, 0xF7BCu, 0xF67Eu,
+    0xD940u, 0xD882u, 0xDAC4u, 0xDB06u, 0xDE48u, 0xDF8Au, 0xDDCCu, 0xDC0Eu,
+    0xD750u, 0xD692u, 0xD4D4u, 0xD516u, 0xD058u, 0xD19Au, 0xD3DCu, 0xD21Eu,
+    0xC560u, 0xC4A2u, 0xC6E4u, 0xC726u, 0xC268u, 0xC3AAu, 0xC1ECu, 0xC02Eu,
+    0xCB70u, 0xCAB2u, 0xC8F4u, 0xC936u, 0xCC78u, 0xCDBAu, 0xCFFCu, 0xCE3Eu,
+    0x9180u, 0x9042u, 0x9204u, 0x93C6u, 0x9688u, 0x974Au, 0x950Cu, 0x94CEu,
+    0x9F90u, 0x9E52u, 0x9C14u, 0x9DD6u, 0x9898u, 0x995Au, 0x9B1Cu, 0x9ADEu,
+    0x8DA0u, 0x8C62u, 0x8E24u, 0x8FE6u, 0x8AA8u, 0x8B6Au, 0x892Cu, 0x88EEu,
+    0x83B0u, 0x8272u, 0x8034u, 0x81F6u, 0x84B8u, 0x857Au, 0x873Cu, 0x86FEu,
+    0xA9C0u, 0xA802u, 0xAA44u, 0xAB86u, 0xAEC8u, 0xAF0Au, 0xAD4Cu, 0xAC8Eu,
+    0xA7D0u, 0xA612u, 0xA454u, 0xA596u, 0xA0D8u, 0xA11Au, 0xA35Cu, 0xA29Eu,
+    0xB5E0u, 0xB422u, 0xB664u, 0xB7A6u, 0xB2E8u, 0xB32Au, 0xB16Cu, 0xB0AEu,
+    0xBBF0u, 0xBA32u, 0xB874u, 0xB9B6u, 0xBCF8u, 0xBD3Au, 0xBF7Cu, 0xBEBEu,
+};
+#else
+static const uint16_t ghash_reduce[16] =
+{
+    0x0000u, 0x1C20u, 0x3840u, 0x2460u, 0x7080u, 0x6CA0u, 0x48C0u, 0x54E0u,
+    0xE100u, 0xFD20u, 0xD940u, 0xC560u, 0x9180u, 0x8DA0u, 0xA9C0u, 0xB5E0u,
+};
+#endif
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef struct
+{
+    aes_gcm_key_t *key;
+    /* GHASH accumulator */
+    uint8_t        ghash[AES_GCM_BLOCK_SIZE];
+    /* Pre-counter block J0 */
+    uint8_t        j0[AES_GCM_BLOCK_SIZE];
+} gcm_state_t;
+
+/*******************************************************************************
+* Function Name: load_be64 / store_be64
+********************************************************************************
+* Summary: Big-endian conversion between bytes and 64-bit words.
+*
+*******************************************************************************/
+static uint64_t load_be64(uint8_t const *p)
+{
+    uint64_t v = 0u;
+
+    for (uint32_t i = 0u; i < 8u; i++)
+    {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static void store_be64(uint8_t *p, uint64_t v)
+{
+    for (uint32_t i = 0u; i < 8u; i++)
+    {
+        p[7u - i] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ghash_multiply
+********************************************************************************
+* Summary: x = x * H in GF(2^128), one table entry per AES_GCM_GHASH_TABLE_BITS
+*          bits of x starting from the last byte.
+*
+*******************************************************************************/
+static void ghash_multiply(aes_gcm_key_t const *key,
+                           uint8_t x[AES_GCM_BLOCK_SIZE])
+{
+    uint64_t zh = 0u;
+    uint64_t zl = 0u;
+    uint32_t rem;
+
+    for (int32_t i = AES_GCM_BLOCK_SIZE - 1; i >= 0; i--)
+    {
+#if (AES_GCM_GHASH_TABLE_BITS == 8u)
+        rem = (uint32_t)(zl & 0xFFu);
+        zl = (zh << 56) | (zl >> 8);
+        zh = (zh >> 8) ^ ((uint64_t)ghash_reduce[rem] << 48);
+        zh ^= key->table_hi[x[i]];
+        zl ^= key->table_lo[x[i]];
+#else
+        uint32_t nibble_lo = x[i] & 0x0Fu;
+        uint32_t nibble_hi = x[i] >> 4;
+
+        rem = (uint32_t)(zl & 0x0Fu);
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ ((uint64_t)ghash_reduce[rem] << 48);
+        zh ^= key->table_hi[nibble_lo];
+        zl ^= key->table_lo[nibble_lo];
+
+        rem = (uint32_t)(zl & 0x0Fu);
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ ((uint64_t)ghash_reduce[rem] << 48);
+        zh ^= key->table_hi[nibble_hi];
+        zl ^= key->table_lo[nibble_hi];
+#endif
+    }
+
+    store_be64(&x[0], zh);
+    store_be64(&x[8], zl);
+}
+
+/*******************************************************************************
+* Function Name: ghash_update
+********************************************************************************
+* Summary: Absorbs data into the GHASH accumulator. A trailing partial block
+*          is zero padded, as GCM pads the AAD and the ciphertext separately.
+*
+*******************************************************************************/
+static void ghash_update(gcm_state_t *gcm, uint8_t const *data, size_t len)
+{
+    while (len != 0u)
+    {
+        size_t chunk = (len < AES_GCM_BLOCK_SIZE) ? len : AES_GCM_BLOCK_SIZE;
+
+        for (size_t i = 0u; i < chunk; i++)
+        {
+            gcm->ghash[i] ^= data[i];
+        }
+        ghash_multiply(gcm->key, gcm->ghash);
+        data += chunk;
+        len -= chunk;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ghash_lengths
+********************************************************************************
+* Summary: Absorbs the final block holding the two bit lengths.
+*
+*******************************************************************************/
+static void ghash_lengths(gcm_state_t *gcm, uint64_t first_len,
+                          uint64_t second_len)
+{
+    uint8_t block[AES_GCM_BLOCK_SIZE];
+
+    store_be64(&block[0], first_len * 8u);
+    store_be64(&block[8], second_len * 8u);
+    ghash_update(gcm, block, sizeof(block));
+}
+
+/*******************************************************************************
+* Function Name: aes_gcm_setup
+********************************************************************************
+* Summary: Derives the hash subkey H = E(K, 0) and the GHASH tables for the
+*          session's current key. The tables are rederived automatically when
+*          a different key is later loaded into the session.
+*
+* Parameters:
+*  aes_gcm_key_t* key     - Key state to fill
+*  aes_session_t* session - Loaded AES session
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_gcm_setup(aes_gcm_key_t *key,
+                                        aes_session_t *session)
+{
+    cy_en_cryptolite_status_t res;
+    uint8_t h[AES_GCM_BLOCK_SIZE] = {0u};
+    uint64_t vh;
+    uint64_t vl;
+
+    if ((key == NULL) || (session == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!session->loaded)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, h, h, &session->state);
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        return res;
+    }
+
+    /* The entry with only the top bit set is H itself; each lower single-bit
+     * entry is the previous one times x. All others are XOR combinations. */
+    vh = load_be64(&h[0]);
+    vl = load_be64(&h[8]);
+    key->table_hi[0] = 0u;
+    key->table_lo[0] = 0u;
+    for (uint32_t i = AES_GCM_GHASH_TABLE_SIZE / 2u; i > 0u; i >>= 1)
+    {
+        uint64_t carry = vl & 1u;
+
+        key->table_hi[i] = vh;
+        key->table_lo[i] = vl;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ (carry * 0xE100000000000000u);
+    }
+    for (uint32_t i = 2u; i < AES_GCM_GHASH_TABLE_SIZE; i <<= 1)
+    {
+        for (uint32_t j = 1u; j < i; j++)
+        {
+            key->table_hi[i + j] = key->table_hi[i] ^ key->table_hi[j];
+            key->table_lo[i + j] = key->table_lo[i] ^ key->table_lo[j];
+        }
+    }
+
+    key->session = session;
+    key->generation = session->generation;
+    memset(h, 0, sizeof(h));
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: tag_len_valid
+********************************************************************************
+* Summary: Tells whether tag_len is one of the tag lengths SP 800-38D allows.
+*
+*******************************************************************************/
+static bool tag_len_valid(size_t tag_len)
+{
+    return ((tag_len >= AES_GCM_MIN_FULL_TAG_LENGTH) &&
+            (tag_len <= AES_GCM_MAX_TAG_LENGTH)) ||
+           (tag_len == AES_GCM_SHORT_TAG_LENGTH) ||
+           (tag_len == AES_GCM_MIN_TAG_LENGTH);
+}
+
+/*******************************************************************************
+* Function Name: gcm_start
+********************************************************************************
+* Summary: Checks the parameters, refreshes stale tables, forms J0 and
+*          absorbs the associated data.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t gcm_start(gcm_state_t *gcm,
+                                           aes_gcm_key_t *key,
+                                           aes_gcm_params_t const *params)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+
+    if ((key == NULL) || (key->session == NULL) || (params == NULL) ||
+        (params->iv == NULL) || (params->iv_len == 0u) ||
+        ((params->aad_len != 0u) && (params->aad == NULL)) ||
+        !tag_len_valid(params->tag_len))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!key->session->loaded)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+    if (key->generation != key->session->generation)
+    {
+        res = aes_gcm_setup(key, key->session);
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            return res;
+        }
+    }
+
+    gcm->key = key;
+    memset(gcm->ghash, 0, AES_GCM_BLOCK_SIZE);
+    if (params->iv_len == AES_GCM_DEFAULT_IV_LENGTH)
+    {
+        memcpy(gcm->j0, params->iv, AES_GCM_DEFAULT_IV_LENGTH);
+        memset(&gcm->j0[AES_GCM_DEFAULT_IV_LENGTH], 0,
+               AES_GCM_BLOCK_SIZE - AES_GCM_DEFAULT_IV_LENGTH);
+        gcm->j0[AES_GCM_BLOCK_SIZE - 1u] = 1u;
+    }
+    else
+    {
+        /* J0 = GHASH(IV || pad || 0^64 || bit length of IV) */
+        ghash_update(gcm, params->iv, params->iv_len);
+        ghash_lengths(gcm, 0u, params->iv_len);
+        memcpy(gcm->j0, gcm->ghash, AES_GCM_BLOCK_SIZE);
+        memset(gcm->ghash, 0, AES_GCM_BLOCK_SIZE);
+    }
+
+    ghash_update(gcm, params->aad, params->aad_len);
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: gcm_ctr
+********************************************************************************
+* Summary: Encrypts or decrypts with Cy_Cryptolite_Aes_Ctr() starting from
+*          inc32(J0). GCM increments only the low 32 bits of the counter
+*          block while the PDL carries into all 128, so the data is split
+*          where the low word wraps and the upper 96 bits are restored.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t gcm_ctr(gcm_state_t *gcm, uint8_t *dst,
+                                         uint8_t const *src, size_t len)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+    uint8_t counter[AES_GCM_BLOCK_SIZE];
+    uint32_t offset;
+    uint32_t low;
+
+    memcpy(counter, gcm->j0, AES_GCM_BLOCK_SIZE);
+    low = ((uint32_t)counter[12] << 24) | ((uint32_t)counter[13] << 16) |
+          ((uint32_t)counter[14] << 8) | counter[15];
+    low++;
+
+    while ((res == CY_CRYPTOLITE_SUCCESS) && (len != 0u))
+    {
+        /* Blocks left before the low word wraps to zero */
+        uint64_t blocks = (uint64_t)0x100000000u - low;
+        size_t chunk = len;
+
+        if ((uint64_t)((len + AES_GCM_BLOCK_SIZE - 1u) / AES_GCM_BLOCK_SIZE) > blocks)
+        {
+            chunk = (size_t)(blocks * AES_GCM_BLOCK_SIZE);
+        }
+        if (chunk > 0xFFFFFFF0u)
+        {
+            chunk = 0xFFFFFFF0u;
+        }
+
+        counter[12] = (uint8_t)(low >> 24);
+        counter[13] = (uint8_t)(low >> 16);
+        counter[14] = (uint8_t)(low >> 8);
+        counter[15] = (uint8_t)low;
+        offset = 0u;
+        res = Cy_Cryptolite_Aes_Ctr(CRYPTOLITE, (uint32_t)chunk, &offset,
+                                    counter, dst, src,
+                                    &gcm->key->session->state);
+        memcpy(counter, gcm->j0, AES_GCM_BLOCK_SIZE - 4u);
+        low += (uint32_t)(chunk / AES_GCM_BLOCK_SIZE);
+        dst += chunk;
+        src += chunk;
+        len -= chunk;
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: gcm_tag
+********************************************************************************
+* Summary: Completes GHASH and encrypts it with the keystream of J0.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t gcm_tag(gcm_state_t *gcm,
+                                         aes_gcm_params_t const *params,
+                                         size_t len,
+                                         uint8_t tag[AES_GCM_BLOCK_SIZE])
+{
+    cy_en_cryptolite_status_t res;
+
+    ghash_lengths(gcm, params->aad_len, len);
+    res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, tag, gcm->j0,
+                                &gcm->key->session->state);
+    for (uint32_t i = 0u; i < AES_GCM_BLOCK_SIZE; i++)
+    {
+        tag[i] ^= gcm->ghash[i];
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_gcm_encrypt
+********************************************************************************
+* Summary: Encrypts len bytes and produces the authentication tag.
+*
+* Parameters:
+*  aes_gcm_key_t* key             - Key state from aes_gcm_setup()
+*  aes_gcm_params_t const* params - IV, associated data and tag length
+*  uint8_t* dst                   - Ciphertext, len bytes; may equal src
+*  uint8_t const* src             - Plaintext, len bytes
+*  size_t len                     - Message length
+*  uint8_t* tag                   - Receives params->tag_len bytes
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_gcm_encrypt(aes_gcm_key_t *key,
+                                          aes_gcm_params_t const *params,
+                                          uint8_t *dst, uint8_t const *src,
+                                          size_t len, uint8_t *tag)
+{
+    cy_en_cryptolite_status_t res;
+    gcm_state_t gcm;
+    uint8_t full_tag[AES_GCM_BLOCK_SIZE];
+
+    if ((tag == NULL) || ((len != 0u) && ((dst == NULL) || (src == NULL))))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    res = gcm_start(&gcm, key, params);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = gcm_ctr(&gcm, dst, src, len);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        ghash_update(&gcm, dst, len);
+        res = gcm_tag(&gcm, params, len, full_tag);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        memcpy(tag, full_tag, params->tag_len);
+    }
+    memset(&gcm, 0, sizeof(gcm));
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_gcm_decrypt
+********************************************************************************
+* Summary: Authenticates and decrypts len bytes. The tag is compared in
+*          constant time; when it does not match, the output is wiped and
+*          *authentic is false.
+*
+* Parameters:
+*  aes_gcm_key_t* key             - Key state from aes_gcm_setup()
+*  aes_gcm_params_t const* params - IV, associated data and tag length
+*  uint8_t* dst                   - Plaintext, len bytes; may equal src
+*  uint8_t const* src             - Ciphertext, len bytes
+*  size_t len                     - Message length
+*  uint8_t const* tag             - Received tag, params->tag_len bytes
+*  bool* authentic                - Set to the result of the tag check
+*
+* Return:
+*  cy_en_cryptolite_status_t - CY_CRYPTOLITE_SUCCESS also when the tag does
+*                              not match; check *authentic
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_gcm_decrypt(aes_gcm_key_t *key,
+                                          aes_gcm_params_t const *params,
+                                          uint8_t *dst, uint8_t const *src,
+                                          size_t len, uint8_t const *tag,
+                                          bool *authentic)
+{
+    cy_en_cryptolite_status_t res;
+    gcm_state_t gcm;
+    uint8_t full_tag[AES_GCM_BLOCK_SIZE];
+    uint8_t diff = 0u;
+
+    if ((tag == NULL) || (authentic == NULL) ||
+        ((len != 0u) && ((dst == NULL) || (src == NULL))))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    *authentic = false;
+
+    /* GHASH covers the ciphertext, so it is absorbed before decryption
+     * overwrites it in place */
+    res = gcm_start(&gcm, key, params);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        ghash_update(&gcm, src, len);
+        res = gcm_tag(&gcm, params, len, full_tag);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        for (size_t i = 0u; i < params->tag_len; i++)
+        {
+            diff |= full_tag[i] ^ tag[i];
+        }
+        *authentic = (diff == 0u);
+    }
+    if (*authentic)
+    {
+        res = gcm_ctr(&gcm, dst, src, len);
+    }
+    else if (len != 0u)
+    {
+        memset(dst, 0, len);
+    }
+    memset(&gcm, 0, sizeof(gcm));
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_gcm_clear
+********************************************************************************
+* Summary: Wipes the GHASH tables, which are equivalent to the hash subkey.
+*
+* Parameters:
+*  aes_gcm_key_t* key - Key state to clear
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void aes_gcm_clear(aes_gcm_key_t *key)
+{
+    if (key != NULL)
+    {
+        memset(key, 0, sizeof(*key));
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,123 @@
+/******************************************************************************
+* File Name: aes_gcm.h
+*
+* Description: AES-128 GCM authenticated encryption (NIST SP 800-38D).
+* Encryption uses the Cryptolite CTR operation; GHASH runs in software with
+* multiplication tables derived once per key. AES_GCM_GHASH_TABLE_BITS selects
+* 4-bit tables (256 bytes per key) or 8-bit tables (4 KiB per key, about twice
+* as fast).
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_AES_GCM_H_
+#define SOURCE_AES_GCM_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_session.h"
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define AES_GCM_BLOCK_SIZE                   (16u)
+
+/* GHASH table width: 4 or 8 */
+#ifndef AES_GCM_GHASH_TABLE_BITS
+#define AES_GCM_GHASH_TABLE_BITS             (4u)
+#endif
+
+#if (AES_GCM_GHASH_TABLE_BITS != 4u) && (AES_GCM_GHASH_TABLE_BITS != 8u)
+#error "AES_GCM_GHASH_TABLE_BITS must be 4 or 8"
+#endif
+
+#define AES_GCM_GHASH_TABLE_SIZE             (1u << AES_GCM_GHASH_TABLE_BITS)
+
+/* Valid tag lengths, per SP 800-38D 5.2.1.2: 12 to 16 bytes, or the short
+ * tags of 8 and 4 bytes; 5 to 7 and 9 to 11 bytes are rejected */
+#define AES_GCM_MIN_TAG_LENGTH               (4u)
+#define AES_GCM_SHORT_TAG_LENGTH             (8u)
+#define AES_GCM_MIN_FULL_TAG_LENGTH          (12u)
+#define AES_GCM_MAX_TAG_LENGTH               (16u)
+
+/* IV length for which the counter block is formed directly */
+#define AES_GCM_DEFAULT_IV_LENGTH            (12u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+/* Per-key GHASH state: multiples of the hash subkey H, split into the high
+ * and low 64 bits of each 128-bit field element */
+typedef struct
+{
+    aes_session_t *session;
+    /* session->generation the tables were derived for */
+    uint32_t       generation;
+    uint64_t       table_hi[AES_GCM_GHASH_TABLE_SIZE];
+    uint64_t       table_lo[AES_GCM_GHASH_TABLE_SIZE];
+} aes_gcm_key_t;
+
+/* Parameters shared by encryption and decryption */
+typedef struct
+{
+    uint8_t const *iv;
+    size_t         iv_len;
+    /* Associated data, authenticated but not encrypted */
+    uint8_t const *aad;
+    size_t         aad_len;
+    size_t         tag_len;
+} aes_gcm_params_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_gcm_setup(aes_gcm_key_t *key,
+                                        aes_session_t *session);
+cy_en_cryptolite_status_t aes_gcm_encrypt(aes_gcm_key_t *key,
+                                          aes_gcm_params_t const *params,
+                                          uint8_t *dst, uint8_t const *src,
+                                          size_t len, uint8_t *tag);
+cy_en_cryptolite_status_t aes_gcm_decrypt(aes_gcm_key_t *key,
+                                          aes_gcm_params_t const *params,
+                                          uint8_t *dst, uint8_t const *src,
+                                          size_t len, uint8_t const *tag,
+                                          bool *authentic);
+void aes_gcm_clear(aes_gcm_key_t *key);
+
+#endif /* SOURCE_AES_GCM_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,142 @@
+/******************************************************************************
+* File Name: aes_session.c
+*
+* Description: Long-lived AES-128 key context for the Cryptolite block.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_session.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: key_equal
+********************************************************************************
+* Summary: Compares two keys in time independent of their contents.
+*
+*******************************************************************************/
+static bool key_equal(uint8_t const *a, uint8_t const *b)
+{
+    uint8_t diff = 0u;
+
+    for (uint32_t i = 0u; i < AES_SESSION_KEY_SIZE; i++)
+    {
+        diff |= a[i] ^ b[i];
+    }
+    return (diff == 0u);
+}
+
+/*******************************************************************************
+* Function Name: aes_session_load
+********************************************************************************
+* Summary: Makes key the active key of the session. Nothing is done when the
+*          key is already loaded; otherwise the previous key context is freed
+*          and the new key is loaded into the Cryptolite block.
+*
+* Parameters:
+*  aes_session_t* session - Session to load the key into
+*  uint8_t const* key     - 128-bit AES key
+*
+* Return:
+*  cy_en_cryptolite_status_t - Status of Cy_Cryptolite_Aes_Init()
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_session_load(aes_session_t *session,
+                                           uint8_t const *key)
+{
+    cy_en_cryptolite_status_t res;
+
+    if ((session == NULL) || (key == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    if (session->loaded)
+    {
+        if (key_equal(session->key, key))
+        {
+            return CY_CRYPTOLITE_SUCCESS;
+        }
+
+        res = aes_session_unload(session);
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            return res;
+        }
+    }
+
+    res = Cy_Cryptolite_Aes_Init(CRYPTOLITE, key, &session->state,
+                                 &session->buffers);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        memcpy(session->key, key, AES_SESSION_KEY_SIZE);
+        session->loaded = true;
+        session->generation++;
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: aes_session_unload
+********************************************************************************
+* Summary: Frees the key context and wipes the cached key.
+*
+* Parameters:
+*  aes_session_t* session - Session to tear down
+*
+* Return:
+*  cy_en_cryptolite_status_t - Status of Cy_Cryptolite_Aes_Free()
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_session_unload(aes_session_t *session)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+
+    if (session == NULL)
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    if (session->loaded)
+    {
+        res = Cy_Cryptolite_Aes_Free(CRYPTOLITE, &session->state);
+        memset(session->key, 0, AES_SESSION_KEY_SIZE);
+        session->loaded = false;
+    }
+    return res;
+}
@@ -0,0 +1,80 @@
+/******************************************************************************
+* File Name: aes_session.h
+*
+* Description: Long-lived AES-128 key context for the Cryptolite block. The key
+* is loaded once with Cy_Cryptolite_Aes_Init() and the resulting state is
+* reused by every AES operation until the key changes.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_AES_SESSION_H_
+#define SOURCE_AES_SESSION_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define AES_SESSION_KEY_SIZE                 (16u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+/* AES key context. The state points into the buffers, so a session must not
+ * be copied or moved while loaded. */
+typedef struct
+{
+    cy_stc_cryptolite_aes_state_t   state;
+    cy_stc_cryptolite_aes_buffers_t buffers;
+    uint8_t                         key[AES_SESSION_KEY_SIZE];
+    bool                            loaded;
+    /* Incremented whenever a different key is loaded, so that data derived
+     * from the key (such as GHASH tables) can tell when it is stale */
+    uint32_t                        generation;
+} aes_session_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_cryptolite_status_t aes_session_load(aes_session_t *session,
+                                           uint8_t const *key);
+cy_en_cryptolite_status_t aes_session_unload(aes_session_t *session);
+
+#endif /* SOURCE_AES_SESSION_H_ */
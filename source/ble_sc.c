@@ -0,0 +1,369 @@
+/******************************************************************************
+* File Name: ble_sc.c
+*
+* Description: Bluetooth LE Secure Connections pairing functions, see ble_sc.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "ble_sc.h"
+#include <string.h>
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* SALT of f5 */
+static const uint8_t ble_sc_salt[AES_SESSION_KEY_SIZE] =
+{
+    0x6Cu, 0x88u, 0x83u, 0x91u, 0xAAu, 0xF5u, 0xA5u, 0x38u,
+    0x60u, 0x37u, 0x0Bu, 0xDBu, 0x5Au, 0x60u, 0x83u, 0xBEu
+};
+
+/* keyID of f5, "btle" */
+static const uint8_t ble_sc_key_id[4] = { 0x62u, 0x74u, 0x6Cu, 0x65u };
+
+/* Length of f5, 256 bits */
+static const uint8_t ble_sc_length[2] = { 0x01u, 0x00u };
+
+/*******************************************************************************
+* Function Name: sc_start
+********************************************************************************
+* Summary: Makes key the key of the current call and begins a MAC with it.
+*          Loading the key the previous call used is a no-op, so its
+*          subkeys are reused as well.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t sc_start(ble_sc_t *ctx, aes_cmac_t *cmac,
+                                          uint8_t const *key)
+{
+    cy_en_cryptolite_status_t res;
+
+    res = aes_session_load(&ctx->session, key);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = aes_cmac_start(cmac, &ctx->key);
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: sc_update
+********************************************************************************
+* Summary: aes_cmac_update() that passes on an earlier failure, so that a
+*          message made of several fields can be absorbed without checking
+*          each step.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t sc_update(cy_en_cryptolite_status_t res,
+                                           aes_cmac_t *cmac,
+                                           uint8_t const *data, size_t len)
+{
+    return (res == CY_CRYPTOLITE_SUCCESS) ?
+           aes_cmac_update(cmac, data, len) : res;
+}
+
+/*******************************************************************************
+* Function Name: sc_finish
+********************************************************************************
+* Summary: aes_cmac_finish() that passes on an earlier failure.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t sc_finish(cy_en_cryptolite_status_t res,
+                                           aes_cmac_t *cmac, uint8_t *mac)
+{
+    return (res == CY_CRYPTOLITE_SUCCESS) ? aes_cmac_finish(cmac, mac) : res;
+}
+
+/*******************************************************************************
+* Function Name: ble_sc_init
+********************************************************************************
+* Summary: Loads the f5 SALT key and derives its subkeys.
+*
+* Parameters:
+*  ble_sc_t* ctx - Context to initialize
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t ble_sc_init(ble_sc_t *ctx)
+{
+    cy_en_cryptolite_status_t res;
+
+    if (ctx == NULL)
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+    res = aes_session_load(&ctx->salt_session, ble_sc_salt);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = aes_cmac_setup(&ctx->salt_key, &ctx->salt_session);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        /* Bound now; derived when the first key is loaded */
+        ctx->key.session = &ctx->session;
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: ble_sc_deinit
+********************************************************************************
+* Summary: Frees both key contexts and wipes the subkeys.
+*
+* Parameters:
+*  ble_sc_t* ctx - Context to tear down
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t ble_sc_deinit(ble_sc_t *ctx)
+{
+    cy_en_cryptolite_status_t res;
+    cy_en_cryptolite_status_t salt_res;
+
+    if (ctx == NULL)
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    res = aes_session_unload(&ctx->session);
+    salt_res = aes_session_unload(&ctx->salt_session);
+    aes_cmac_clear(&ctx->key);
+    aes_cmac_clear(&ctx->salt_key);
+    return (res == CY_CRYPTOLITE_SUCCESS) ? salt_res : res;
+}
+
+/*******************************************************************************
+* Function Name: ble_sc_f4
+********************************************************************************
+* Summary: Confirm value generation, f4(U, V, X, Z) = AES-CMAC_X(U || V || Z).
+*
+* Parameters:
+*  ble_sc_t* ctx    - Context set up with ble_sc_init()
+*  uint8_t const* u - Public key X coordinate, BLE_SC_PUBLIC_KEY_X_SIZE bytes
+*  uint8_t const* v - Public key X coordinate, BLE_SC_PUBLIC_KEY_X_SIZE bytes
+*  uint8_t const* x - Nonce used as the key, BLE_SC_NONCE_SIZE bytes
+*  uint8_t z        - 0 or the passkey bit, ORed with 0x80
+*  uint8_t* out     - BLE_SC_KEY_SIZE bytes of confirm value
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t ble_sc_f4(ble_sc_t *ctx, uint8_t const *u,
+                                    uint8_t const *v, uint8_t const *x,
+                                    uint8_t z, uint8_t *out)
+{
+    cy_en_cryptolite_status_t res;
+    aes_cmac_t cmac;
+
+    if ((ctx == NULL) || (u == NULL) || (v == NULL) || (x == NULL) ||
+        (out == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    res = sc_start(ctx, &cmac, x);
+    res = sc_update(res, &cmac, u, BLE_SC_PUBLIC_KEY_X_SIZE);
+    res = sc_update(res, &cmac, v, BLE_SC_PUBLIC_KEY_X_SIZE);
+    res = sc_update(res, &cmac, &z, 1u);
+    return sc_finish(res, &cmac, out);
+}
+
+/*******************************************************************************
+* Function Name: ble_sc_f5
+********************************************************************************
+* Summary: Key generation. T = AES-CMAC_SALT(W), then
+*          MacKey = AES-CMAC_T(0 || keyID || N1 || N2 || A1 || A2 || 256) and
+*          LTK    = AES-CMAC_T(1 || keyID || N1 || N2 || A1 || A2 || 256).
+*          T is loaded once and its subkeys serve both halves.
+*
+* Parameters:
+*  ble_sc_t* ctx     - Context set up with ble_sc_init()
+*  uint8_t const* w  - DHKey, BLE_SC_DHKEY_SIZE bytes
+*  uint8_t const* n1 - Nonce, BLE_SC_NONCE_SIZE bytes
+*  uint8_t const* n2 - Nonce, BLE_SC_NONCE_SIZE bytes
+*  uint8_t const* a1 - Address, BLE_SC_ADDRESS_SIZE bytes
+*  uint8_t const* a2 - Address, BLE_SC_ADDRESS_SIZE bytes
+*  uint8_t* mac_key  - BLE_SC_KEY_SIZE bytes of MacKey
+*  uint8_t* ltk      - BLE_SC_KEY_SIZE bytes of LTK
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t ble_sc_f5(ble_sc_t *ctx, uint8_t const *w,
+                                    uint8_t const *n1, uint8_t const *n2,
+                                    uint8_t const *a1, uint8_t const *a2,
+                                    uint8_t *mac_key, uint8_t *ltk)
+{
+    cy_en_cryptolite_status_t res;
+    aes_cmac_t cmac;
+    uint8_t t[AES_CMAC_MAC_SIZE];
+    uint8_t *out;
+
+    if ((ctx == NULL) || (w == NULL) || (n1 == NULL) || (n2 == NULL) ||
+        (a1 == NULL) || (a2 == NULL) || (mac_key == NULL) || (ltk == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    res = aes_cmac(&ctx->salt_key, w, BLE_SC_DHKEY_SIZE, t);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = aes_session_load(&ctx->session, t);
+    }
+    memset(t, 0, sizeof(t));
+
+    for (uint8_t counter = 0u;
+         (res == CY_CRYPTOLITE_SUCCESS) && (counter < 2u); counter++)
+    {
+        out = (counter == 0u) ? mac_key : ltk;
+        res = aes_cmac_start(&cmac, &ctx->key);
+        res = sc_update(res, &cmac, &counter, 1u);
+        res = sc_update(res, &cmac, ble_sc_key_id, sizeof(ble_sc_key_id));
+        res = sc_update(res, &cmac, n1, BLE_SC_NONCE_SIZE);
+        res = sc_update(res, &cmac, n2, BLE_SC_NONCE_SIZE);
+        res = sc_update(res, &cmac, a1, BLE_SC_ADDRESS_SIZE);
+        res = sc_update(res, &cmac, a2, BLE_SC_ADDRESS_SIZE);
+        res = sc_update(res, &cmac, ble_sc_length, sizeof(ble_sc_length));
+        res = sc_finish(res, &cmac, out);
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: ble_sc_f6
+********************************************************************************
+* Summary: Check value generation,
+*          f6(W, N1, N2, R, IOcap, A1, A2) =
+*          AES-CMAC_W(N1 || N2 || R || IOcap || A1 || A2).
+*
+* Parameters:
+*  ble_sc_t* ctx         - Context set up with ble_sc_init()
+*  uint8_t const* w      - MacKey, BLE_SC_KEY_SIZE bytes
+*  uint8_t const* n1     - Nonce, BLE_SC_NONCE_SIZE bytes
+*  uint8_t const* n2     - Nonce, BLE_SC_NONCE_SIZE bytes
+*  uint8_t const* r      - Passkey or OOB value, BLE_SC_KEY_SIZE bytes
+*  uint8_t const* io_cap - IO capabilities, BLE_SC_IO_CAP_SIZE bytes
+*  uint8_t const* a1     - Address, BLE_SC_ADDRESS_SIZE bytes
+*  uint8_t const* a2     - Address, BLE_SC_ADDRESS_SIZE bytes
+*  uint8_t* out          - BLE_SC_KEY_SIZE bytes of check value
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t ble_sc_f6(ble_sc_t *ctx, uint8_t const *w,
+                                    uint8_t const *n1, uint8_t const *n2,
+                                    uint8_t const *r, uint8_t const *io_cap,
+                                    uint8_t const *a1, uint8_t const *a2,
+                                    uint8_t *out)
+{
+    cy_en_cryptolite_status_t res;
+    aes_cmac_t cmac;
+
+    if ((ctx == NULL) || (w == NULL) || (n1 == NULL) || (n2 == NULL) ||
+        (r == NULL) || (io_cap == NULL) || (a1 == NULL) || (a2 == NULL) ||
+        (out == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    res = sc_start(ctx, &cmac, w);
+    res = sc_update(res, &cmac, n1, BLE_SC_NONCE_SIZE);
+    res = sc_update(res, &cmac, n2, BLE_SC_NONCE_SIZE);
+    res = sc_update(res, &cmac, r, BLE_SC_KEY_SIZE);
+    res = sc_update(res, &cmac, io_cap, BLE_SC_IO_CAP_SIZE);
+    res = sc_update(res, &cmac, a1, BLE_SC_ADDRESS_SIZE);
+    res = sc_update(res, &cmac, a2, BLE_SC_ADDRESS_SIZE);
+    return sc_finish(res, &cmac, out);
+}
+
+/*******************************************************************************
+* Function Name: ble_sc_g2
+********************************************************************************
+* Summary: Numeric comparison value generation,
+*          g2(U, V, X, Y) = AES-CMAC_X(U || V || Y) mod 2^32. The six digits
+*          shown to the user are value % 1000000.
+*
+* Parameters:
+*  ble_sc_t* ctx    - Context set up with ble_sc_init()
+*  uint8_t const* u - Public key X coordinate, BLE_SC_PUBLIC_KEY_X_SIZE bytes
+*  uint8_t const* v - Public key X coordinate, BLE_SC_PUBLIC_KEY_X_SIZE bytes
+*  uint8_t const* x - Nonce used as the key, BLE_SC_NONCE_SIZE bytes
+*  uint8_t const* y - Nonce, BLE_SC_NONCE_SIZE bytes
+*  uint32_t* value  - 32-bit result
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t ble_sc_g2(ble_sc_t *ctx, uint8_t const *u,
+                                    uint8_t const *v, uint8_t const *x,
+                                    uint8_t const *y, uint32_t *value)
+{
+    cy_en_cryptolite_status_t res;
+    aes_cmac_t cmac;
+    uint8_t mac[AES_CMAC_MAC_SIZE];
+
+    if ((ctx == NULL) || (u == NULL) || (v == NULL) || (x == NULL) ||
+        (y == NULL) || (value == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    res = sc_start(ctx, &cmac, x);
+    res = sc_update(res, &cmac, u, BLE_SC_PUBLIC_KEY_X_SIZE);
+    res = sc_update(res, &cmac, v, BLE_SC_PUBLIC_KEY_X_SIZE);
+    res = sc_update(res, &cmac, y, BLE_SC_NONCE_SIZE);
+    res = sc_finish(res, &cmac, mac);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        *value = ((uint32_t)mac[12] << 24) | ((uint32_t)mac[13] << 16) |
+                 ((uint32_t)mac[14] << 8) | (uint32_t)mac[15];
+    }
+    return res;
+}
+
+/* [] END OF FILE */
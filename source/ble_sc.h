@@ -0,0 +1,104 @@
+/******************************************************************************
+* File Name: ble_sc.h
+*
+* Description: Bluetooth LE Secure Connections pairing functions f4, f5, f6 and
+* g2 (Core Specification Vol 3, Part H, 2.2.6-2.2.9), built on AES-CMAC. The
+* key used by f5 to derive T is fixed, so its session and subkeys are set up
+* once in ble_sc_init(). The other functions are keyed by a per-call value, and
+* a key equal to the previous call's reuses its session and subkeys.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_BLE_SC_H_
+#define SOURCE_BLE_SC_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_cmac.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* All values are byte arrays in the most significant byte first order used
+ * by the function definitions and sample data of the specification. Values
+ * received over the air are least significant byte first and must be
+ * reversed by the caller. */
+#define BLE_SC_PUBLIC_KEY_X_SIZE             (32u)
+#define BLE_SC_DHKEY_SIZE                    (32u)
+#define BLE_SC_NONCE_SIZE                    (16u)
+#define BLE_SC_KEY_SIZE                      (16u)
+/* Address type octet followed by the 48-bit device address */
+#define BLE_SC_ADDRESS_SIZE                  (7u)
+#define BLE_SC_IO_CAP_SIZE                   (3u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef struct
+{
+    /* SALT key of f5 */
+    aes_session_t  salt_session;
+    aes_cmac_key_t salt_key;
+    /* Key of the current call */
+    aes_session_t  session;
+    aes_cmac_key_t key;
+} ble_sc_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_cryptolite_status_t ble_sc_init(ble_sc_t *ctx);
+cy_en_cryptolite_status_t ble_sc_deinit(ble_sc_t *ctx);
+cy_en_cryptolite_status_t ble_sc_f4(ble_sc_t *ctx, uint8_t const *u,
+                                    uint8_t const *v, uint8_t const *x,
+                                    uint8_t z, uint8_t *out);
+cy_en_cryptolite_status_t ble_sc_f5(ble_sc_t *ctx, uint8_t const *w,
+                                    uint8_t const *n1, uint8_t const *n2,
+                                    uint8_t const *a1, uint8_t const *a2,
+                                    uint8_t *mac_key, uint8_t *ltk);
+cy_en_cryptolite_status_t ble_sc_f6(ble_sc_t *ctx, uint8_t const *w,
+                                    uint8_t const *n1, uint8_t const *n2,
+                                    uint8_t const *r, uint8_t const *io_cap,
+                                    uint8_t const *a1, uint8_t const *a2,
+                                    uint8_t *out);
+cy_en_cryptolite_status_t ble_sc_g2(ble_sc_t *ctx, uint8_t const *u,
+                                    uint8_t const *v, uint8_t const *x,
+                                    uint8_t const *y, uint32_t *value);
+
+#endif /* SOURCE_BLE_SC_H_ */
+
+/* [] END OF FILE */
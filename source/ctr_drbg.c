@@ -0,0 +1,639 @@
+/******************************************************************************
+* File Name: ctr_drbg.c
+*
+* Description: AES-128 CTR_DRBG, see ctr_drbg.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "ctr_drbg.h"
+#include "aes_ctr.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* L and N, the two 32-bit lengths in front of the df input */
+#define DRBG_DF_HEADER_SIZE                  (8u)
+#define DRBG_DF_PAD                          (0x80u)
+
+/* Entropy input, nonce and personalization string or additional input */
+#define DRBG_MATERIAL_SIZE                   (CTR_DRBG_ENTROPY_SIZE + \
+                                              CTR_DRBG_NONCE_SIZE +   \
+                                              CTR_DRBG_SEED_SIZE)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Known-answer test: COUNT = 0 of the NIST CAVP CTR_DRBG AES-128 vectors
+ * (drbgvectors_pr_false) for the configured variant. Instantiate without
+ * personalization, reseed without additional input, generate twice and
+ * compare the second output. The entropy source hands out EntropyInput,
+ * Nonce and EntropyInputReseed in that order. */
+#if (CTR_DRBG_DERIVATION_FUNCTION != 0u)
+#define SELF_TEST_ENTROPY_LEN                (16u)
+#define SELF_TEST_NONCE_LEN                  (8u)
+
+static const uint8_t self_test_entropy[] =
+{
+    /* EntropyInput */
+    0x0Fu, 0x65u, 0xDAu, 0x13u, 0xDCu, 0xA4u, 0x07u, 0x99u,
+    0x9Du, 0x47u, 0x73u, 0xC2u, 0xB4u, 0xA1u, 0x1Du, 0x85u,
+    /* Nonce */
+    0x52u, 0x09u, 0xE5u, 0xB4u, 0xEDu, 0x82u, 0xA2u, 0x34u,
+    /* EntropyInputReseed */
+    0x1Du, 0xEAu, 0x0Au, 0x12u, 0xC5u, 0x2Bu, 0xF6u, 0x43u,
+    0x39u, 0xDDu, 0x29u, 0x1Cu, 0x80u, 0xD8u, 0xCAu, 0x89u,
+};
+
+static const uint8_t self_test_output[64] =
+{
+    0x28u, 0x59u, 0xCCu, 0x46u, 0x8Au, 0x76u, 0xB0u, 0x86u,
+    0x61u, 0xFFu, 0xD2u, 0x3Bu, 0x28u, 0x54u, 0x7Fu, 0xFDu,
+    0x09u, 0x97u, 0xADu, 0x52u, 0x6Au, 0x0Fu, 0x51u, 0x26u,
+    0x1Bu, 0x99u, 0xEDu, 0x3Au, 0x37u, 0xBDu, 0x40u, 0x7Bu,
+    0xF4u, 0x18u, 0xDBu, 0xE6u, 0xC6u, 0xC3u, 0xE2u, 0x6Eu,
+    0xD0u, 0xDDu, 0xEFu, 0xCBu, 0x74u, 0x74u, 0xD8u, 0x99u,
+    0xBDu, 0x99u, 0xF3u, 0x65u, 0x54u, 0x27u, 0x51u, 0x9Fu,
+    0xC5u, 0xB4u, 0x05u, 0x7Bu, 0xCAu, 0xF3u, 0x06u, 0xD4u,
+};
+
+/* Key of the derivation function: 00 01 02 ... 0F */
+static const uint8_t drbg_df_key[AES_SESSION_KEY_SIZE] =
+{
+    0x00u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u,
+    0x08u, 0x09u, 0x0Au, 0x0Bu, 0x0Cu, 0x0Du, 0x0Eu, 0x0Fu,
+};
+#else
+#define SELF_TEST_ENTROPY_LEN                (CTR_DRBG_SEED_SIZE)
+#define SELF_TEST_NONCE_LEN                  (0u)
+
+static const uint8_t self_test_entropy[] =
+{
+    /* EntropyInput */
+    0xEDu, 0x1Eu, 0x7Fu, 0x21u, 0xEFu, 0x66u, 0xEAu, 0x5Du,
+    0x8Eu, 0x2Au, 0x85u, 0xB9u, 0x33u, 0x72u, 0x45u, 0x44u,
+    0x5Bu, 0x71u, 0xD6u, 0x39u, 0x3Au, 0x4Eu, 0xECu, 0xB0u,
+    0xE6u, 0x3Cu, 0x19u, 0x3Du, 0x0Fu, 0x72u, 0xF9u, 0xA9u,
+    /* EntropyInputReseed */
+    0x30u, 0x3Fu, 0xB5u, 0x19u, 0xF0u, 0xA4u, 0xE1u, 0x7Du,
+    0x6Du, 0xF0u, 0xB6u, 0x42u, 0x6Au, 0xA0u, 0xECu, 0xB2u,
+    0xA3u, 0x60u, 0x79u, 0xBDu, 0x48u, 0xBEu, 0x47u, 0xADu,
+    0x2Au, 0x8Du, 0xBFu, 0xE4u, 0x8Du, 0xA3u, 0xEFu, 0xADu,
+};
+
+static const uint8_t self_test_output[64] =
+{
+    0xF8u, 0x01u, 0x11u, 0xD0u, 0x8Eu, 0x87u, 0x46u, 0x72u,
+    0xF3u, 0x2Fu, 0x42u, 0x99u, 0x71u, 0x33u, 0xA5u, 0x21u,
+    0x0Fu, 0x7Au, 0x93u, 0x75u, 0xE2u, 0x2Cu, 0xEAu, 0x70u,
+    0x58u, 0x7Fu, 0x9Cu, 0xFAu, 0xFEu, 0xBEu, 0x0Fu, 0x6Au,
+    0x6Au, 0xA2u, 0xEBu, 0x68u, 0xE7u, 0xDDu, 0x91u, 0x64u,
+    0x53u, 0x6Du, 0x53u, 0xFAu, 0x02u, 0x0Fu, 0xCAu, 0xB2u,
+    0x0Fu, 0x54u, 0xCAu, 0xDDu, 0xFAu, 0xB7u, 0xD6u, 0xD9u,
+    0x1Eu, 0x5Fu, 0xFEu, 0xC1u, 0xDFu, 0xD8u, 0xDEu, 0xAAu,
+};
+#endif
+
+/* Read position of self_test_get_entropy() in self_test_entropy */
+static size_t self_test_pos;
+
+/*******************************************************************************
+* Function Name: drbg_increment
+********************************************************************************
+* Summary: Adds one to a big-endian 128-bit counter.
+*
+*******************************************************************************/
+static void drbg_increment(uint8_t *block)
+{
+    for (uint32_t i = CTR_DRBG_BLOCK_SIZE; i > 0u; i--)
+    {
+        if (++block[i - 1u] != 0u)
+        {
+            break;
+        }
+    }
+}
+
+#if (CTR_DRBG_DERIVATION_FUNCTION != 0u)
+/*******************************************************************************
+* Function Name: drbg_df
+********************************************************************************
+* Summary: Block_Cipher_df (SP 800-90A section 10.3.2) with a fixed output of
+*          CTR_DRBG_SEED_SIZE bytes. S = L || N || input || 0x80 || zero pad
+*          is never built: each byte is streamed straight into the two BCC
+*          chains, which are CBC-MACs under the df key with the block
+*          i || 0^96 in front, so the whole df costs two ECB calls per
+*          16 bytes of input plus a key load.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t drbg_df(uint8_t const *input,
+                                         size_t input_len, uint8_t *out)
+{
+    cy_en_cryptolite_status_t res;
+    aes_session_t df_session;
+    uint8_t chain[2][CTR_DRBG_BLOCK_SIZE] = {{0u}};
+    uint8_t header[DRBG_DF_HEADER_SIZE] =
+    {
+        (uint8_t)(input_len >> 24), (uint8_t)(input_len >> 16),
+        (uint8_t)(input_len >> 8), (uint8_t)input_len,
+        0u, 0u, 0u, (uint8_t)CTR_DRBG_SEED_SIZE,
+    };
+    size_t s_len = DRBG_DF_HEADER_SIZE + input_len + 1u;
+    size_t pos;
+    uint8_t byte;
+
+    memset(&df_session, 0, sizeof(df_session));
+    res = aes_session_load(&df_session, drbg_df_key);
+
+    /* First block of chain i is the 32-bit big-endian i, zero padded */
+    chain[1][3] = 1u;
+    for (uint32_t i = 0u; (i < 2u) && (res == CY_CRYPTOLITE_SUCCESS); i++)
+    {
+        res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, chain[i], chain[i],
+                                    &df_session.state);
+    }
+
+    s_len = (s_len + CTR_DRBG_BLOCK_SIZE - 1u) & ~(size_t)(CTR_DRBG_BLOCK_SIZE - 1u);
+    for (pos = 0u; (pos < s_len) && (res == CY_CRYPTOLITE_SUCCESS); pos++)
+    {
+        if (pos < DRBG_DF_HEADER_SIZE)
+        {
+            byte = header[pos];
+        }
+        else if (pos < (DRBG_DF_HEADER_SIZE + input_len))
+        {
+            byte = input[pos - DRBG_DF_HEADER_SIZE];
+        }
+        else
+        {
+            byte = (pos == (DRBG_DF_HEADER_SIZE + input_len)) ? DRBG_DF_PAD
+                                                              : 0u;
+        }
+        chain[0][pos % CTR_DRBG_BLOCK_SIZE] ^= byte;
+        chain[1][pos % CTR_DRBG_BLOCK_SIZE] ^= byte;
+
+        if ((pos % CTR_DRBG_BLOCK_SIZE) == (CTR_DRBG_BLOCK_SIZE - 1u))
+        {
+            for (uint32_t i = 0u; (i < 2u) && (res == CY_CRYPTOLITE_SUCCESS); i++)
+            {
+                res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, chain[i], chain[i],
+                                            &df_session.state);
+            }
+        }
+    }
+
+    /* K = chain 0, X = chain 1; the output is E(K, X) || E(K, E(K, X)) */
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = aes_session_load(&df_session, chain[0]);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, out, chain[1],
+                                    &df_session.state);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, &out[CTR_DRBG_BLOCK_SIZE],
+                                    out, &df_session.state);
+    }
+
+    (void)aes_session_unload(&df_session);
+    memset(&df_session, 0, sizeof(df_session));
+    memset(chain, 0, sizeof(chain));
+    return res;
+}
+#endif
+
+/*******************************************************************************
+* Function Name: drbg_keystream
+********************************************************************************
+* Summary: Writes len bytes of AES-CTR keystream starting at counter to out,
+*          and returns the counter value after the last block used.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t drbg_keystream(ctr_drbg_t *drbg,
+                                                uint8_t *counter,
+                                                uint8_t *out, size_t len)
+{
+    cy_en_cryptolite_status_t res;
+    aes_ctr_ctx_t ctr;
+
+    res = aes_ctr_init(&ctr, &drbg->session, counter);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        memset(out, 0, len);
+        res = aes_ctr_update(&ctr, out, out, len);
+        memcpy(counter, ctr.counter, CTR_DRBG_BLOCK_SIZE);
+    }
+    aes_ctr_final(&ctr);
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: drbg_update
+********************************************************************************
+* Summary: CTR_DRBG_Update: the next CTR_DRBG_SEED_SIZE bytes of keystream,
+*          starting at counter (V + 1), XORed with provided become the new
+*          Key and V.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t drbg_update(ctr_drbg_t *drbg,
+                                             uint8_t *counter,
+                                             uint8_t const *provided)
+{
+    cy_en_cryptolite_status_t res;
+    uint8_t temp[CTR_DRBG_SEED_SIZE];
+
+    res = drbg_keystream(drbg, counter, temp, sizeof(temp));
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        for (uint32_t i = 0u; i < CTR_DRBG_SEED_SIZE; i++)
+        {
+            temp[i] ^= provided[i];
+        }
+        res = aes_session_load(&drbg->session, temp);
+        memcpy(drbg->v, &temp[AES_SESSION_KEY_SIZE], CTR_DRBG_BLOCK_SIZE);
+    }
+    memset(temp, 0, sizeof(temp));
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: drbg_seed
+********************************************************************************
+* Summary: Draws entropy_len bytes (entropy input and, at instantiation, the
+*          nonce) from the source, turns them and the input into seed
+*          material, mixes that into the state and restarts the reseed
+*          counter. With the derivation function the seed material is
+*          df(entropy || input); without it the input is zero-padded and
+*          XORed onto the entropy.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t drbg_seed(ctr_drbg_t *drbg,
+                                           size_t entropy_len,
+                                           uint8_t const *input,
+                                           size_t input_len)
+{
+    cy_en_cryptolite_status_t res;
+    uint8_t material[DRBG_MATERIAL_SIZE];
+    uint8_t seed[CTR_DRBG_SEED_SIZE];
+    uint8_t counter[CTR_DRBG_BLOCK_SIZE];
+
+    res = drbg->get_entropy(material, entropy_len);
+#if (CTR_DRBG_DERIVATION_FUNCTION != 0u)
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        if (input_len != 0u)
+        {
+            memcpy(&material[entropy_len], input, input_len);
+        }
+        res = drbg_df(material, entropy_len + input_len, seed);
+    }
+#else
+    memcpy(seed, material, CTR_DRBG_SEED_SIZE);
+    for (size_t i = 0u; i < input_len; i++)
+    {
+        seed[i] ^= input[i];
+    }
+#endif
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        memcpy(counter, drbg->v, CTR_DRBG_BLOCK_SIZE);
+        drbg_increment(counter);
+        res = drbg_update(drbg, counter, seed);
+        drbg->reseed_counter = 1u;
+    }
+    memset(material, 0, sizeof(material));
+    memset(seed, 0, sizeof(seed));
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: drbg_instantiate
+********************************************************************************
+* Summary: ctr_drbg_instantiate() with the entropy input and nonce lengths
+*          given, so that the known-answer test can use the CAVP sizes.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t drbg_instantiate(ctr_drbg_t *drbg,
+                                                  ctr_drbg_entropy_t get_entropy,
+                                                  size_t entropy_len,
+                                                  size_t nonce_len,
+                                                  uint8_t const *personalization,
+                                                  size_t personalization_len,
+                                                  uint32_t reseed_interval,
+                                                  bool prediction_resistance)
+{
+    cy_en_cryptolite_status_t res;
+    uint8_t zero_key[AES_SESSION_KEY_SIZE] = {0u};
+
+    if ((drbg == NULL) || (get_entropy == NULL) ||
+        (personalization_len > CTR_DRBG_SEED_SIZE) ||
+        ((personalization == NULL) && (personalization_len != 0u)))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    memset(drbg, 0, sizeof(*drbg));
+    drbg->get_entropy = get_entropy;
+    drbg->entropy_len = entropy_len;
+    drbg->reseed_interval = (reseed_interval != 0u) ? reseed_interval
+                                                    : CTR_DRBG_RESEED_INTERVAL;
+    drbg->prediction_resistance = prediction_resistance;
+
+    res = aes_session_load(&drbg->session, zero_key);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = drbg_seed(drbg, entropy_len + nonce_len, personalization,
+                        personalization_len);
+    }
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        ctr_drbg_uninstantiate(drbg);
+        return res;
+    }
+
+    drbg->instantiated = true;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: ctr_drbg_instantiate
+********************************************************************************
+* Summary: Sets up a DRBG with Key = 0 and V = 0 and seeds it from
+*          CTR_DRBG_ENTROPY_SIZE bytes of entropy input, CTR_DRBG_NONCE_SIZE
+*          bytes of nonce, both from get_entropy, and the personalization
+*          string.
+*
+* Parameters:
+*  ctr_drbg_t* drbg                - DRBG to set up
+*  ctr_drbg_entropy_t get_entropy  - Entropy source for (re)seeding
+*  uint8_t const* personalization  - Personalization string, or NULL
+*  size_t personalization_len      - Its length, at most CTR_DRBG_SEED_SIZE
+*  uint32_t reseed_interval        - Generate requests between reseeds, or 0
+*                                    for CTR_DRBG_RESEED_INTERVAL
+*  bool prediction_resistance      - Reseed before every generate request
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t ctr_drbg_instantiate(ctr_drbg_t *drbg,
+                                               ctr_drbg_entropy_t get_entropy,
+                                               uint8_t const *personalization,
+                                               size_t personalization_len,
+                                               uint32_t reseed_interval,
+                                               bool prediction_resistance)
+{
+    return drbg_instantiate(drbg, get_entropy, CTR_DRBG_ENTROPY_SIZE,
+                            CTR_DRBG_NONCE_SIZE, personalization,
+                            personalization_len, reseed_interval,
+                            prediction_resistance);
+}
+
+/*******************************************************************************
+* Function Name: ctr_drbg_reseed
+********************************************************************************
+* Summary: Mixes fresh entropy and optional additional input into the state.
+*
+* Parameters:
+*  ctr_drbg_t* drbg           - Instantiated DRBG
+*  uint8_t const* additional  - Additional input, or NULL
+*  size_t additional_len      - Its length, at most CTR_DRBG_SEED_SIZE
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t ctr_drbg_reseed(ctr_drbg_t *drbg,
+                                          uint8_t const *additional,
+                                          size_t additional_len)
+{
+    cy_en_cryptolite_status_t res;
+
+    if ((drbg == NULL) || (additional_len > CTR_DRBG_SEED_SIZE) ||
+        ((additional == NULL) && (additional_len != 0u)))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!drbg->instantiated)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    res = drbg_seed(drbg, drbg->entropy_len, additional, additional_len);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        drbg->reseeds++;
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: ctr_drbg_generate
+********************************************************************************
+* Summary: Produces len pseudorandom bytes, reseeding first when prediction
+*          resistance is on or the reseed interval has run out. The output is
+*          AES-CTR keystream from V + 1, so a whole request costs one PDL
+*          call plus two block operations and a key load for the update.
+*
+* Parameters:
+*  ctr_drbg_t* drbg           - Instantiated DRBG
+*  uint8_t* out               - Output buffer
+*  size_t len                 - Bytes to produce, at most CTR_DRBG_MAX_REQUEST
+*  uint8_t const* additional  - Additional input, or NULL
+*  size_t additional_len      - Its length, at most CTR_DRBG_SEED_SIZE
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t ctr_drbg_generate(ctr_drbg_t *drbg, uint8_t *out,
+                                            size_t len,
+                                            uint8_t const *additional,
+                                            size_t additional_len)
+{
+    cy_en_cryptolite_status_t res;
+    uint8_t input[CTR_DRBG_SEED_SIZE] = {0u};
+    uint8_t counter[CTR_DRBG_BLOCK_SIZE];
+
+    if ((drbg == NULL) || ((out == NULL) && (len != 0u)) ||
+        (len > CTR_DRBG_MAX_REQUEST) ||
+        (additional_len > CTR_DRBG_SEED_SIZE) ||
+        ((additional == NULL) && (additional_len != 0u)))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!drbg->instantiated)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    if (drbg->prediction_resistance ||
+        (drbg->reseed_counter > drbg->reseed_interval))
+    {
+        /* The additional input goes into the reseed instead */
+        res = ctr_drbg_reseed(drbg, additional, additional_len);
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            return res;
+        }
+        additional_len = 0u;
+    }
+
+    memcpy(counter, drbg->v, CTR_DRBG_BLOCK_SIZE);
+    drbg_increment(counter);
+    if (additional_len != 0u)
+    {
+#if (CTR_DRBG_DERIVATION_FUNCTION != 0u)
+        res = drbg_df(additional, additional_len, input);
+#else
+        memcpy(input, additional, additional_len);
+        res = CY_CRYPTOLITE_SUCCESS;
+#endif
+        if (res == CY_CRYPTOLITE_SUCCESS)
+        {
+            res = drbg_update(drbg, counter, input);
+        }
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            memset(input, 0, sizeof(input));
+            return res;
+        }
+        memcpy(counter, drbg->v, CTR_DRBG_BLOCK_SIZE);
+        drbg_increment(counter);
+    }
+
+    /* The rest of the last block is discarded; the update starts at the
+     * following counter value */
+    res = drbg_keystream(drbg, counter, out, len);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = drbg_update(drbg, counter, input);
+        drbg->reseed_counter++;
+    }
+    memset(input, 0, sizeof(input));
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: ctr_drbg_uninstantiate
+********************************************************************************
+* Summary: Releases the AES key and wipes the state.
+*
+* Parameters:
+*  ctr_drbg_t* drbg - DRBG to tear down
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ctr_drbg_uninstantiate(ctr_drbg_t *drbg)
+{
+    if (drbg != NULL)
+    {
+        (void)aes_session_unload(&drbg->session);
+        memset(drbg, 0, sizeof(*drbg));
+    }
+}
+
+/*******************************************************************************
+* Function Name: self_test_get_entropy
+********************************************************************************
+* Summary: Entropy source of the known-answer test: the next len bytes of
+*          self_test_entropy.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t self_test_get_entropy(uint8_t *buf,
+                                                       size_t len)
+{
+    if (len > (sizeof(self_test_entropy) - self_test_pos))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    memcpy(buf, &self_test_entropy[self_test_pos], len);
+    self_test_pos += len;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: ctr_drbg_self_test
+********************************************************************************
+* Summary: Known-answer health test (SP 800-90A section 11.3) of instantiate,
+*          reseed and generate, to be run before the DRBG is first used.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if the DRBG produced the expected output
+*
+*******************************************************************************/
+bool ctr_drbg_self_test(void)
+{
+    cy_en_cryptolite_status_t res;
+    ctr_drbg_t drbg;
+    uint8_t out[sizeof(self_test_output)];
+    bool pass;
+
+    self_test_pos = 0u;
+    res = drbg_instantiate(&drbg, self_test_get_entropy,
+                           SELF_TEST_ENTROPY_LEN, SELF_TEST_NONCE_LEN,
+                           NULL, 0u, 0u, false);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = ctr_drbg_reseed(&drbg, NULL, 0u);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = ctr_drbg_generate(&drbg, out, sizeof(out), NULL, 0u);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = ctr_drbg_generate(&drbg, out, sizeof(out), NULL, 0u);
+    }
+    pass = (res == CY_CRYPTOLITE_SUCCESS) &&
+           (self_test_pos == sizeof(self_test_entropy)) &&
+           (memcmp(out, self_test_output, sizeof(out)) == 0);
+
+    ctr_drbg_uninstantiate(&drbg);
+    memset(out, 0, sizeof(out));
+    return pass;
+}
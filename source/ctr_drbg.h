@@ -0,0 +1,141 @@
+/******************************************************************************
+* File Name: ctr_drbg.h
+*
+* Description: AES-128 CTR_DRBG (NIST SP 800-90A) running on the Cryptolite
+* AES block. It is seeded and reseeded from a caller-supplied entropy source,
+* normally the TRNG entropy pool, and produces up to CTR_DRBG_MAX_REQUEST
+* bytes per request at AES speed. By default the seed material is condensed
+* by the Block_Cipher_df derivation function, so the source need not deliver
+* full entropy; CTR_DRBG_DERIVATION_FUNCTION 0 selects the variant without
+* it, for sources that do.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_CTR_DRBG_H_
+#define SOURCE_CTR_DRBG_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "aes_session.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CTR_DRBG_BLOCK_SIZE                  (16u)
+/* Key and V; also the longest personalization string and additional input */
+#define CTR_DRBG_SEED_SIZE                   (32u)
+
+/* 1: seed material and additional input pass through Block_Cipher_df.
+ * 0: no derivation function; the entropy input must be CTR_DRBG_SEED_SIZE
+ *    bytes of full entropy, and shorter inputs are zero-padded.
+ */
+#ifndef CTR_DRBG_DERIVATION_FUNCTION
+#define CTR_DRBG_DERIVATION_FUNCTION         (1u)
+#endif
+
+/* Bytes requested from the entropy source per (re)seed, and in addition at
+ * instantiation for the nonce. The defaults hold 256 and 64 bits of
+ * min-entropy at the 4 bits per byte assumed by the TRNG health tests (see
+ * trng_health.h), against the 128 and 64 bits that SP 800-90A asks for. */
+#if (CTR_DRBG_DERIVATION_FUNCTION != 0u)
+#ifndef CTR_DRBG_ENTROPY_SIZE
+#define CTR_DRBG_ENTROPY_SIZE                (64u)
+#endif
+#ifndef CTR_DRBG_NONCE_SIZE
+#define CTR_DRBG_NONCE_SIZE                  (16u)
+#endif
+#else
+#define CTR_DRBG_ENTROPY_SIZE                (CTR_DRBG_SEED_SIZE)
+#define CTR_DRBG_NONCE_SIZE                  (0u)
+#endif
+
+/* Largest generate request (2^19 bits, SP 800-90A table 3) */
+#define CTR_DRBG_MAX_REQUEST                 (0x10000u)
+
+/* Generate requests between reseeds when the caller passes 0 */
+#ifndef CTR_DRBG_RESEED_INTERVAL
+#define CTR_DRBG_RESEED_INTERVAL             (1024u)
+#endif
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+/* Fills buf with len bytes of entropy input, which must be full entropy
+ * when CTR_DRBG_DERIVATION_FUNCTION is 0 */
+typedef cy_en_cryptolite_status_t (*ctr_drbg_entropy_t)(uint8_t *buf,
+                                                        size_t len);
+
+typedef struct
+{
+    /* Holds the DRBG key */
+    aes_session_t      session;
+    uint8_t            v[CTR_DRBG_BLOCK_SIZE];
+    /* Generate requests since the last (re)seed, plus one */
+    uint32_t           reseed_counter;
+    uint32_t           reseed_interval;
+    /* Reseed before every generate request */
+    bool               prediction_resistance;
+    ctr_drbg_entropy_t get_entropy;
+    /* Bytes requested from get_entropy per reseed */
+    size_t             entropy_len;
+    /* Reseeds done, including those for prediction resistance */
+    uint32_t           reseeds;
+    bool               instantiated;
+} ctr_drbg_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_cryptolite_status_t ctr_drbg_instantiate(ctr_drbg_t *drbg,
+                                               ctr_drbg_entropy_t get_entropy,
+                                               uint8_t const *personalization,
+                                               size_t personalization_len,
+                                               uint32_t reseed_interval,
+                                               bool prediction_resistance);
+cy_en_cryptolite_status_t ctr_drbg_reseed(ctr_drbg_t *drbg,
+                                          uint8_t const *additional,
+                                          size_t additional_len);
+cy_en_cryptolite_status_t ctr_drbg_generate(ctr_drbg_t *drbg, uint8_t *out,
+                                            size_t len,
+                                            uint8_t const *additional,
+                                            size_t additional_len);
+void ctr_drbg_uninstantiate(ctr_drbg_t *drbg);
+bool ctr_drbg_self_test(void);
+
+#endif /* SOURCE_CTR_DRBG_H_ */
@@ -0,0 +1,117 @@
+/******************************************************************************
+* File Name: cycle_count.c
+*
+* Description: CPU cycle counter, see cycle_count.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cycle_count.h"
+
+/*******************************************************************************
+* Function Name: cycle_count_init
+********************************************************************************
+* Summary: Enables trace and starts the DWT cycle counter.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cycle_count_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*******************************************************************************
+* Function Name: cycle_count_now
+********************************************************************************
+* Summary: Returns the current cycle count.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - DWT CYCCNT
+*
+*******************************************************************************/
+uint32_t cycle_count_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+/*******************************************************************************
+* Function Name: cycle_count_since
+********************************************************************************
+* Summary: Returns the cycles elapsed since start. Unsigned subtraction keeps
+*          the result right across one counter wrap.
+*
+* Parameters:
+*  uint32_t start - Earlier value of cycle_count_now()
+*
+* Return:
+*  uint32_t - Elapsed cycles
+*
+*******************************************************************************/
+uint32_t cycle_count_since(uint32_t start)
+{
+    return DWT->CYCCNT - start;
+}
+
+/*******************************************************************************
+* Function Name: cycle_count_to_ns
+********************************************************************************
+* Summary: Converts a cycle count to nanoseconds at SystemCoreClock.
+*
+* Parameters:
+*  uint32_t cycles - Cycle count
+*
+* Return:
+*  uint64_t - Nanoseconds
+*
+*******************************************************************************/
+uint64_t cycle_count_to_ns(uint32_t cycles)
+{
+    return ((uint64_t)cycles * 1000000000u) / SystemCoreClock;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,426 @@
+/******************************************************************************
+* File Name: entropy_pool.c
+*
+* Description: TRNG entropy pool, see entropy_pool.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "entropy_pool.h"
+#include "cycle_count.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ENTROPY_POOL_INDEX_MASK              (ENTROPY_POOL_SIZE - 1u)
+#define ENTROPY_POOL_WORD_SIZE               (4u)
+
+#if (((ENTROPY_POOL_SIZE & ENTROPY_POOL_INDEX_MASK) != 0u) || \
+     (ENTROPY_POOL_SIZE < ENTROPY_POOL_WORD_SIZE))
+#error "ENTROPY_POOL_SIZE must be a power of two of at least 4"
+#endif
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint8_t pool[ENTROPY_POOL_SIZE];
+
+/* Free-running indices. head only advances by whole words, so a word never
+ * wraps around the end of the buffer. Both are only used from the main
+ * loop. */
+static uint32_t pool_head;
+static uint32_t pool_tail;
+
+static bool pool_running;
+static entropy_pool_stats_t pool_stats;
+static trng_health_t pool_health;
+
+/*******************************************************************************
+* Function Name: pool_take
+********************************************************************************
+* Summary: Moves up to len bytes out of the pool and wipes them there.
+*
+*******************************************************************************/
+static size_t pool_take(uint8_t *buf, size_t len)
+{
+    size_t count = pool_head - pool_tail;
+    size_t index;
+    size_t run;
+
+    count = (len < count) ? len : count;
+    for (size_t done = 0u; done < count; done += run)
+    {
+        index = (pool_tail + done) & ENTROPY_POOL_INDEX_MASK;
+        run = ENTROPY_POOL_SIZE - index;
+        run = ((count - done) < run) ? (count - done) : run;
+        memcpy(&buf[done], &pool[index], run);
+        memset(&pool[index], 0, run);
+    }
+    pool_tail += (uint32_t)count;
+    pool_stats.bytes_served += (uint32_t)count;
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: trng_checked_word
+********************************************************************************
+* Summary: Reads a TRNG word and runs the health tests on it. A failure
+*          empties the pool, since the bytes before it may belong to the same
+*          bad run.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t trng_checked_word(uint32_t *word)
+{
+    cy_en_cryptolite_status_t res;
+
+    res = Cy_Cryptolite_Trng(CRYPTOLITE, word);
+    if ((res == CY_CRYPTOLITE_SUCCESS) &&
+        (trng_health_check(&pool_health, *word) != TRNG_HEALTH_OK))
+    {
+        memset(pool, 0, sizeof(pool));
+        pool_tail = pool_head;
+        res = CY_CRYPTOLITE_TRNG_UNHEALTHY;
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_init
+********************************************************************************
+* Summary: Starts the TRNG, empties the pool and resets the health tests. The
+*          TRNG stays enabled until entropy_pool_deinit(), so later requests
+*          do not pay its startup.
+*
+* Parameters:
+*  cy_stc_cryptolite_trng_config_t* config - TRNG configuration
+*
+* Return:
+*  cy_en_cryptolite_status_t - Status of Cy_Cryptolite_Trng_Init()
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t entropy_pool_init(
+                                    cy_stc_cryptolite_trng_config_t *config)
+{
+    cy_en_cryptolite_status_t res;
+
+    memset(pool, 0, sizeof(pool));
+    memset(&pool_stats, 0, sizeof(pool_stats));
+    trng_health_init(&pool_health);
+    pool_head = 0u;
+    pool_tail = 0u;
+
+    res = Cy_Cryptolite_Trng_Init(CRYPTOLITE, config);
+    pool_running = (res == CY_CRYPTOLITE_SUCCESS);
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_deinit
+********************************************************************************
+* Summary: Stops the TRNG and wipes the pool.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void entropy_pool_deinit(void)
+{
+    if (pool_running)
+    {
+        Cy_Cryptolite_Trng_DeInit(CRYPTOLITE);
+        pool_running = false;
+    }
+    memset(pool, 0, sizeof(pool));
+    pool_head = 0u;
+    pool_tail = 0u;
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_refill
+********************************************************************************
+* Summary: Generates up to max_words TRNG words into the free space of the
+*          pool, checking each with the health tests, and records how long
+*          that took.
+*
+* Parameters:
+*  uint32_t max_words - Most words to generate
+*
+* Return:
+*  cy_en_cryptolite_status_t - Status of Cy_Cryptolite_Trng(), or
+*                              CY_CRYPTOLITE_TRNG_UNHEALTHY once a health
+*                              test has failed
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t entropy_pool_refill(uint32_t max_words)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+    uint32_t words;
+    uint32_t value;
+    uint32_t start;
+    uint32_t cycles;
+
+    if (!pool_running)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+    if (pool_health.status != TRNG_HEALTH_OK)
+    {
+        return CY_CRYPTOLITE_TRNG_UNHEALTHY;
+    }
+
+    words = (ENTROPY_POOL_SIZE - (pool_head - pool_tail)) /
+            ENTROPY_POOL_WORD_SIZE;
+    words = (max_words < words) ? max_words : words;
+    if (words == 0u)
+    {
+        return CY_CRYPTOLITE_SUCCESS;
+    }
+
+    start = cycle_count_now();
+    for (uint32_t i = 0u; (i < words) && (res == CY_CRYPTOLITE_SUCCESS); i++)
+    {
+        res = trng_checked_word(&value);
+        if (res == CY_CRYPTOLITE_SUCCESS)
+        {
+            memcpy(&pool[pool_head & ENTROPY_POOL_INDEX_MASK], &value,
+                   ENTROPY_POOL_WORD_SIZE);
+            pool_head += ENTROPY_POOL_WORD_SIZE;
+            pool_stats.refill_words++;
+        }
+    }
+    cycles = cycle_count_since(start);
+
+    pool_stats.refills++;
+    pool_stats.refill_cycles += cycles;
+    if (cycles > pool_stats.max_refill_cycles)
+    {
+        pool_stats.max_refill_cycles = cycles;
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_word
+********************************************************************************
+* Summary: Generates one health-checked TRNG word for the caller, bypassing
+*          the pool, for bulk consumers that write straight to their own
+*          buffer.
+*
+* Parameters:
+*  uint32_t* word - Set to the TRNG word, or to 0 on failure
+*
+* Return:
+*  cy_en_cryptolite_status_t - Status of Cy_Cryptolite_Trng(), or
+*                              CY_CRYPTOLITE_TRNG_UNHEALTHY once a health
+*                              test has failed
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t entropy_pool_word(uint32_t *word)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_TRNG_UNHEALTHY;
+
+    if (!pool_running)
+    {
+        res = CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+    else if (pool_health.status == TRNG_HEALTH_OK)
+    {
+        res = trng_checked_word(word);
+    }
+
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        pool_stats.direct_words++;
+    }
+    else
+    {
+        *word = 0u;
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_idle
+********************************************************************************
+* Summary: One bounded step of background refill, for the idle loop.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - True if TRNG words were generated, false if the pool is full or
+*         the TRNG failed, in which case the caller may sleep
+*
+*******************************************************************************/
+bool entropy_pool_idle(void)
+{
+    uint32_t before = pool_head;
+
+    if (!pool_running ||
+        ((ENTROPY_POOL_SIZE - (pool_head - pool_tail)) < ENTROPY_POOL_WORD_SIZE))
+    {
+        return false;
+    }
+    (void)entropy_pool_refill(ENTROPY_POOL_IDLE_WORDS);
+    return (pool_head != before);
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_get_random
+********************************************************************************
+* Summary: Copies up to len random bytes from the pool without waiting for
+*          the TRNG.
+*
+* Parameters:
+*  uint8_t* buf - Output buffer
+*  size_t len   - Number of bytes wanted
+*
+* Return:
+*  size_t - Number of bytes copied, less than len if the pool ran short
+*
+*******************************************************************************/
+size_t entropy_pool_get_random(uint8_t *buf, size_t len)
+{
+    size_t count;
+
+    if ((buf == NULL) || (len == 0u))
+    {
+        return 0u;
+    }
+
+    pool_stats.requests++;
+    count = pool_take(buf, len);
+    if (count == len)
+    {
+        pool_stats.hits++;
+    }
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_read
+********************************************************************************
+* Summary: Copies len random bytes, serving from the pool first and
+*          generating the rest directly when the pool runs short.
+*
+* Parameters:
+*  uint8_t* buf - Output buffer
+*  size_t len   - Number of bytes wanted
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t entropy_pool_read(uint8_t *buf, size_t len)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+    size_t done;
+    size_t missing;
+    uint32_t words;
+
+    if ((buf == NULL) && (len != 0u))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    pool_stats.requests++;
+    done = pool_take(buf, len);
+    if (done == len)
+    {
+        pool_stats.hits++;
+    }
+
+    while ((res == CY_CRYPTOLITE_SUCCESS) && (done < len))
+    {
+        missing = len - done;
+        words = (uint32_t)((missing + ENTROPY_POOL_WORD_SIZE - 1u) /
+                           ENTROPY_POOL_WORD_SIZE);
+        res = entropy_pool_refill(words);
+        done += pool_take(&buf[done], missing);
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_get_stats
+********************************************************************************
+* Summary: Returns the pool counters.
+*
+* Parameters:
+*  entropy_pool_stats_t* stats - Filled with the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void entropy_pool_get_stats(entropy_pool_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = pool_stats;
+        stats->available = pool_head - pool_tail;
+        stats->health = pool_health.status;
+        stats->health_samples = pool_health.samples;
+        stats->max_rct_count = pool_health.max_rct_count;
+        stats->max_apt_count = pool_health.max_apt_count;
+    }
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_health
+********************************************************************************
+* Summary: Returns the health test status of the TRNG. Anything other than
+*          TRNG_HEALTH_OK means the pool has stopped serving bytes.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  trng_health_status_t
+*
+*******************************************************************************/
+trng_health_status_t entropy_pool_health(void)
+{
+    return pool_health.status;
+}
+
+/* [] END OF FILE */
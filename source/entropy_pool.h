@@ -0,0 +1,111 @@
+/******************************************************************************
+* File Name: entropy_pool.h
+*
+* Description: Persistent TRNG entropy pool. The TRNG is started once and left
+* running, and a ring buffer of random bytes is topped up in small steps from
+* the application's idle loop. entropy_pool_get_random() never waits for the
+* TRNG: it returns what the pool holds. entropy_pool_read() refills
+* synchronously when the pool runs short. Every TRNG word passes the SP
+* 800-90B health tests before it enters the pool; after a failure the pool
+* is emptied and stays empty until entropy_pool_init() is called again.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_ENTROPY_POOL_H_
+#define SOURCE_ENTROPY_POOL_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "trng_health.h"
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the pool in bytes. Must be a power of two and a multiple of 4. */
+#ifndef ENTROPY_POOL_SIZE
+#define ENTROPY_POOL_SIZE                    (256u)
+#endif
+
+/* TRNG words generated per idle step, bounding the time one step takes */
+#define ENTROPY_POOL_IDLE_WORDS              (4u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef struct
+{
+    /* entropy_pool_get_random() and entropy_pool_read() calls */
+    uint32_t requests;
+    /* Requests served entirely from the pool */
+    uint32_t hits;
+    uint32_t bytes_served;
+    /* Calls that generated at least one TRNG word */
+    uint32_t refills;
+    uint32_t refill_words;
+    /* Cycle counts of those calls */
+    uint64_t refill_cycles;
+    uint32_t max_refill_cycles;
+    /* Words handed out by entropy_pool_word() */
+    uint32_t direct_words;
+    /* Bytes currently in the pool */
+    uint32_t available;
+    /* Health test state, see trng_health_t */
+    trng_health_status_t health;
+    uint32_t health_samples;
+    uint16_t max_rct_count;
+    uint16_t max_apt_count;
+} entropy_pool_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_cryptolite_status_t entropy_pool_init(
+                                    cy_stc_cryptolite_trng_config_t *config);
+void entropy_pool_deinit(void);
+cy_en_cryptolite_status_t entropy_pool_refill(uint32_t max_words);
+cy_en_cryptolite_status_t entropy_pool_word(uint32_t *word);
+bool entropy_pool_idle(void);
+size_t entropy_pool_get_random(uint8_t *buf, size_t len);
+cy_en_cryptolite_status_t entropy_pool_read(uint8_t *buf, size_t len);
+void entropy_pool_get_stats(entropy_pool_stats_t *stats);
+trng_health_status_t entropy_pool_health(void);
+
+#endif /* SOURCE_ENTROPY_POOL_H_ */
+
+/* [] END OF FILE */
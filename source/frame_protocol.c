@@ -0,0 +1,327 @@
+/******************************************************************************
+* File Name: frame_protocol.c
+*
+* Description: Length-prefixed binary frame protocol on the debug UART.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "frame_protocol.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
+#include "trace_ring.h"
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FRAME_CRC_INIT                       (0xFFFFu)
+#define FRAME_MAX_SIZE                       (FRAME_HEADER_SIZE + \
+                                              FRAME_MAX_PAYLOAD + FRAME_CRC_SIZE)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* CRC-16/CCITT (polynomial 0x1021) remainders for one nibble */
+static const uint16_t crc16_nibble_table[16] =
+{
+    0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+    0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu,
+};
+
+static frame_command_t const *frame_commands;
+static uint32_t frame_command_count;
+static frame_idle_handler_t frame_idle_handler;
+
+/* Frame being received and the number of its bytes collected so far */
+static uint8_t rx_frame[FRAME_MAX_SIZE];
+static uint32_t rx_frame_pos;
+
+static uint8_t response_payload[FRAME_MAX_PAYLOAD];
+
+/*******************************************************************************
+* Function Name: frame_crc16
+********************************************************************************
+* Summary: Updates a CRC-16/CCITT-FALSE with len bytes, a nibble at a time.
+*          Start with 0xFFFF.
+*
+* Parameters:
+*  uint16_t crc         - CRC of the preceding data
+*  uint8_t const* data  - Data to add
+*  uint32_t len         - Number of bytes
+*
+* Return:
+*  uint16_t - Updated CRC
+*
+*******************************************************************************/
+uint16_t frame_crc16(uint16_t crc, uint8_t const *data, uint32_t len)
+{
+    for (uint32_t i = 0u; i < len; i++)
+    {
+        crc = (uint16_t)((crc << 4) ^
+              crc16_nibble_table[((crc >> 12) ^ (data[i] >> 4)) & 0x0Fu]);
+        crc = (uint16_t)((crc << 4) ^
+              crc16_nibble_table[((crc >> 12) ^ data[i]) & 0x0Fu]);
+    }
+    return crc;
+}
+
+/*******************************************************************************
+* Function Name: frame_send
+********************************************************************************
+* Summary: Queues a response frame in the UART transmit buffer.
+*
+*******************************************************************************/
+static void frame_send(uint8_t cmd, frame_status_t status, uint8_t seq,
+                       uint8_t const *payload, uint16_t len)
+{
+    uint8_t header[FRAME_HEADER_SIZE];
+    uint8_t trailer[FRAME_CRC_SIZE];
+    uint16_t crc;
+
+    header[0] = FRAME_SOF;
+    header[1] = cmd | FRAME_RESPONSE;
+    header[2] = (uint8_t)status;
+    header[3] = seq;
+    header[4] = (uint8_t)len;
+    header[5] = (uint8_t)(len >> 8);
+
+    crc = frame_crc16(FRAME_CRC_INIT, &header[1], FRAME_HEADER_SIZE - 1u);
+    crc = frame_crc16(crc, payload, len);
+    trailer[0] = (uint8_t)crc;
+    trailer[1] = (uint8_t)(crc >> 8);
+
+    uart_tx_write(header, FRAME_HEADER_SIZE);
+    uart_tx_write(payload, len);
+    uart_tx_write(trailer, FRAME_CRC_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: frame_dispatch
+********************************************************************************
+* Summary: Checks a complete frame and answers it. Returns false for
+*          FRAME_CMD_EXIT.
+*
+*******************************************************************************/
+static bool frame_dispatch(void)
+{
+    frame_t request;
+    frame_status_t status = FRAME_STATUS_BAD_COMMAND;
+    uint16_t response_len = 0u;
+    uint16_t crc;
+
+    request.cmd = rx_frame[1];
+    request.flags = rx_frame[2];
+    request.seq = rx_frame[3];
+    request.len = (uint16_t)(rx_frame[4] | ((uint16_t)rx_frame[5] << 8));
+    request.payload = &rx_frame[FRAME_HEADER_SIZE];
+
+    crc = frame_crc16(FRAME_CRC_INIT, &rx_frame[1],
+                      (FRAME_HEADER_SIZE - 1u) + request.len);
+    if ((rx_frame[FRAME_HEADER_SIZE + request.len] != (uint8_t)crc) ||
+        (rx_frame[FRAME_HEADER_SIZE + request.len + 1u] != (uint8_t)(crc >> 8)))
+    {
+        frame_send(request.cmd, FRAME_STATUS_BAD_CRC, request.seq, NULL, 0u);
+        return true;
+    }
+
+    if (request.cmd == FRAME_CMD_EXIT)
+    {
+        frame_send(request.cmd, FRAME_STATUS_OK, request.seq, NULL, 0u);
+        return false;
+    }
+
+    for (uint32_t i = 0u; i < frame_command_count; i++)
+    {
+        if (frame_commands[i].cmd == request.cmd)
+        {
+            trace_ring_record(TRACE_EVENT_FRAME_BEGIN, request.cmd,
+                              request.len);
+            status = frame_commands[i].handler(&request, response_payload,
+                                               &response_len);
+            trace_ring_record(TRACE_EVENT_FRAME_END, request.cmd,
+                              (uint16_t)status);
+            break;
+        }
+    }
+    if (status != FRAME_STATUS_OK)
+    {
+        response_len = 0u;
+    }
+
+    frame_send(request.cmd, status, request.seq, response_payload, response_len);
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: frame_protocol_init
+********************************************************************************
+* Summary: Sets the table of supported commands. FRAME_CMD_EXIT is handled
+*          by the protocol itself.
+*
+* Parameters:
+*  frame_command_t const* commands - Command table
+*  uint32_t count                  - Number of entries
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void frame_protocol_init(frame_command_t const *commands, uint32_t count)
+{
+    frame_commands = commands;
+    frame_command_count = count;
+    rx_frame_pos = 0u;
+}
+
+/*******************************************************************************
+* Function Name: frame_protocol_set_idle_handler
+********************************************************************************
+* Summary: Installs the function run by frame_protocol_poll() while waiting
+*          for input.
+*
+* Parameters:
+*  frame_idle_handler_t handler - Idle handler, or NULL to just sleep
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void frame_protocol_set_idle_handler(frame_idle_handler_t handler)
+{
+    frame_idle_handler = handler;
+}
+
+/*******************************************************************************
+* Function Name: frame_protocol_start
+********************************************************************************
+* Summary: Switches to frame mode after the caller has already consumed the
+*          start-of-frame byte of the first frame.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void frame_protocol_start(void)
+{
+    rx_frame[0] = FRAME_SOF;
+    rx_frame_pos = 1u;
+}
+
+/*******************************************************************************
+* Function Name: frame_protocol_poll
+********************************************************************************
+* Summary: Moves everything received so far into the frame buffer and answers
+*          every complete frame. Bytes outside a frame are skipped until the
+*          next start-of-frame byte. Sleeps when no input is pending.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - false once the host has sent FRAME_CMD_EXIT
+*
+*******************************************************************************/
+bool frame_protocol_poll(void)
+{
+    uint8_t const *data;
+    uint32_t available = uart_rx_peek(&data);
+    uint32_t used = 0u;
+    bool active = true;
+
+    if (available == 0u)
+    {
+        if ((frame_idle_handler == NULL) || !frame_idle_handler())
+        {
+            uart_rx_wait();
+        }
+        return true;
+    }
+
+    while ((used < available) && active)
+    {
+        uint32_t needed;
+        uint32_t count;
+
+        if (rx_frame_pos == 0u)
+        {
+            /* Resynchronize on the start-of-frame byte */
+            if (data[used++] == FRAME_SOF)
+            {
+                rx_frame[rx_frame_pos++] = FRAME_SOF;
+            }
+            continue;
+        }
+
+        needed = FRAME_HEADER_SIZE;
+        if (rx_frame_pos >= FRAME_HEADER_SIZE)
+        {
+            uint32_t len = rx_frame[4] | ((uint32_t)rx_frame[5] << 8);
+            if (len > FRAME_MAX_PAYLOAD)
+            {
+                frame_send(rx_frame[1], FRAME_STATUS_BAD_LENGTH, rx_frame[3],
+                           NULL, 0u);
+                rx_frame_pos = 0u;
+                continue;
+            }
+            needed += len + FRAME_CRC_SIZE;
+        }
+
+        count = needed - rx_frame_pos;
+        if (count > (available - used))
+        {
+            count = available - used;
+        }
+        memcpy(&rx_frame[rx_frame_pos], &data[used], count);
+        rx_frame_pos += count;
+        used += count;
+
+        if ((rx_frame_pos == needed) && (needed > FRAME_HEADER_SIZE))
+        {
+            active = frame_dispatch();
+            rx_frame_pos = 0u;
+        }
+    }
+
+    uart_rx_consume(used);
+    return active;
+}
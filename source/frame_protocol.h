@@ -0,0 +1,235 @@
+/******************************************************************************
+* File Name: frame_protocol.h
+*
+* Description: Length-prefixed binary frame protocol on the debug UART. Lets a
+* host tool send crypto requests back to back without waiting for prompts.
+* Frames are parsed straight out of the UART receive ring buffer and every
+* request is answered with a response frame carrying the same sequence number.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_FRAME_PROTOCOL_H_
+#define SOURCE_FRAME_PROTOCOL_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Frame layout (multi-byte fields are little-endian):
+ *
+ *   SOF | cmd | flags | seq | len (2) | payload (len) | crc (2)
+ *
+ * The CRC is CRC-16/CCITT-FALSE over cmd..payload. A response repeats seq,
+ * sets FRAME_RESPONSE in cmd and carries a frame_status_t in flags.
+ */
+#define FRAME_SOF                            (0xA5u)
+#define FRAME_HEADER_SIZE                    (6u)
+#define FRAME_CRC_SIZE                       (2u)
+#define FRAME_RESPONSE                       (0x80u)
+
+/* Largest data block carried by a request, excluding the IV. Can be raised
+ * up to 65519 bytes (the length field is 16-bit) at the cost of two frame
+ * buffers of that size. */
+#ifndef FRAME_MAX_DATA
+#define FRAME_MAX_DATA                       (256u)
+#endif
+
+/* Largest payload accepted or sent: one IV and FRAME_MAX_DATA bytes */
+#define FRAME_MAX_PAYLOAD                    (16u + FRAME_MAX_DATA)
+
+#if (FRAME_MAX_PAYLOAD > 0xFFFFu)
+#error "FRAME_MAX_DATA does not fit the 16-bit frame length field"
+#endif
+
+/* Commands, with request payload -> response payload:
+ *   PING           any                -> the same bytes
+ *   AES_CTR        IV (16) | data     -> data
+ *   AES_CFB        IV (16) | data     -> data, FRAME_FLAG_DECRYPT to decrypt
+ *   SHA256         message            -> digest (32)
+ *   TRNG           count (2)          -> count random bytes
+ *   SET_KEY        key (16)           -> empty
+ *   SHA256_START   empty              -> empty
+ *   SHA256_UPDATE  part of a message  -> empty
+ *   SHA256_FINISH  empty              -> digest (32)
+ *   HMAC_SET_KEY   key (any length)   -> empty
+ *   HMAC_SHA256    message            -> HMAC-SHA256 (32)
+ *   AES_CCM        tag len (1) | nonce len (1) | nonce | AAD len (2) |
+ *   AES_GCM        AAD | data [| tag] -> data [| tag], FRAME_FLAG_DECRYPT to
+ *                  decrypt and verify the trailing tag; for GCM the nonce
+ *                  is the IV
+ *   AES_CMAC       message            -> AES-CMAC (16) under the SET_KEY key
+ *   AES_BATCH      mode (1) | job count (1) | per job: IV (16) | len (2) |
+ *                  data  -> core clock in Hz (4) | key load cycles (4) |
+ *                  batch cycles (4) | cycles per job (4 each) | data of
+ *                  all jobs; mode is an aes_batch_mode_t and the key is
+ *                  the SET_KEY key
+ *   EXIT           empty              -> empty, then back to the menu
+ *   TRNG_STATS     empty              -> core clock in Hz (4) | entropy
+ *                  pool counters, 4 bytes each: requests | hits | bytes
+ *                  served | refills | refill words | refill cycles (8) |
+ *                  max refill cycles | bytes available | health status
+ *                  (trng_health_status_t) | samples tested | longest
+ *                  repetition | highest adaptive proportion count
+ *   DRBG           count (2) [| additional input, up to 32]
+ *                                     -> count bytes of CTR_DRBG output
+ *   RNG_BENCH      count (4)          -> core clock in Hz (4) | cycles to
+ *                  read count bytes from the TRNG (4) | from the DRBG (4)
+ *   PASSWORD       length (1) [| alphabet, 1 to 256 characters]
+ *                                     -> password of length characters
+ *   OP_STATS       [reset (1)]        -> core clock in Hz (4) | operation
+ *                  count (4) | per op_stats_id_t: calls (4) | min cycles
+ *                  (4) | max cycles (4) | total cycles (8); a reset of 1
+ *                  clears the statistics after they are read
+ *   TRACE_DUMP     first (4)          -> core clock in Hz (4) | next
+ *                  sequence number (4) | sequence number of the first
+ *                  event returned (4) | events from there on, as many as
+ *                  fit: timestamp (4) | type (1) | id (1) | data (2), see
+ *                  trace_event_t
+ *   BLE_SC         function (1) | inputs -> output, for the function
+ *                  (frame_ble_sc_t) and all values most significant byte
+ *                  first as in the Bluetooth Core Specification:
+ *                  f4: U (32) | V (32) | X (16) | Z (1) -> confirm (16)
+ *                  f5: W (32) | N1 (16) | N2 (16) | A1 (7) | A2 (7)
+ *                      -> MacKey (16) | LTK (16)
+ *                  f6: W (16) | N1 (16) | N2 (16) | R (16) | IOcap (3) |
+ *                      A1 (7) | A2 (7) -> check value (16)
+ *                  g2: U (32) | V (32) | X (16) | Y (16) -> value (4)
+ */
+#define FRAME_CMD_PING                       (0x00u)
+#define FRAME_CMD_AES_CTR                    (0x01u)
+#define FRAME_CMD_AES_CFB                    (0x02u)
+#define FRAME_CMD_SHA256                     (0x03u)
+#define FRAME_CMD_TRNG                       (0x04u)
+#define FRAME_CMD_SET_KEY                    (0x05u)
+#define FRAME_CMD_SHA256_START               (0x06u)
+#define FRAME_CMD_SHA256_UPDATE              (0x07u)
+#define FRAME_CMD_SHA256_FINISH              (0x08u)
+#define FRAME_CMD_HMAC_SET_KEY               (0x09u)
+#define FRAME_CMD_HMAC_SHA256                (0x0Au)
+#define FRAME_CMD_AES_CCM                    (0x0Bu)
+#define FRAME_CMD_AES_GCM                    (0x0Cu)
+#define FRAME_CMD_AES_CMAC                   (0x0Du)
+#define FRAME_CMD_AES_BATCH                  (0x0Eu)
+#define FRAME_CMD_EXIT                       (0x0Fu)
+#define FRAME_CMD_TRNG_STATS                 (0x10u)
+#define FRAME_CMD_DRBG                       (0x11u)
+#define FRAME_CMD_RNG_BENCH                  (0x12u)
+#define FRAME_CMD_PASSWORD                   (0x13u)
+#define FRAME_CMD_OP_STATS                   (0x14u)
+#define FRAME_CMD_TRACE_DUMP                 (0x15u)
+#define FRAME_CMD_BLE_SC                     (0x16u)
+
+/* Most jobs that fit one AES_BATCH request: after the mode and count each
+ * job takes at least its IV and length. The response is never longer than
+ * the request, 12 bytes plus 4 per job against 2 plus 18 per job, followed
+ * by the same data. */
+#define FRAME_BATCH_JOB_HEADER_SIZE          (16u + 2u)
+#define FRAME_MAX_BATCH_JOBS_FIT             ((FRAME_MAX_PAYLOAD - 2u) / \
+                                              FRAME_BATCH_JOB_HEADER_SIZE)
+#ifndef FRAME_MAX_BATCH_JOBS
+#define FRAME_MAX_BATCH_JOBS                 FRAME_MAX_BATCH_JOBS_FIT
+#endif
+
+#if (FRAME_MAX_BATCH_JOBS > FRAME_MAX_BATCH_JOBS_FIT)
+#error "FRAME_MAX_BATCH_JOBS jobs do not fit FRAME_MAX_PAYLOAD"
+#endif
+
+/* Request flags */
+#define FRAME_FLAG_DECRYPT                   (0x01u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef enum
+{
+    FRAME_STATUS_OK           = 0x00u,
+    FRAME_STATUS_BAD_CRC      = 0x01u,
+    FRAME_STATUS_BAD_COMMAND  = 0x02u,
+    FRAME_STATUS_BAD_LENGTH   = 0x03u,
+    FRAME_STATUS_CRYPTO_ERROR = 0x04u,
+    FRAME_STATUS_AUTH_FAILED  = 0x05u
+} frame_status_t;
+
+/* Function byte of a BLE_SC request */
+typedef enum
+{
+    FRAME_BLE_SC_F4 = 0x00u,
+    FRAME_BLE_SC_F5 = 0x01u,
+    FRAME_BLE_SC_F6 = 0x02u,
+    FRAME_BLE_SC_G2 = 0x03u
+} frame_ble_sc_t;
+
+typedef struct
+{
+    uint8_t        cmd;
+    uint8_t        flags;
+    uint8_t        seq;
+    uint16_t       len;
+    uint8_t const *payload;
+} frame_t;
+
+/* Request handler. Writes up to FRAME_MAX_PAYLOAD bytes of response payload
+ * and sets *response_len; the return value is sent as the response status. */
+typedef frame_status_t (*frame_handler_t)(frame_t const *request,
+                                          uint8_t *response,
+                                          uint16_t *response_len);
+
+typedef struct
+{
+    uint8_t         cmd;
+    frame_handler_t handler;
+} frame_command_t;
+
+/* Called by frame_protocol_poll() when no input is pending. Does a bounded
+ * amount of background work and returns true, or returns false to let the
+ * poll sleep until input arrives. */
+typedef bool (*frame_idle_handler_t)(void);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void frame_protocol_init(frame_command_t const *commands, uint32_t count);
+void frame_protocol_set_idle_handler(frame_idle_handler_t handler);
+void frame_protocol_start(void);
+bool frame_protocol_poll(void);
+uint16_t frame_crc16(uint16_t crc, uint8_t const *data, uint32_t len);
+
+#endif /* SOURCE_FRAME_PROTOCOL_H_ */
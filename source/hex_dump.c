@@ -0,0 +1,219 @@
+/******************************************************************************
+* File Name: hex_dump.c
+*
+* Description: Fast formatter for binary data printed on the UART terminal.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "hex_dump.h"
+#include "uart_tx.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define LINE_BREAK                           "\r\n"
+#define LINE_BREAK_LENGTH                    (2u)
+
+/* Longest rendered line including the leading line break */
+#define MAX_LINE_LENGTH                      (LINE_BREAK_LENGTH + \
+                                              (5u * HEX_DUMP_BYTES_PER_LINE))
+
+#if (HEX_DUMP_BUFFER_SIZE < (MAX_LINE_LENGTH + LINE_BREAK_LENGTH))
+#error "HEX_DUMP_BUFFER_SIZE is too small for one line"
+#endif
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char hex_digits[16] =
+{
+    '0', '1', '2', '3', '4', '5', '6', '7',
+    '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+static const char base64_digits[64] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static char dump_buffer[HEX_DUMP_BUFFER_SIZE];
+
+/*******************************************************************************
+* Function Name: format_base64
+********************************************************************************
+* Summary: Encodes len bytes as base64, padding the final group with '='.
+*
+*******************************************************************************/
+static uint32_t format_base64(char *out, uint8_t const *data, uint32_t len)
+{
+    char *p = out;
+    uint32_t i;
+
+    for (i = 0u; (i + 3u) <= len; i += 3u)
+    {
+        uint32_t group = ((uint32_t)data[i] << 16) |
+                         ((uint32_t)data[i + 1u] << 8) | data[i + 2u];
+        *p++ = base64_digits[(group >> 18) & 0x3Fu];
+        *p++ = base64_digits[(group >> 12) & 0x3Fu];
+        *p++ = base64_digits[(group >> 6) & 0x3Fu];
+        *p++ = base64_digits[group & 0x3Fu];
+    }
+
+    if (i < len)
+    {
+        uint32_t group = (uint32_t)data[i] << 16;
+        if ((i + 1u) < len)
+        {
+            group |= (uint32_t)data[i + 1u] << 8;
+        }
+        *p++ = base64_digits[(group >> 18) & 0x3Fu];
+        *p++ = base64_digits[(group >> 12) & 0x3Fu];
+        *p++ = ((i + 1u) < len) ? base64_digits[(group >> 6) & 0x3Fu] : '=';
+        *p++ = '=';
+    }
+
+    return (uint32_t)(p - out);
+}
+
+/*******************************************************************************
+* Function Name: hex_dump_format_line
+********************************************************************************
+* Summary: Renders one line of output for data, without line breaks. len must
+*          not exceed HEX_DUMP_BYTES_PER_LINE (HEX_DUMP_BASE64_BYTES_PER_LINE
+*          for base64). The output is not NUL-terminated.
+*
+* Parameters:
+*  char* out                - Destination, at least 5 * len characters
+*  uint8_t const* data      - Bytes to render
+*  uint32_t len             - Number of bytes
+*  hex_dump_format_t format - Output format
+*
+* Return:
+*  uint32_t - Number of characters written
+*
+*******************************************************************************/
+uint32_t hex_dump_format_line(char *out, uint8_t const *data, uint32_t len,
+                              hex_dump_format_t format)
+{
+    char *p = out;
+
+    switch (format)
+    {
+        case HEX_DUMP_FORMAT_PREFIXED:
+        {
+            for (uint32_t i = 0u; i < len; i++)
+            {
+                p[0] = '0';
+                p[1] = 'x';
+                p[2] = hex_digits[data[i] >> 4];
+                p[3] = hex_digits[data[i] & 0x0Fu];
+                p[4] = ' ';
+                p += 5;
+            }
+            break;
+        }
+
+        case HEX_DUMP_FORMAT_COMPACT:
+        {
+            for (uint32_t i = 0u; i < len; i++)
+            {
+                p[0] = hex_digits[data[i] >> 4];
+                p[1] = hex_digits[data[i] & 0x0Fu];
+                p += 2;
+            }
+            break;
+        }
+
+        case HEX_DUMP_FORMAT_BASE64:
+        {
+            p += format_base64(p, data, len);
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return (uint32_t)(p - out);
+}
+
+/*******************************************************************************
+* Function Name: hex_dump
+********************************************************************************
+* Summary: Prints data in the requested format. Every line starts with a line
+*          break and the dump ends with one, matching the original
+*          print_data() output. Lines are collected in a buffer that is
+*          passed to the UART transmit buffer whenever the next line would
+*          not fit.
+*
+* Parameters:
+*  uint8_t const* data      - Bytes to print
+*  size_t len               - Number of bytes
+*  hex_dump_format_t format - Output format
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hex_dump(uint8_t const *data, size_t len, hex_dump_format_t format)
+{
+    uint32_t per_line = (format == HEX_DUMP_FORMAT_BASE64) ?
+                        HEX_DUMP_BASE64_BYTES_PER_LINE : HEX_DUMP_BYTES_PER_LINE;
+    uint32_t used = 0u;
+
+    while (len > 0u)
+    {
+        uint32_t chunk = (len < per_line) ? (uint32_t)len : per_line;
+
+        /* Keep room for this line and the final line break */
+        if ((used + MAX_LINE_LENGTH + LINE_BREAK_LENGTH) > HEX_DUMP_BUFFER_SIZE)
+        {
+            uart_tx_write(dump_buffer, used);
+            used = 0u;
+        }
+
+        dump_buffer[used++] = LINE_BREAK[0];
+        dump_buffer[used++] = LINE_BREAK[1];
+        used += hex_dump_format_line(&dump_buffer[used], data, chunk, format);
+        data += chunk;
+        len -= chunk;
+    }
+
+    dump_buffer[used++] = LINE_BREAK[0];
+    dump_buffer[used++] = LINE_BREAK[1];
+    uart_tx_write(dump_buffer, used);
+}
@@ -0,0 +1,85 @@
+/******************************************************************************
+* File Name: hex_dump.h
+*
+* Description: Fast formatter for binary data printed on the UART terminal.
+* Whole lines are rendered into a buffer from a nibble lookup table and written
+* out with one call per buffer instead of one snprintf()/printf() pair per
+* byte.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_HEX_DUMP_H_
+#define SOURCE_HEX_DUMP_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bytes per line for the hexadecimal formats */
+#define HEX_DUMP_BYTES_PER_LINE              (16u)
+
+/* Bytes per line for base64; a multiple of 3 so lines need no padding */
+#define HEX_DUMP_BASE64_BYTES_PER_LINE       (48u)
+
+/* Size of the output buffer. Must hold at least one rendered line. */
+#define HEX_DUMP_BUFFER_SIZE                 (256u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef enum
+{
+    /* "0xAA 0xBB ..." - the classic print_data() layout */
+    HEX_DUMP_FORMAT_PREFIXED,
+    /* "AABB..." */
+    HEX_DUMP_FORMAT_COMPACT,
+    /* RFC 4648 base64 */
+    HEX_DUMP_FORMAT_BASE64
+} hex_dump_format_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint32_t hex_dump_format_line(char *out, uint8_t const *data, uint32_t len,
+                              hex_dump_format_t format);
+void hex_dump(uint8_t const *data, size_t len, hex_dump_format_t format);
+
+#endif /* SOURCE_HEX_DUMP_H_ */
@@ -0,0 +1,308 @@
+/******************************************************************************
+* File Name: hmac_sha256.c
+*
+* Description: HMAC-SHA256 with cached padded-key midstates, see hmac_sha256.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "hmac_sha256.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define HMAC_IPAD                            (0x36u)
+#define HMAC_OPAD                            (0x5Cu)
+
+/*******************************************************************************
+* Function Name: hmac_absorb_pad
+********************************************************************************
+* Summary: Starts the stream over one block of key ^ pad and saves the state.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t hmac_absorb_pad(hmac_sha256_t *hmac,
+                                                 uint8_t const *key_block,
+                                                 uint8_t pad,
+                                                 sha256_stream_snapshot_t *state)
+{
+    cy_en_cryptolite_status_t res;
+    uint8_t block[SHA256_STREAM_BLOCK_SIZE];
+
+    for (uint32_t i = 0u; i < SHA256_STREAM_BLOCK_SIZE; i++)
+    {
+        block[i] = key_block[i] ^ pad;
+    }
+
+    res = sha256_stream_start(&hmac->stream);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = sha256_stream_update(&hmac->stream, block, sizeof(block));
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = sha256_stream_save(&hmac->stream, state);
+    }
+    sha256_stream_abort(&hmac->stream);
+    memset(block, 0, sizeof(block));
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: hmac_sha256_set_key
+********************************************************************************
+* Summary: Derives and caches the inner and outer midstates for a key. Keys
+*          longer than one SHA-256 block are hashed first, as RFC 2104
+*          requires. The key itself is not retained.
+*
+* Parameters:
+*  hmac_sha256_t* hmac - Context to key
+*  uint8_t const* key  - Key bytes
+*  size_t key_len      - Key length, any value
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t hmac_sha256_set_key(hmac_sha256_t *hmac,
+                                              uint8_t const *key,
+                                              size_t key_len)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+    uint8_t key_block[SHA256_STREAM_BLOCK_SIZE] = {0u};
+
+    if ((hmac == NULL) || ((key_len != 0u) && (key == NULL)))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    hmac_sha256_clear(hmac);
+
+    if (key_len > SHA256_STREAM_BLOCK_SIZE)
+    {
+        res = sha256_stream_start(&hmac->stream);
+        if (res == CY_CRYPTOLITE_SUCCESS)
+        {
+            res = sha256_stream_update(&hmac->stream, key, key_len);
+        }
+        if (res == CY_CRYPTOLITE_SUCCESS)
+        {
+            res = sha256_stream_finish(&hmac->stream, key_block);
+        }
+        sha256_stream_abort(&hmac->stream);
+    }
+    else if (key_len != 0u)
+    {
+        memcpy(key_block, key, key_len);
+    }
+
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = hmac_absorb_pad(hmac, key_block, HMAC_IPAD, &hmac->inner);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = hmac_absorb_pad(hmac, key_block, HMAC_OPAD, &hmac->outer);
+    }
+    memset(key_block, 0, sizeof(key_block));
+
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        hmac->keyed = true;
+    }
+    else
+    {
+        hmac_sha256_clear(hmac);
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: hmac_sha256_start
+********************************************************************************
+* Summary: Starts a MAC by resuming from the cached inner midstate. A MAC
+*          still in progress is discarded.
+*
+* Parameters:
+*  hmac_sha256_t* hmac - Keyed context
+*
+* Return:
+*  cy_en_cryptolite_status_t - CY_CRYPTOLITE_NOT_INITIALIZED without a key
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t hmac_sha256_start(hmac_sha256_t *hmac)
+{
+    if (hmac == NULL)
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!hmac->keyed)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    sha256_stream_abort(&hmac->stream);
+    return sha256_stream_restore(&hmac->stream, &hmac->inner);
+}
+
+/*******************************************************************************
+* Function Name: hmac_sha256_update
+********************************************************************************
+* Summary: Absorbs the next len bytes of the message.
+*
+* Parameters:
+*  hmac_sha256_t* hmac - Started context
+*  uint8_t const* data - Message bytes
+*  size_t len          - Number of bytes
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t hmac_sha256_update(hmac_sha256_t *hmac,
+                                             uint8_t const *data,
+                                             size_t len)
+{
+    if (hmac == NULL)
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    return sha256_stream_update(&hmac->stream, data, len);
+}
+
+/*******************************************************************************
+* Function Name: hmac_sha256_finish
+********************************************************************************
+* Summary: Completes the inner hash and hashes it from the cached outer
+*          midstate. The key stays cached for the next MAC.
+*
+* Parameters:
+*  hmac_sha256_t* hmac - Started context
+*  uint8_t* mac        - Receives HMAC_SHA256_MAC_SIZE bytes
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t hmac_sha256_finish(hmac_sha256_t *hmac,
+                                             uint8_t *mac)
+{
+    cy_en_cryptolite_status_t res;
+    uint8_t inner_digest[SHA256_STREAM_DIGEST_SIZE];
+
+    if ((hmac == NULL) || (mac == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    res = sha256_stream_finish(&hmac->stream, inner_digest);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = sha256_stream_restore(&hmac->stream, &hmac->outer);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = sha256_stream_update(&hmac->stream, inner_digest,
+                                   sizeof(inner_digest));
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = sha256_stream_finish(&hmac->stream, mac);
+    }
+    sha256_stream_abort(&hmac->stream);
+    memset(inner_digest, 0, sizeof(inner_digest));
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: hmac_sha256
+********************************************************************************
+* Summary: Computes the MAC of a message held in one buffer.
+*
+* Parameters:
+*  hmac_sha256_t* hmac - Keyed context
+*  uint8_t const* data - Message
+*  size_t len          - Message length
+*  uint8_t* mac        - Receives HMAC_SHA256_MAC_SIZE bytes
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t hmac_sha256(hmac_sha256_t *hmac,
+                                      uint8_t const *data, size_t len,
+                                      uint8_t *mac)
+{
+    cy_en_cryptolite_status_t res;
+
+    res = hmac_sha256_start(hmac);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = hmac_sha256_update(hmac, data, len);
+    }
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = hmac_sha256_finish(hmac, mac);
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: hmac_sha256_clear
+********************************************************************************
+* Summary: Releases the stream and wipes the cached midstates.
+*
+* Parameters:
+*  hmac_sha256_t* hmac - Context to clear
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hmac_sha256_clear(hmac_sha256_t *hmac)
+{
+    if (hmac != NULL)
+    {
+        sha256_stream_abort(&hmac->stream);
+        memset(&hmac->inner, 0, sizeof(hmac->inner));
+        memset(&hmac->outer, 0, sizeof(hmac->outer));
+        hmac->keyed = false;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,91 @@
+/******************************************************************************
+* File Name: hmac_sha256.h
+*
+* Description: HMAC-SHA256 (RFC 2104) on top of the incremental SHA-256 stream.
+* The SHA-256 states after absorbing the inner and outer padded key are
+* computed once per key and restored for every MAC, which saves two compression
+* function calls per message.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_HMAC_SHA256_H_
+#define SOURCE_HMAC_SHA256_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "sha256_stream.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define HMAC_SHA256_MAC_SIZE                 (SHA256_STREAM_DIGEST_SIZE)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+/* Keyed HMAC context. The midstates are tied to 'stream', so a context must
+ * not be moved or copied after hmac_sha256_set_key(). Zero-initialize a
+ * context before its first use. */
+typedef struct
+{
+    sha256_stream_t          stream;
+    /* States after absorbing key ^ ipad and key ^ opad */
+    sha256_stream_snapshot_t inner;
+    sha256_stream_snapshot_t outer;
+    bool                     keyed;
+} hmac_sha256_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_cryptolite_status_t hmac_sha256_set_key(hmac_sha256_t *hmac,
+                                              uint8_t const *key,
+                                              size_t key_len);
+cy_en_cryptolite_status_t hmac_sha256_start(hmac_sha256_t *hmac);
+cy_en_cryptolite_status_t hmac_sha256_update(hmac_sha256_t *hmac,
+                                             uint8_t const *data,
+                                             size_t len);
+cy_en_cryptolite_status_t hmac_sha256_finish(hmac_sha256_t *hmac,
+                                             uint8_t *mac);
+cy_en_cryptolite_status_t hmac_sha256(hmac_sha256_t *hmac,
+                                      uint8_t const *data, size_t len,
+                                      uint8_t *mac);
+void hmac_sha256_clear(hmac_sha256_t *hmac);
+
+#endif /* SOURCE_HMAC_SHA256_H_ */
+
+/* [] END OF FILE */
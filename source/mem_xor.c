@@ -0,0 +1,148 @@
+/******************************************************************************
+* File Name: mem_xor.c
+*
+* Description: Word-wide XOR kernel, see mem_xor.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "mem_xor.h"
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define MEM_XOR_WORD_SIZE                    (sizeof(uint32_t))
+
+/*******************************************************************************
+* Function Name: mem_xor
+********************************************************************************
+* Summary: dst[i] = a[i] ^ b[i] for len bytes. dst may equal a or b; other
+*          overlaps are not supported.
+*
+*          Vector loads and stores are unaligned. The 32-bit word loop first
+*          steps dst to a word boundary so that stores are aligned; loads are
+*          then aligned too whenever a and b share dst's alignment, as they
+*          do for buffers of a block cipher. Words are moved with memcpy(),
+*          which becomes a single LDR/STR on cores with unaligned access.
+*
+* Parameters:
+*  uint8_t* dst     - Output buffer of len bytes
+*  uint8_t const* a - First input
+*  uint8_t const* b - Second input
+*  size_t len       - Number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void mem_xor(uint8_t *dst, uint8_t const *a, uint8_t const *b, size_t len)
+{
+    uint32_t wa;
+    uint32_t wb;
+
+#if defined(__AVX2__)
+    while (len >= sizeof(__m256i))
+    {
+        __m256i va = _mm256_loadu_si256((__m256i const *)(void const *)a);
+        __m256i vb = _mm256_loadu_si256((__m256i const *)(void const *)b);
+
+        _mm256_storeu_si256((__m256i *)(void *)dst, _mm256_xor_si256(va, vb));
+        dst += sizeof(__m256i);
+        a += sizeof(__m256i);
+        b += sizeof(__m256i);
+        len -= sizeof(__m256i);
+    }
+#endif
+#if defined(__SSE2__)
+    while (len >= sizeof(__m128i))
+    {
+        __m128i va = _mm_loadu_si128((__m128i const *)(void const *)a);
+        __m128i vb = _mm_loadu_si128((__m128i const *)(void const *)b);
+
+        _mm_storeu_si128((__m128i *)(void *)dst, _mm_xor_si128(va, vb));
+        dst += sizeof(__m128i);
+        a += sizeof(__m128i);
+        b += sizeof(__m128i);
+        len -= sizeof(__m128i);
+    }
+#elif defined(__ARM_NEON)
+    while (len >= sizeof(uint8x16_t))
+    {
+        vst1q_u8(dst, veorq_u8(vld1q_u8(a), vld1q_u8(b)));
+        dst += sizeof(uint8x16_t);
+        a += sizeof(uint8x16_t);
+        b += sizeof(uint8x16_t);
+        len -= sizeof(uint8x16_t);
+    }
+#endif
+
+    if (len >= (2u * MEM_XOR_WORD_SIZE))
+    {
+        while (((uintptr_t)dst % MEM_XOR_WORD_SIZE) != 0u)
+        {
+            *dst++ = *a++ ^ *b++;
+            len--;
+        }
+        while (len >= MEM_XOR_WORD_SIZE)
+        {
+            memcpy(&wa, a, MEM_XOR_WORD_SIZE);
+            memcpy(&wb, b, MEM_XOR_WORD_SIZE);
+            wa ^= wb;
+            memcpy(dst, &wa, MEM_XOR_WORD_SIZE);
+            dst += MEM_XOR_WORD_SIZE;
+            a += MEM_XOR_WORD_SIZE;
+            b += MEM_XOR_WORD_SIZE;
+            len -= MEM_XOR_WORD_SIZE;
+        }
+    }
+
+    while (len != 0u)
+    {
+        *dst++ = *a++ ^ *b++;
+        len--;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,203 @@
+/******************************************************************************
+* File Name: op_stats.c
+*
+* Description: Per-operation timing statistics, see op_stats.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "op_stats.h"
+#include "cycle_count.h"
+#include "trace_ring.h"
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static op_stats_entry_t op_stats[OP_STATS_COUNT];
+
+/* Names for reports, indexed by op_stats_id_t */
+static char const *const op_stats_names[OP_STATS_COUNT] =
+{
+    [OP_STATS_AES_CTR]     = "AES CTR",
+    [OP_STATS_AES_CFB]     = "AES CFB",
+    [OP_STATS_AES_CCM]     = "AES CCM",
+    [OP_STATS_AES_GCM]     = "AES GCM",
+    [OP_STATS_AES_CMAC]    = "AES CMAC",
+    [OP_STATS_SHA256]      = "SHA-256",
+    [OP_STATS_HMAC_SHA256] = "HMAC-SHA256",
+    [OP_STATS_TRNG]        = "TRNG",
+    [OP_STATS_DRBG]        = "CTR_DRBG",
+    [OP_STATS_UART_PRINT]  = "UART print",
+    [OP_STATS_BLE_SC]      = "BLE SC",
+};
+
+/*******************************************************************************
+* Function Name: op_stats_reset
+********************************************************************************
+* Summary: Clears the statistics of all operations.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void op_stats_reset(void)
+{
+    memset(op_stats, 0, sizeof(op_stats));
+}
+
+/*******************************************************************************
+* Function Name: op_stats_record
+********************************************************************************
+* Summary: Adds one timed call of an operation.
+*
+* Parameters:
+*  op_stats_id_t op - Operation
+*  uint32_t cycles  - Its duration, from cycle_count_since()
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void op_stats_record(op_stats_id_t op, uint32_t cycles)
+{
+    op_stats_entry_t *entry;
+
+    if (op >= OP_STATS_COUNT)
+    {
+        return;
+    }
+    entry = &op_stats[op];
+
+    if ((entry->count == 0u) || (cycles < entry->min_cycles))
+    {
+        entry->min_cycles = cycles;
+    }
+    if (cycles > entry->max_cycles)
+    {
+        entry->max_cycles = cycles;
+    }
+    entry->total_cycles += cycles;
+    entry->count++;
+}
+
+/*******************************************************************************
+* Function Name: op_stats_begin
+********************************************************************************
+* Summary: Marks the start of an operation in the trace and returns the cycle
+*          count to pass to op_stats_end().
+*
+* Parameters:
+*  op_stats_id_t op - Operation
+*
+* Return:
+*  uint32_t - Start cycle count
+*
+*******************************************************************************/
+uint32_t op_stats_begin(op_stats_id_t op)
+{
+    trace_ring_record(TRACE_EVENT_OP_BEGIN, (uint8_t)op, 0u);
+    return cycle_count_now();
+}
+
+/*******************************************************************************
+* Function Name: op_stats_end
+********************************************************************************
+* Summary: Adds the operation started at start to its statistics and marks
+*          its end in the trace.
+*
+* Parameters:
+*  op_stats_id_t op - Operation
+*  uint32_t start   - Return value of op_stats_begin()
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void op_stats_end(op_stats_id_t op, uint32_t start)
+{
+    op_stats_record(op, cycle_count_since(start));
+    trace_ring_record(TRACE_EVENT_OP_END, (uint8_t)op, 0u);
+}
+
+/*******************************************************************************
+* Function Name: op_stats_get
+********************************************************************************
+* Summary: Reads the statistics of one operation.
+*
+* Parameters:
+*  op_stats_id_t op         - Operation
+*  op_stats_entry_t* entry  - Filled with its statistics, all zero for an
+*                             unknown operation
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void op_stats_get(op_stats_id_t op, op_stats_entry_t *entry)
+{
+    if (op >= OP_STATS_COUNT)
+    {
+        memset(entry, 0, sizeof(*entry));
+        return;
+    }
+    *entry = op_stats[op];
+}
+
+/*******************************************************************************
+* Function Name: op_stats_name
+********************************************************************************
+* Summary: Returns a printable name of an operation.
+*
+* Parameters:
+*  op_stats_id_t op - Operation
+*
+* Return:
+*  char const* - Name, "?" for an unknown operation
+*
+*******************************************************************************/
+char const *op_stats_name(op_stats_id_t op)
+{
+    return (op < OP_STATS_COUNT) ? op_stats_names[op] : "?";
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,96 @@
+/******************************************************************************
+* File Name: op_stats.h
+*
+* Description: Per-operation timing statistics. An operation is bracketed by
+* op_stats_begin() and op_stats_end(), which time it with the cycle counter
+* (DWT CYCCNT on target, CLOCK_MONOTONIC on the host build), keep the count,
+* minimum, maximum and total for each operation and add both ends to the
+* trace ring. op_stats_record() adds a cycle count timed by the caller.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_OP_STATS_H_
+#define SOURCE_OP_STATS_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+/* Timed operations. The order is also the order of the OP_STATS frame
+ * response, so new operations go at the end. */
+typedef enum
+{
+    OP_STATS_AES_CTR,
+    OP_STATS_AES_CFB,
+    OP_STATS_AES_CCM,
+    OP_STATS_AES_GCM,
+    OP_STATS_AES_CMAC,
+    OP_STATS_SHA256,
+    OP_STATS_HMAC_SHA256,
+    OP_STATS_TRNG,
+    OP_STATS_DRBG,
+    OP_STATS_UART_PRINT,
+    OP_STATS_BLE_SC,
+    OP_STATS_COUNT
+} op_stats_id_t;
+
+typedef struct
+{
+    uint32_t count;
+    /* Cycles of the fastest and slowest call; min is 0 while count is 0 */
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    /* Cycles of all calls, for the mean */
+    uint64_t total_cycles;
+} op_stats_entry_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void op_stats_reset(void);
+void op_stats_record(op_stats_id_t op, uint32_t cycles);
+uint32_t op_stats_begin(op_stats_id_t op);
+void op_stats_end(op_stats_id_t op, uint32_t start);
+void op_stats_get(op_stats_id_t op, op_stats_entry_t *entry);
+char const *op_stats_name(op_stats_id_t op);
+
+#endif /* SOURCE_OP_STATS_H_ */
+
+/* [] END OF FILE */
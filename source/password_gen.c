@@ -0,0 +1,233 @@
+/******************************************************************************
+* File Name: password_gen.c
+*
+* Description: Uniform password generator, see password_gen.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "password_gen.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: gen_bit
+********************************************************************************
+* Summary: Takes one random bit, fetching a new buffer from the source when
+*          the current one is used up.
+*
+*******************************************************************************/
+static cy_en_cryptolite_status_t gen_bit(password_gen_t *gen, uint32_t *bit)
+{
+    cy_en_cryptolite_status_t res;
+
+    if (gen->bit_count == 0u)
+    {
+        if (gen->buf_pos == PASSWORD_GEN_BUFFER_SIZE)
+        {
+            res = gen->source(gen->buf, PASSWORD_GEN_BUFFER_SIZE);
+            if (res != CY_CRYPTOLITE_SUCCESS)
+            {
+                return res;
+            }
+            gen->buf_pos = 0u;
+            gen->bytes_used += PASSWORD_GEN_BUFFER_SIZE;
+        }
+        gen->bits = gen->buf[gen->buf_pos];
+        gen->buf[gen->buf_pos++] = 0u;
+        gen->bit_count = 8u;
+    }
+
+    *bit = gen->bits & 1u;
+    gen->bits >>= 1;
+    gen->bit_count--;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: password_gen_init
+********************************************************************************
+* Summary: Sets up a generator drawing random bytes from source.
+*
+* Parameters:
+*  password_gen_t* gen          - Generator to set up
+*  password_gen_source_t source - Source of uniformly random bytes, such as
+*                                 entropy_pool_read()
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void password_gen_init(password_gen_t *gen, password_gen_source_t source)
+{
+    if (gen != NULL)
+    {
+        memset(gen, 0, sizeof(*gen));
+        gen->source = source;
+        gen->buf_pos = PASSWORD_GEN_BUFFER_SIZE;
+    }
+}
+
+/*******************************************************************************
+* Function Name: password_gen_index
+********************************************************************************
+* Summary: Draws a uniformly distributed value below n, a random bit at a time
+*          (Lumbroso's Fast Dice Roller). c is uniform below v; once v reaches
+*          n, c is accepted if it is below n, and otherwise c - n, uniform
+*          below v - n, is kept for the next bits instead of being thrown
+*          away. This uses fewer than log2(n) + 2 bits on average.
+*
+* Parameters:
+*  password_gen_t* gen - Generator
+*  uint32_t n          - Number of possible values, 1 to 256
+*  uint32_t* index     - Set to the value
+*
+* Return:
+*  cy_en_cryptolite_status_t - Status of the random source
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t password_gen_index(password_gen_t *gen,
+                                             uint32_t n, uint32_t *index)
+{
+    cy_en_cryptolite_status_t res;
+    uint32_t v = 1u;
+    uint32_t c = 0u;
+    uint32_t bit;
+
+    if ((gen == NULL) || (gen->source == NULL) || (index == NULL) ||
+        (n == 0u) || (n > 256u))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    while (n > 1u)
+    {
+        res = gen_bit(gen, &bit);
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            return res;
+        }
+        v <<= 1;
+        c = (c << 1) | bit;
+        if (v >= n)
+        {
+            if (c < n)
+            {
+                break;
+            }
+            v -= n;
+            c -= n;
+            gen->rejected++;
+        }
+    }
+
+    gen->draws++;
+    *index = c;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: password_gen_generate
+********************************************************************************
+* Summary: Writes a password of len characters chosen uniformly and
+*          independently from alphabet, followed by a terminating NUL.
+*
+* Parameters:
+*  password_gen_t* gen  - Generator
+*  char const* alphabet - Characters to choose from; repeated characters are
+*                         correspondingly more likely
+*  size_t alphabet_len  - Number of characters, 1 to 256
+*  char* password       - Output, len + 1 bytes
+*  size_t len           - Password length
+*
+* Return:
+*  cy_en_cryptolite_status_t - Status of the random source. On failure the
+*                              password is wiped.
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t password_gen_generate(password_gen_t *gen,
+                                                char const *alphabet,
+                                                size_t alphabet_len,
+                                                char *password, size_t len)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+    uint32_t index;
+
+    if ((alphabet == NULL) || (password == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    for (size_t i = 0u; (i < len) && (res == CY_CRYPTOLITE_SUCCESS); i++)
+    {
+        res = password_gen_index(gen, (uint32_t)alphabet_len, &index);
+        if (res == CY_CRYPTOLITE_SUCCESS)
+        {
+            password[i] = alphabet[index];
+        }
+    }
+
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        memset(password, 0, len);
+    }
+    password[len] = '\0';
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: password_gen_clear
+********************************************************************************
+* Summary: Wipes the buffered random bits.
+*
+* Parameters:
+*  password_gen_t* gen - Generator
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void password_gen_clear(password_gen_t *gen)
+{
+    password_gen_source_t source;
+
+    if (gen != NULL)
+    {
+        source = gen->source;
+        password_gen_init(gen, source);
+    }
+}
@@ -0,0 +1,100 @@
+/******************************************************************************
+* File Name: password_gen.h
+*
+* Description: Uniform password generator. Characters are drawn from a
+* configurable alphabet by rejection sampling that keeps the unused part of a
+* rejected draw, so every character is equally likely and little more than
+* log2(alphabet size) random bits are spent on each.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_PASSWORD_GEN_H_
+#define SOURCE_PASSWORD_GEN_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The 94 visible ASCII characters, 0x21 to 0x7E */
+#define PASSWORD_GEN_ALPHABET_PRINTABLE \
+    "!\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`" \
+    "abcdefghijklmnopqrstuvwxyz{|}~"
+#define PASSWORD_GEN_ALPHABET_ALNUM \
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"
+
+/* Random bytes fetched from the source at a time */
+#define PASSWORD_GEN_BUFFER_SIZE             (16u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+/* Fills buf with len uniformly random bytes */
+typedef cy_en_cryptolite_status_t (*password_gen_source_t)(uint8_t *buf,
+                                                           size_t len);
+
+typedef struct
+{
+    password_gen_source_t source;
+    uint8_t               buf[PASSWORD_GEN_BUFFER_SIZE];
+    /* Next unused byte of buf */
+    uint32_t              buf_pos;
+    /* Unused random bits of the current byte, least significant first */
+    uint32_t              bits;
+    uint32_t              bit_count;
+    /* Random bytes taken from the source, values drawn and rejections */
+    uint32_t              bytes_used;
+    uint32_t              draws;
+    uint32_t              rejected;
+} password_gen_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void password_gen_init(password_gen_t *gen, password_gen_source_t source);
+cy_en_cryptolite_status_t password_gen_index(password_gen_t *gen,
+                                             uint32_t n, uint32_t *index);
+cy_en_cryptolite_status_t password_gen_generate(password_gen_t *gen,
+                                                char const *alphabet,
+                                                size_t alphabet_len,
+                                                char *password, size_t len);
+void password_gen_clear(password_gen_t *gen);
+
+#endif /* SOURCE_PASSWORD_GEN_H_ */
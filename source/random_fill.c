@@ -0,0 +1,130 @@
+/******************************************************************************
+* File Name: random_fill.c
+*
+* Description: Bulk random bytes, see random_fill.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "random_fill.h"
+#include "entropy_pool.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define RANDOM_FILL_WORD_SIZE                (4u)
+
+/*******************************************************************************
+* Function Name: random_fill
+********************************************************************************
+* Summary: Fills buf with len random bytes. The entropy pool is drained first
+*          without waiting; the remainder costs one TRNG word per started
+*          4 bytes. Whole words are written straight into the aligned middle
+*          of buf, and the bytes a misaligned start leaves over in its word
+*          are kept for the partial last word.
+*
+* Parameters:
+*  void* buf  - Destination, any alignment
+*  size_t len - Number of bytes
+*
+* Return:
+*  cy_en_cryptolite_status_t - CY_CRYPTOLITE_TRNG_UNHEALTHY if the TRNG has
+*                              failed its health tests; buf is then wiped
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t random_fill(void *buf, size_t len)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+    uint8_t *dst = (uint8_t *)buf;
+    size_t total = len;
+    size_t done;
+    size_t head;
+    uint8_t spare[RANDOM_FILL_WORD_SIZE];
+    size_t spare_len = 0u;
+    uint32_t word;
+
+    if ((buf == NULL) && (len != 0u))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    done = entropy_pool_get_random(dst, len);
+    dst += done;
+    len -= done;
+
+    head = (RANDOM_FILL_WORD_SIZE - ((uintptr_t)dst % RANDOM_FILL_WORD_SIZE)) %
+           RANDOM_FILL_WORD_SIZE;
+    if ((head != 0u) && (len != 0u))
+    {
+        head = (len < head) ? len : head;
+        res = entropy_pool_word(&word);
+        memcpy(spare, &word, sizeof(spare));
+        memcpy(dst, spare, head);
+        spare_len = RANDOM_FILL_WORD_SIZE - head;
+        dst += head;
+        len -= head;
+    }
+
+    /* dst is now word aligned: TRNG words go straight into it */
+    while ((res == CY_CRYPTOLITE_SUCCESS) && (len >= RANDOM_FILL_WORD_SIZE))
+    {
+        res = entropy_pool_word((uint32_t *)(void *)dst);
+        dst += RANDOM_FILL_WORD_SIZE;
+        len -= RANDOM_FILL_WORD_SIZE;
+    }
+
+    if ((res == CY_CRYPTOLITE_SUCCESS) && (len != 0u))
+    {
+        if (len > spare_len)
+        {
+            res = entropy_pool_word(&word);
+            memcpy(spare, &word, sizeof(spare));
+            spare_len = RANDOM_FILL_WORD_SIZE;
+        }
+        memcpy(dst, &spare[RANDOM_FILL_WORD_SIZE - spare_len], len);
+    }
+
+    memset(&word, 0, sizeof(word));
+    memset(spare, 0, sizeof(spare));
+    if (res != CY_CRYPTOLITE_SUCCESS)
+    {
+        memset(buf, 0, total);
+    }
+    return res;
+}
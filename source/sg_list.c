@@ -0,0 +1,142 @@
+/******************************************************************************
+* File Name: sg_list.c
+*
+* Description: Scatter/gather buffer descriptors, see sg_list.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "sg_list.h"
+
+/*******************************************************************************
+* Function Name: sg_list_length
+********************************************************************************
+* Summary: Returns the total number of bytes described by a list.
+*
+* Parameters:
+*  sg_list_t const* list - Segment list
+*
+* Return:
+*  size_t - Sum of all segment lengths
+*
+*******************************************************************************/
+size_t sg_list_length(sg_list_t const *list)
+{
+    size_t total = 0u;
+
+    for (size_t i = 0u; i < list->count; i++)
+    {
+        total += list->entries[i].len;
+    }
+    return total;
+}
+
+/*******************************************************************************
+* Function Name: sg_cursor_init
+********************************************************************************
+* Summary: Places a cursor at the first byte of a list.
+*
+* Parameters:
+*  sg_cursor_t* cursor   - Cursor to initialize
+*  sg_list_t const* list - Segment list to walk
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sg_cursor_init(sg_cursor_t *cursor, sg_list_t const *list)
+{
+    cursor->list = list;
+    cursor->index = 0u;
+    cursor->offset = 0u;
+}
+
+/*******************************************************************************
+* Function Name: sg_cursor_run
+********************************************************************************
+* Summary: Returns the contiguous bytes available at the cursor, skipping
+*          empty segments. The cursor itself does not move.
+*
+* Parameters:
+*  sg_cursor_t* cursor - Cursor
+*  uint8_t** data      - Receives the address of the run
+*
+* Return:
+*  size_t - Length of the run, 0 at the end of the list
+*
+*******************************************************************************/
+size_t sg_cursor_run(sg_cursor_t *cursor, uint8_t **data)
+{
+    sg_list_t const *list = cursor->list;
+
+    while ((cursor->index < list->count) &&
+           (cursor->offset == list->entries[cursor->index].len))
+    {
+        cursor->index++;
+        cursor->offset = 0u;
+    }
+    if (cursor->index == list->count)
+    {
+        *data = NULL;
+        return 0u;
+    }
+
+    *data = &list->entries[cursor->index].data[cursor->offset];
+    return list->entries[cursor->index].len - cursor->offset;
+}
+
+/*******************************************************************************
+* Function Name: sg_cursor_advance
+********************************************************************************
+* Summary: Moves the cursor forward by len bytes, which must not exceed the
+*          run last returned by sg_cursor_run().
+*
+* Parameters:
+*  sg_cursor_t* cursor - Cursor
+*  size_t len          - Number of bytes consumed
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sg_cursor_advance(sg_cursor_t *cursor, size_t len)
+{
+    cursor->offset += len;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,88 @@
+/******************************************************************************
+* File Name: sg_list.h
+*
+* Description: Scatter/gather buffer descriptors. A list describes one logical
+* byte stream made of several memory segments, so messages larger than any
+* single buffer, or split across a ring buffer wrap, can be passed to the
+* streaming cipher contexts without being copied together first.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SG_LIST_H_
+#define SOURCE_SG_LIST_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+/* One contiguous segment */
+typedef struct
+{
+    uint8_t *data;
+    size_t   len;
+} sg_entry_t;
+
+/* Ordered segments forming one byte stream */
+typedef struct
+{
+    sg_entry_t const *entries;
+    size_t            count;
+} sg_list_t;
+
+/* Read position within a list */
+typedef struct
+{
+    sg_list_t const *list;
+    size_t           index;
+    size_t           offset;
+} sg_cursor_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+size_t sg_list_length(sg_list_t const *list);
+void sg_cursor_init(sg_cursor_t *cursor, sg_list_t const *list);
+size_t sg_cursor_run(sg_cursor_t *cursor, uint8_t **data);
+void sg_cursor_advance(sg_cursor_t *cursor, size_t len);
+
+#endif /* SOURCE_SG_LIST_H_ */
+
+/* [] END OF FILE */
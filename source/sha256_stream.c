@@ -0,0 +1,248 @@
+/******************************************************************************
+* File Name: sha256_stream.c
+*
+* Description: Incremental SHA-256, see sha256_stream.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "sha256_stream.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: sha256_stream_start
+********************************************************************************
+* Summary: Starts a new digest. A stream still active from an earlier start
+*          is discarded.
+*
+* Parameters:
+*  sha256_stream_t* stream - Stream to start
+*
+* Return:
+*  cy_en_cryptolite_status_t
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t sha256_stream_start(sha256_stream_t *stream)
+{
+    cy_en_cryptolite_status_t res;
+
+    if (stream == NULL)
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    sha256_stream_abort(stream);
+    res = Cy_Cryptolite_Sha256_Init(CRYPTOLITE, &stream->ctx);
+    if (res == CY_CRYPTOLITE_SUCCESS)
+    {
+        res = Cy_Cryptolite_Sha256_Start(CRYPTOLITE, &stream->ctx);
+        if (res != CY_CRYPTOLITE_SUCCESS)
+        {
+            (void)Cy_Cryptolite_Sha256_Free(CRYPTOLITE, &stream->ctx);
+        }
+    }
+    stream->length = 0u;
+    stream->active = (res == CY_CRYPTOLITE_SUCCESS);
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: sha256_stream_update
+********************************************************************************
+* Summary: Absorbs the next len bytes of the message.
+*
+* Parameters:
+*  sha256_stream_t* stream - Started stream
+*  uint8_t const* data     - Message bytes
+*  size_t len              - Number of bytes
+*
+* Return:
+*  cy_en_cryptolite_status_t - CY_CRYPTOLITE_NOT_INITIALIZED if the stream
+*                              was not started
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t sha256_stream_update(sha256_stream_t *stream,
+                                               uint8_t const *data,
+                                               size_t len)
+{
+    cy_en_cryptolite_status_t res = CY_CRYPTOLITE_SUCCESS;
+
+    if ((stream == NULL) || ((len != 0u) && (data == NULL)))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!stream->active)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    while ((len != 0u) && (res == CY_CRYPTOLITE_SUCCESS))
+    {
+        uint32_t chunk = (len > SHA256_STREAM_MAX_CHUNK) ?
+                         SHA256_STREAM_MAX_CHUNK : (uint32_t)len;
+
+        res = Cy_Cryptolite_Sha256_Update(CRYPTOLITE, data, chunk,
+                                          &stream->ctx);
+        stream->length += chunk;
+        data += chunk;
+        len -= chunk;
+    }
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: sha256_stream_finish
+********************************************************************************
+* Summary: Pads the message, writes the digest and releases the stream.
+*
+* Parameters:
+*  sha256_stream_t* stream - Started stream
+*  uint8_t* digest         - Receives SHA256_STREAM_DIGEST_SIZE bytes
+*
+* Return:
+*  cy_en_cryptolite_status_t - CY_CRYPTOLITE_NOT_INITIALIZED if the stream
+*                              was not started
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t sha256_stream_finish(sha256_stream_t *stream,
+                                               uint8_t *digest)
+{
+    cy_en_cryptolite_status_t res;
+
+    if ((stream == NULL) || (digest == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!stream->active)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    res = Cy_Cryptolite_Sha256_Finish(CRYPTOLITE, digest, &stream->ctx);
+    sha256_stream_abort(stream);
+    return res;
+}
+
+/*******************************************************************************
+* Function Name: sha256_stream_abort
+********************************************************************************
+* Summary: Releases a stream without producing a digest and wipes the
+*          intermediate state. Does nothing if the stream is not active.
+*
+* Parameters:
+*  sha256_stream_t* stream - Stream to release
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sha256_stream_abort(sha256_stream_t *stream)
+{
+    if ((stream != NULL) && stream->active)
+    {
+        (void)Cy_Cryptolite_Sha256_Free(CRYPTOLITE, &stream->ctx);
+        memset(&stream->ctx, 0, sizeof(stream->ctx));
+        stream->active = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: sha256_stream_save
+********************************************************************************
+* Summary: Records the intermediate state of an active stream, for example
+*          after absorbing a fixed prefix, so that later digests over the
+*          same prefix can resume from it.
+*
+* Parameters:
+*  sha256_stream_t const* stream      - Active stream
+*  sha256_stream_snapshot_t* snapshot - Receives the state
+*
+* Return:
+*  cy_en_cryptolite_status_t - CY_CRYPTOLITE_NOT_INITIALIZED if the stream
+*                              is not active
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t sha256_stream_save(sha256_stream_t const *stream,
+                                             sha256_stream_snapshot_t *snapshot)
+{
+    if ((stream == NULL) || (snapshot == NULL))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+    if (!stream->active)
+    {
+        return CY_CRYPTOLITE_NOT_INITIALIZED;
+    }
+
+    snapshot->owner = stream;
+    memcpy(snapshot->ctx, &stream->ctx, sizeof(snapshot->ctx));
+    snapshot->length = stream->length;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: sha256_stream_restore
+********************************************************************************
+* Summary: Makes the stream continue from a saved state, discarding what it
+*          absorbed since. The context is copied back to the address it was
+*          saved from, which keeps any pointers the PDL holds into it valid.
+*
+* Parameters:
+*  sha256_stream_t* stream                  - Stream the snapshot was saved from
+*  sha256_stream_snapshot_t const* snapshot - Saved state
+*
+* Return:
+*  cy_en_cryptolite_status_t - CY_CRYPTOLITE_BAD_PARAMS if the snapshot
+*                              belongs to another stream
+*
+*******************************************************************************/
+cy_en_cryptolite_status_t sha256_stream_restore(sha256_stream_t *stream,
+                                        sha256_stream_snapshot_t const *snapshot)
+{
+    if ((stream == NULL) || (snapshot == NULL) || (snapshot->owner != stream))
+    {
+        return CY_CRYPTOLITE_BAD_PARAMS;
+    }
+
+    memcpy(&stream->ctx, snapshot->ctx, sizeof(snapshot->ctx));
+    stream->length = snapshot->length;
+    stream->active = true;
+    return CY_CRYPTOLITE_SUCCESS;
+}
+
+/* [] END OF FILE */
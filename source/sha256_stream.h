@@ -0,0 +1,103 @@
+/******************************************************************************
+* File Name: sha256_stream.h
+*
+* Description: Incremental SHA-256 on top of the Cryptolite block. A stream is
+* started once, absorbs data of any length in as many calls as needed and
+* produces the digest when finished, so input can be hashed as it arrives in
+* constant RAM.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SHA256_STREAM_H_
+#define SOURCE_SHA256_STREAM_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SHA256_STREAM_DIGEST_SIZE            (32u)
+#define SHA256_STREAM_BLOCK_SIZE             (CY_CRYPTOLITE_SHA256_BLOCK_SIZE)
+
+/* Largest run handed to a single PDL call, whose length is 32-bit */
+#define SHA256_STREAM_MAX_CHUNK              (0xFFFFFFC0u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+/* The PDL context may hold pointers into itself, so a stream must not be
+ * moved or copied while active. Zero-initialize a stream before its first
+ * sha256_stream_start(). */
+typedef struct
+{
+    cy_stc_cryptolite_context_sha256_t ctx;
+    /* Number of bytes absorbed since sha256_stream_start() */
+    uint64_t                           length;
+    bool                               active;
+} sha256_stream_t;
+
+/* Saved intermediate state of a stream. It can only be restored into the
+ * stream it was saved from, because the context is copied byte for byte. */
+typedef struct
+{
+    sha256_stream_t const *owner;
+    uint8_t                ctx[sizeof(cy_stc_cryptolite_context_sha256_t)];
+    uint64_t               length;
+} sha256_stream_snapshot_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_cryptolite_status_t sha256_stream_start(sha256_stream_t *stream);
+cy_en_cryptolite_status_t sha256_stream_update(sha256_stream_t *stream,
+                                               uint8_t const *data,
+                                               size_t len);
+cy_en_cryptolite_status_t sha256_stream_finish(sha256_stream_t *stream,
+                                               uint8_t *digest);
+void sha256_stream_abort(sha256_stream_t *stream);
+cy_en_cryptolite_status_t sha256_stream_save(sha256_stream_t const *stream,
+                                             sha256_stream_snapshot_t *snapshot);
+cy_en_cryptolite_status_t sha256_stream_restore(sha256_stream_t *stream,
+                                        sha256_stream_snapshot_t const *snapshot);
+
+#endif /* SOURCE_SHA256_STREAM_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,138 @@
+/******************************************************************************
+* File Name: trace_ring.c
+*
+* Description: Binary event trace ring, see trace_ring.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "trace_ring.h"
+#include "cycle_count.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static trace_event_t trace_events[TRACE_RING_SIZE];
+
+/* Sequence number of the next event; event n is at n % TRACE_RING_SIZE */
+static uint32_t trace_head;
+
+/*******************************************************************************
+* Function Name: trace_ring_record
+********************************************************************************
+* Summary: Appends an event, overwriting the oldest one if the ring is full.
+*          Called from the main loop only: there is no locking.
+*
+* Parameters:
+*  trace_event_type_t type - Event type
+*  uint8_t id              - State, operation or command, depending on type
+*  uint16_t data           - Type-specific data
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trace_ring_record(trace_event_type_t type, uint8_t id, uint16_t data)
+{
+    trace_event_t *event = &trace_events[trace_head & (TRACE_RING_SIZE - 1u)];
+
+    event->timestamp = cycle_count_now();
+    event->info = (uint32_t)type | ((uint32_t)id << 8) | ((uint32_t)data << 16);
+    trace_head++;
+}
+
+/*******************************************************************************
+* Function Name: trace_ring_head
+********************************************************************************
+* Summary: Returns the sequence number the next event will get, which is also
+*          the number of events recorded so far (modulo 2^32).
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - Next sequence number
+*
+*******************************************************************************/
+uint32_t trace_ring_head(void)
+{
+    return trace_head;
+}
+
+/*******************************************************************************
+* Function Name: trace_ring_read
+********************************************************************************
+* Summary: Copies up to max events starting at sequence number first. If the
+*          ring no longer holds that event, the copy starts at the oldest one
+*          it does hold.
+*
+* Parameters:
+*  uint32_t first          - Sequence number of the first event wanted
+*  trace_event_t* events   - Receives the events
+*  uint32_t max            - Capacity of events
+*  uint32_t* first_read    - Set to the sequence number of events[0]
+*
+* Return:
+*  uint32_t - Number of events copied
+*
+*******************************************************************************/
+uint32_t trace_ring_read(uint32_t first, trace_event_t *events, uint32_t max,
+                         uint32_t *first_read)
+{
+    uint32_t held = (trace_head < TRACE_RING_SIZE) ? trace_head
+                                                   : TRACE_RING_SIZE;
+    uint32_t oldest = trace_head - held;
+    uint32_t count;
+
+    /* Unsigned distances keep this right across sequence number wrap */
+    if ((first - oldest) > held)
+    {
+        first = oldest;
+    }
+    count = trace_head - first;
+    count = (count < max) ? count : max;
+
+    for (uint32_t i = 0u; i < count; i++)
+    {
+        events[i] = trace_events[(first + i) & (TRACE_RING_SIZE - 1u)];
+    }
+    *first_read = first;
+    return count;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,102 @@
+/******************************************************************************
+* File Name: trace_ring.h
+*
+* Description: Fixed-size binary trace of timestamped events: state machine
+* transitions, the start and end of timed operations and of frame commands.
+* Recording an event costs a cycle counter read and two stores; the oldest
+* events are overwritten once the ring is full. Read out with the TRACE_DUMP
+* frame command and decoded by tools/trace_decode.py.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_TRACE_RING_H_
+#define SOURCE_TRACE_RING_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Events kept. Must be a power of two. */
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE                      (256u)
+#endif
+
+#if ((TRACE_RING_SIZE & (TRACE_RING_SIZE - 1u)) != 0u)
+#error "TRACE_RING_SIZE must be a power of two"
+#endif
+
+/* Size of an event as sent by TRACE_DUMP */
+#define TRACE_EVENT_SIZE                     (8u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef enum
+{
+    /* Entered message_status_t id; data is the menu mode */
+    TRACE_EVENT_STATE       = 1u,
+    /* op_stats_id_t id started or ended */
+    TRACE_EVENT_OP_BEGIN    = 2u,
+    TRACE_EVENT_OP_END      = 3u,
+    /* Frame command id started, data is the request length; or ended, data
+     * is the frame_status_t */
+    TRACE_EVENT_FRAME_BEGIN = 4u,
+    TRACE_EVENT_FRAME_END   = 5u
+} trace_event_type_t;
+
+typedef struct
+{
+    /* Cycle counter when the event was recorded */
+    uint32_t timestamp;
+    /* trace_event_type_t in bits 0-7, id in bits 8-15, data in bits 16-31 */
+    uint32_t info;
+} trace_event_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void trace_ring_record(trace_event_type_t type, uint8_t id, uint16_t data);
+uint32_t trace_ring_head(void);
+uint32_t trace_ring_read(uint32_t first, trace_event_t *events, uint32_t max,
+                         uint32_t *first_read);
+
+#endif /* SOURCE_TRACE_RING_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,162 @@
+/******************************************************************************
+* File Name: trng_health.c
+*
+* Description: SP 800-90B continuous health tests, see trng_health.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "trng_health.h"
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: health_sample
+********************************************************************************
+* Summary: Runs both tests on one 8-bit sample.
+*
+*******************************************************************************/
+static trng_health_status_t health_sample(trng_health_t *health,
+                                          uint8_t sample)
+{
+    trng_health_status_t status = TRNG_HEALTH_OK;
+
+    /* Repetition count test. The count starts at zero, so the first sample
+     * always begins a run of one. */
+    if (sample == health->rct_value)
+    {
+        health->rct_count++;
+    }
+    else
+    {
+        health->rct_value = sample;
+        health->rct_count = 1u;
+    }
+    if (health->rct_count > health->max_rct_count)
+    {
+        health->max_rct_count = health->rct_count;
+    }
+    if (health->rct_count >= TRNG_HEALTH_RCT_CUTOFF)
+    {
+        status = TRNG_HEALTH_RCT_FAILURE;
+    }
+
+    /* Adaptive proportion test: count the first sample of each window in
+     * the rest of the window */
+    if (health->apt_samples == 0u)
+    {
+        health->apt_value = sample;
+        health->apt_count = 1u;
+    }
+    else if (sample == health->apt_value)
+    {
+        health->apt_count++;
+        if (health->apt_count > health->max_apt_count)
+        {
+            health->max_apt_count = health->apt_count;
+        }
+        if ((health->apt_count >= TRNG_HEALTH_APT_CUTOFF) &&
+            (status == TRNG_HEALTH_OK))
+        {
+            status = TRNG_HEALTH_APT_FAILURE;
+        }
+    }
+    if (++health->apt_samples == TRNG_HEALTH_APT_WINDOW)
+    {
+        health->apt_samples = 0u;
+    }
+
+    health->samples++;
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: trng_health_init
+********************************************************************************
+* Summary: Resets the monitor, clearing any latched failure.
+*
+* Parameters:
+*  trng_health_t* health - Monitor to reset
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trng_health_init(trng_health_t *health)
+{
+    if (health != NULL)
+    {
+        memset(health, 0, sizeof(*health));
+    }
+}
+
+/*******************************************************************************
+* Function Name: trng_health_check
+********************************************************************************
+* Summary: Feeds the four bytes of a TRNG word, least significant first, to
+*          the tests. Once a test has failed, the failure is returned for
+*          every later word without looking at it, so that a caller cannot
+*          miss it.
+*
+* Parameters:
+*  trng_health_t* health - Monitor
+*  uint32_t word         - TRNG output word
+*
+* Return:
+*  trng_health_status_t - TRNG_HEALTH_OK if the word may be used
+*
+*******************************************************************************/
+trng_health_status_t trng_health_check(trng_health_t *health, uint32_t word)
+{
+    trng_health_status_t status;
+
+    if (health->status != TRNG_HEALTH_OK)
+    {
+        return health->status;
+    }
+
+    for (uint32_t i = 0u; i < 4u; i++)
+    {
+        status = health_sample(health, (uint8_t)(word >> (8u * i)));
+        if ((status != TRNG_HEALTH_OK) && (health->status == TRNG_HEALTH_OK))
+        {
+            health->status = status;
+        }
+    }
+    return health->status;
+}
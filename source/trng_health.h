@@ -0,0 +1,102 @@
+/******************************************************************************
+* File Name: trng_health.h
+*
+* Description: Continuous health tests of NIST SP 800-90B section 4.4 on TRNG
+* output: the repetition count test and the adaptive proportion test, run
+* incrementally on each 32-bit word at a fixed cost of four 8-bit samples. A
+* failure is latched until the monitor is reinitialized.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_TRNG_HEALTH_H_
+#define SOURCE_TRNG_HEALTH_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Cutoffs for 8-bit samples with an assumed min-entropy of 4 bits per sample
+ * and a false positive probability of 2^-20 per sample:
+ * RCT: 1 + ceil(20 / 4); APT: 1 + CRITBINOM(512, 2^-4, 1 - 2^-20). Sources
+ * with less entropy per byte need larger cutoffs. */
+#ifndef TRNG_HEALTH_RCT_CUTOFF
+#define TRNG_HEALTH_RCT_CUTOFF               (6u)
+#endif
+#ifndef TRNG_HEALTH_APT_CUTOFF
+#define TRNG_HEALTH_APT_CUTOFF               (62u)
+#endif
+#define TRNG_HEALTH_APT_WINDOW               (512u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef enum
+{
+    TRNG_HEALTH_OK          = 0u,
+    /* TRNG_HEALTH_RCT_CUTOFF identical samples in a row */
+    TRNG_HEALTH_RCT_FAILURE = 1u,
+    /* TRNG_HEALTH_APT_CUTOFF copies of one sample in a window */
+    TRNG_HEALTH_APT_FAILURE = 2u,
+} trng_health_status_t;
+
+typedef struct
+{
+    /* First failure seen, if any */
+    trng_health_status_t status;
+    uint8_t              rct_value;
+    uint8_t              apt_value;
+    uint16_t             rct_count;
+    uint16_t             apt_count;
+    /* Samples seen in the current APT window */
+    uint16_t             apt_samples;
+    uint32_t             samples;
+    /* Longest run and highest window count seen, to show the margin left
+     * below the cutoffs */
+    uint16_t             max_rct_count;
+    uint16_t             max_apt_count;
+} trng_health_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void trng_health_init(trng_health_t *health);
+trng_health_status_t trng_health_check(trng_health_t *health, uint32_t word);
+
+#endif /* SOURCE_TRNG_HEALTH_H_ */
@@ -0,0 +1,262 @@
+/******************************************************************************
+* File Name: uart_rx.c
+*
+* Description: Interrupt-driven receive path for the debug UART.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "uart_rx.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define UART_RX_INDEX_MASK                   (UART_RX_BUFFER_SIZE - 1u)
+
+#if ((UART_RX_BUFFER_SIZE & UART_RX_INDEX_MASK) != 0u)
+#error "UART_RX_BUFFER_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint8_t rx_buffer[UART_RX_BUFFER_SIZE];
+
+/* Free-running indices. head is only written by the interrupt handler and
+ * tail only by the main loop, so no locking is needed. */
+static volatile uint32_t rx_head;
+static volatile uint32_t rx_tail;
+
+static volatile uint32_t rx_dropped;
+
+/*******************************************************************************
+* Function Name: uart_rx_event_handler
+********************************************************************************
+* Summary: RX part of the UART interrupt handler. Empties the hardware FIFO
+*          into the ring buffer; characters that do not fit are counted as
+*          dropped. Registered by uart_rx_init(); a module that replaces the
+*          UART callback must forward events to this function.
+*
+* Parameters:
+*  void* callback_arg       - UART object
+*  cyhal_uart_event_t event - Events that triggered the interrupt
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_rx_event_handler(void *callback_arg, cyhal_uart_event_t event)
+{
+    cyhal_uart_t *uart = (cyhal_uart_t *)callback_arg;
+    uint32_t head = rx_head;
+    uint8_t value;
+
+    if ((event & CYHAL_UART_IRQ_RX_NOT_EMPTY) == 0u)
+    {
+        return;
+    }
+
+    while (cyhal_uart_readable(uart) > 0u)
+    {
+        if (cyhal_uart_getc(uart, &value, 0u) != CY_RSLT_SUCCESS)
+        {
+            break;
+        }
+        if ((head - rx_tail) < UART_RX_BUFFER_SIZE)
+        {
+            rx_buffer[head & UART_RX_INDEX_MASK] = value;
+            head++;
+        }
+        else
+        {
+            rx_dropped++;
+        }
+    }
+
+    /* Publish the new characters only after they are stored */
+    __DMB();
+    rx_head = head;
+}
+
+/*******************************************************************************
+* Function Name: uart_rx_init
+********************************************************************************
+* Summary: Empties the ring buffer and enables the UART RX interrupt.
+*
+* Parameters:
+*  cyhal_uart_t* uart - Initialized UART object
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_rx_init(cyhal_uart_t *uart)
+{
+    rx_head = 0u;
+    rx_tail = 0u;
+    rx_dropped = 0u;
+
+    cyhal_uart_register_callback(uart, uart_rx_event_handler, uart);
+    cyhal_uart_enable_event(uart, CYHAL_UART_IRQ_RX_NOT_EMPTY,
+                            UART_RX_INTR_PRIORITY, true);
+}
+
+/*******************************************************************************
+* Function Name: uart_rx_peek
+********************************************************************************
+* Summary: Returns the longest run of received characters that is contiguous
+*          in the ring buffer, without removing it. Call uart_rx_consume()
+*          with the number of characters actually used.
+*
+* Parameters:
+*  uint8_t const** data - Set to the first unread character
+*
+* Return:
+*  uint32_t - Number of characters available at *data
+*
+*******************************************************************************/
+uint32_t uart_rx_peek(uint8_t const **data)
+{
+    uint32_t tail = rx_tail;
+    uint32_t available = rx_head - tail;
+    uint32_t to_wrap = UART_RX_BUFFER_SIZE - (tail & UART_RX_INDEX_MASK);
+
+    *data = &rx_buffer[tail & UART_RX_INDEX_MASK];
+    return (available < to_wrap) ? available : to_wrap;
+}
+
+/*******************************************************************************
+* Function Name: uart_rx_consume
+********************************************************************************
+* Summary: Releases characters returned by uart_rx_peek().
+*
+* Parameters:
+*  uint32_t count - Number of characters to release
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_rx_consume(uint32_t count)
+{
+    /* Finish reading the characters before handing the space back */
+    __DMB();
+    rx_tail = rx_tail + count;
+}
+
+/*******************************************************************************
+* Function Name: uart_rx_read
+********************************************************************************
+* Summary: Copies up to size received characters into buf.
+*
+* Parameters:
+*  uint8_t* buf  - Destination buffer
+*  uint32_t size - Size of buf
+*
+* Return:
+*  uint32_t - Number of characters copied
+*
+*******************************************************************************/
+uint32_t uart_rx_read(uint8_t *buf, uint32_t size)
+{
+    uint8_t const *data;
+    uint32_t copied = 0u;
+    uint32_t count;
+
+    /* At most two runs: up to the end of the buffer and after the wrap */
+    while (copied < size)
+    {
+        count = uart_rx_peek(&data);
+        if (count == 0u)
+        {
+            break;
+        }
+        if (count > (size - copied))
+        {
+            count = size - copied;
+        }
+        memcpy(&buf[copied], data, count);
+        uart_rx_consume(count);
+        copied += count;
+    }
+    return copied;
+}
+
+/*******************************************************************************
+* Function Name: uart_rx_wait
+********************************************************************************
+* Summary: Sleeps until the next interrupt if the ring buffer is empty. The
+*          check is done with interrupts masked so that a character arriving
+*          between the check and the sleep still wakes the CPU.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_rx_wait(void)
+{
+    uint32_t saved_intr = cyhal_system_critical_section_enter();
+
+    if (rx_head == rx_tail)
+    {
+        __WFI();
+    }
+    cyhal_system_critical_section_exit(saved_intr);
+}
+
+/*******************************************************************************
+* Function Name: uart_rx_get_stats
+********************************************************************************
+* Summary: Reports how many characters were received and dropped.
+*
+* Parameters:
+*  uart_rx_stats_t* stats - Filled with the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_rx_get_stats(uart_rx_stats_t *stats)
+{
+    stats->received = rx_head;
+    stats->dropped = rx_dropped;
+}
@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name: uart_rx.h
+*
+* Description: Interrupt-driven receive path for the debug UART. The UART RX
+* interrupt moves received characters into a lock-free single-producer/single-
+* consumer ring buffer, which the application drains in bulk from the main
+* loop.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_UART_RX_H_
+#define SOURCE_UART_RX_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the receive ring buffer. Must be a power of two. */
+#define UART_RX_BUFFER_SIZE                  (256u)
+
+/* Priority of the UART RX interrupt */
+#define UART_RX_INTR_PRIORITY                (3u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef struct
+{
+    /* Characters stored in the ring buffer */
+    uint32_t received;
+    /* Characters lost because the ring buffer was full */
+    uint32_t dropped;
+} uart_rx_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void uart_rx_init(cyhal_uart_t *uart);
+void uart_rx_event_handler(void *callback_arg, cyhal_uart_event_t event);
+uint32_t uart_rx_peek(uint8_t const **data);
+void uart_rx_consume(uint32_t count);
+uint32_t uart_rx_read(uint8_t *buf, uint32_t size);
+void uart_rx_wait(void);
+void uart_rx_get_stats(uart_rx_stats_t *stats);
+
+#endif /* SOURCE_UART_RX_H_ */
@@ -0,0 +1,308 @@
+/******************************************************************************
+* File Name: uart_tx.c
+*
+* Description: Buffered, interrupt-driven transmit path for the debug UART.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "uart_tx.h"
+#include "uart_rx.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define UART_TX_INDEX_MASK                   (UART_TX_BUFFER_SIZE - 1u)
+
+#if ((UART_TX_BUFFER_SIZE & UART_TX_INDEX_MASK) != 0u)
+#error "UART_TX_BUFFER_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static cyhal_uart_t *tx_uart;
+static uint8_t tx_buffer[UART_TX_BUFFER_SIZE];
+
+/* Free-running indices. head is only written by the main loop; tail and the
+ * in-flight length are only changed with the UART interrupt masked or from
+ * the interrupt itself. */
+static volatile uint32_t tx_head;
+static volatile uint32_t tx_tail;
+static volatile uint32_t tx_in_flight;
+
+static uint32_t tx_stalls;
+static volatile uint32_t tx_transfers;
+
+/*******************************************************************************
+* Function Name: uart_tx_start
+********************************************************************************
+* Summary: Hands the next contiguous run of buffered bytes to the UART if no
+*          transfer is in progress. Must be called with the UART interrupt
+*          masked or from the interrupt handler.
+*
+*******************************************************************************/
+static void uart_tx_start(void)
+{
+    uint32_t tail = tx_tail;
+    uint32_t pending = tx_head - tail;
+    uint32_t to_wrap = UART_TX_BUFFER_SIZE - (tail & UART_TX_INDEX_MASK);
+    uint32_t len = (pending < to_wrap) ? pending : to_wrap;
+
+    if ((tx_in_flight != 0u) || (len == 0u))
+    {
+        return;
+    }
+
+    if (cyhal_uart_write_async(tx_uart, &tx_buffer[tail & UART_TX_INDEX_MASK],
+                               len) == CY_RSLT_SUCCESS)
+    {
+        tx_in_flight = len;
+        tx_transfers++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_event_handler
+********************************************************************************
+* Summary: UART interrupt handler. On TX done, releases the transmitted chunk
+*          and starts the next one. All events are also passed to the RX
+*          handler, which shares the UART callback.
+*
+* Parameters:
+*  void* callback_arg       - UART object
+*  cyhal_uart_event_t event - Events that triggered the interrupt
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_tx_event_handler(void *callback_arg, cyhal_uart_event_t event)
+{
+    if ((event & CYHAL_UART_IRQ_TX_DONE) != 0u)
+    {
+        tx_tail = tx_tail + tx_in_flight;
+        tx_in_flight = 0u;
+        uart_tx_start();
+    }
+
+    uart_rx_event_handler(callback_arg, event);
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_init
+********************************************************************************
+* Summary: Empties the ring buffer and enables the UART TX-done interrupt.
+*          Must be called after uart_rx_init(), whose callback it takes over.
+*
+* Parameters:
+*  cyhal_uart_t* uart - Initialized UART object
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_init(cyhal_uart_t *uart)
+{
+    tx_uart = uart;
+    tx_head = 0u;
+    tx_tail = 0u;
+    tx_in_flight = 0u;
+    tx_stalls = 0u;
+    tx_transfers = 0u;
+
+    cyhal_uart_register_callback(uart, uart_tx_event_handler, uart);
+    cyhal_uart_enable_event(uart, CYHAL_UART_IRQ_TX_DONE,
+                            UART_TX_INTR_PRIORITY, true);
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_flush
+********************************************************************************
+* Summary: Starts transmission of everything buffered so far and returns
+*          without waiting for it to complete.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_flush(void)
+{
+    uint32_t saved_intr = cyhal_system_critical_section_enter();
+
+    uart_tx_start();
+    cyhal_system_critical_section_exit(saved_intr);
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_wait
+********************************************************************************
+* Summary: Sleeps until the next interrupt while a transfer is in progress.
+*
+*******************************************************************************/
+static void uart_tx_wait(void)
+{
+    uint32_t saved_intr = cyhal_system_critical_section_enter();
+
+    if (tx_in_flight != 0u)
+    {
+        __WFI();
+    }
+    cyhal_system_critical_section_exit(saved_intr);
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_write
+********************************************************************************
+* Summary: Appends len bytes to the ring buffer. Transmission only starts at
+*          the next uart_tx_flush(), unless the buffer fills up, in which case
+*          the caller waits for the UART to make room.
+*
+* Parameters:
+*  void const* data - Bytes to send
+*  size_t len       - Number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_write(void const *data, size_t len)
+{
+    uint8_t const *src = (uint8_t const *)data;
+
+    while (len > 0u)
+    {
+        uint32_t head = tx_head;
+        uint32_t space = UART_TX_BUFFER_SIZE - (head - tx_tail);
+        uint32_t to_wrap = UART_TX_BUFFER_SIZE - (head & UART_TX_INDEX_MASK);
+        uint32_t chunk = (len < space) ? (uint32_t)len : space;
+
+        if (chunk == 0u)
+        {
+            tx_stalls++;
+            uart_tx_flush();
+            uart_tx_wait();
+            continue;
+        }
+
+        chunk = (chunk < to_wrap) ? chunk : to_wrap;
+        memcpy(&tx_buffer[head & UART_TX_INDEX_MASK], src, chunk);
+
+        /* Publish the bytes only after they are stored */
+        __DMB();
+        tx_head = head + chunk;
+        src += chunk;
+        len -= chunk;
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_putc / uart_tx_puts
+********************************************************************************
+* Summary: Appends a character or a NUL-terminated string.
+*
+*******************************************************************************/
+void uart_tx_putc(char c)
+{
+    uart_tx_write(&c, 1u);
+}
+
+void uart_tx_puts(char const *str)
+{
+    uart_tx_write(str, strlen(str));
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_printf
+********************************************************************************
+* Summary: printf() into the ring buffer. Output longer than
+*          UART_TX_PRINTF_BUFFER_SIZE - 1 characters is truncated; use
+*          uart_tx_write() for bulk data.
+*
+* Parameters:
+*  char const* format - printf() format string
+*  ...                - Arguments
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_printf(char const *format, ...)
+{
+    char text[UART_TX_PRINTF_BUFFER_SIZE];
+    va_list args;
+    int len;
+
+    va_start(args, format);
+    len = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    if (len > 0)
+    {
+        if ((uint32_t)len >= sizeof(text))
+        {
+            len = (int)sizeof(text) - 1;
+        }
+        uart_tx_write(text, (size_t)len);
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_get_stats
+********************************************************************************
+* Summary: Reports the transmit counters.
+*
+* Parameters:
+*  uart_tx_stats_t* stats - Filled with the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_get_stats(uart_tx_stats_t *stats)
+{
+    stats->written = tx_head;
+    stats->stalls = tx_stalls;
+    stats->transfers = tx_transfers;
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name: uart_tx.h
+*
+* Description: Buffered, interrupt-driven transmit path for the debug UART.
+* Output is collected in a ring buffer and handed to the UART in large chunks
+* with cyhal_uart_write_async(); the TX-done interrupt starts the next chunk,
+* so the CPU can continue with crypto work while earlier results are still
+* being sent.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_UART_TX_H_
+#define SOURCE_UART_TX_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the transmit ring buffer. Must be a power of two. */
+#define UART_TX_BUFFER_SIZE                  (1024u)
+
+/* Longest string uart_tx_printf() can produce in one call */
+#define UART_TX_PRINTF_BUFFER_SIZE           (160u)
+
+/* Priority of the UART TX interrupt */
+#define UART_TX_INTR_PRIORITY                (3u)
+
+/*******************************************************************************
+* Data type definitions
+*******************************************************************************/
+typedef struct
+{
+    /* Bytes accepted into the ring buffer */
+    uint32_t written;
+    /* Number of times a writer had to wait for space in the ring buffer */
+    uint32_t stalls;
+    /* Number of chunks handed to the UART */
+    uint32_t transfers;
+} uart_tx_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void uart_tx_init(cyhal_uart_t *uart);
+void uart_tx_write(void const *data, size_t len);
+void uart_tx_putc(char c);
+void uart_tx_puts(char const *str);
+void uart_tx_printf(char const *format, ...);
+void uart_tx_flush(void);
+void uart_tx_get_stats(uart_tx_stats_t *stats);
+
+#endif /* SOURCE_UART_TX_H_ */
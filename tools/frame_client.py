@@ -0,0 +1,615 @@
+#!/usr/bin/env python3
+################################################################################
+# \file frame_client.py
+# \version 1.0
+#
+# \brief
+# Host-side client for the binary frame protocol of the Cryptolite code
+# example (see source/frame_protocol.h). Talks to a board over a serial port
+# (requires pyserial) or to the host build started as a subprocess.
+#
+# Usage:
+#   frame_client.py --exec host/build/cryptolite sha256 "abc"
+#   frame_client.py --port /dev/ttyACM0 ctr 000102030405060708090a0b0c0d0e0f "Hello"
+#   frame_client.py --exec host/build/cryptolite bench --size 256 --count 2000
+#   frame_client.py --exec host/build/cryptolite batch --jobs 8 --size 27
+#   frame_client.py --exec host/build/cryptolite trngstats --requests 100
+#   frame_client.py --exec host/build/cryptolite rngbench --size 65536
+#   frame_client.py --exec host/build/cryptolite password --count 20000 --chi2
+#   frame_client.py --port /dev/ttyACM0 trace --out trace.bin
+#
+################################################################################
+# \copyright
+# Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+
+import argparse
+import math
+import struct
+import subprocess
+import sys
+import threading
+import time
+
+FRAME_SOF = 0xA5
+FRAME_RESPONSE = 0x80
+# Limit of the 16-bit length field; the device may be built with a smaller
+# FRAME_MAX_DATA and then answers larger requests with BAD_LENGTH.
+FRAME_MAX_PAYLOAD = 0xFFFF
+# FRAME_MAX_PAYLOAD of a device built with the default FRAME_MAX_DATA
+DEVICE_MAX_PAYLOAD = 16 + 256
+
+CMD_PING = 0x00
+CMD_AES_CTR = 0x01
+CMD_AES_CFB = 0x02
+CMD_SHA256 = 0x03
+CMD_TRNG = 0x04
+CMD_SET_KEY = 0x05
+CMD_SHA256_START = 0x06
+CMD_SHA256_UPDATE = 0x07
+CMD_SHA256_FINISH = 0x08
+CMD_HMAC_SET_KEY = 0x09
+CMD_HMAC_SHA256 = 0x0A
+CMD_AES_CCM = 0x0B
+CMD_AES_GCM = 0x0C
+CMD_AES_CMAC = 0x0D
+CMD_AES_BATCH = 0x0E
+CMD_EXIT = 0x0F
+CMD_TRNG_STATS = 0x10
+CMD_DRBG = 0x11
+CMD_RNG_BENCH = 0x12
+CMD_PASSWORD = 0x13
+CMD_OP_STATS = 0x14
+CMD_TRACE_DUMP = 0x15
+CMD_BLE_SC = 0x16
+
+FLAG_DECRYPT = 0x01
+
+STATUS_NAMES = {
+    0x00: "OK",
+    0x01: "BAD_CRC",
+    0x02: "BAD_COMMAND",
+    0x03: "BAD_LENGTH",
+    0x04: "CRYPTO_ERROR",
+    0x05: "AUTH_FAILED",
+}
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, as frame_crc16() on the device."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def encode_frame(cmd, seq, payload=b"", flags=0):
+    if len(payload) > FRAME_MAX_PAYLOAD:
+        raise ValueError("payload exceeds %d bytes" % FRAME_MAX_PAYLOAD)
+    body = struct.pack("<BBBH", cmd, flags, seq, len(payload)) + payload
+    return bytes([FRAME_SOF]) + body + struct.pack("<H", crc16(body))
+
+
+class SubprocessTransport:
+    """Runs the host build and exchanges frames over its stdin/stdout."""
+
+    def __init__(self, command):
+        self.proc = subprocess.Popen(command, stdin=subprocess.PIPE,
+                                     stdout=subprocess.PIPE, bufsize=0)
+
+    def write(self, data):
+        self.proc.stdin.write(data)
+
+    def read(self, size):
+        return self.proc.stdout.read(size)
+
+    def close(self):
+        self.proc.stdin.close()
+        self.proc.wait()
+
+
+class SerialTransport:
+    """Exchanges frames with a board over a serial port."""
+
+    def __init__(self, port, baudrate):
+        import serial  # pyserial; only needed for real hardware
+        self.port = serial.Serial(port, baudrate, timeout=5)
+
+    def write(self, data):
+        self.port.write(data)
+
+    def read(self, size):
+        return self.port.read(size)
+
+    def close(self):
+        self.port.close()
+
+
+class FrameClient:
+    def __init__(self, transport):
+        self.transport = transport
+        self.seq = 0
+
+    def _read_exact(self, size):
+        data = b""
+        while len(data) < size:
+            chunk = self.transport.read(size - len(data))
+            if not chunk:
+                raise EOFError("connection closed")
+            data += chunk
+        return data
+
+    def send(self, cmd, payload=b"", flags=0):
+        """Queues one request without waiting; returns its sequence number."""
+        seq = self.seq
+        self.seq = (self.seq + 1) & 0xFF
+        self.transport.write(encode_frame(cmd, seq, payload, flags))
+        return seq
+
+    def receive(self):
+        """Returns (cmd, status, seq, payload) of the next valid response.
+        Menu text printed before the first frame is skipped."""
+        while True:
+            if self._read_exact(1)[0] != FRAME_SOF:
+                continue
+            header = self._read_exact(5)
+            cmd, status, seq, length = struct.unpack("<BBBH", header)
+            if length > FRAME_MAX_PAYLOAD:
+                continue
+            payload = self._read_exact(length)
+            (crc,) = struct.unpack("<H", self._read_exact(2))
+            if crc != crc16(header + payload):
+                continue
+            return cmd & ~FRAME_RESPONSE, status, seq, payload
+
+    def request(self, cmd, payload=b"", flags=0):
+        seq = self.send(cmd, payload, flags)
+        rsp_cmd, status, rsp_seq, rsp_payload = self.receive()
+        if (rsp_cmd != cmd) or (rsp_seq != seq):
+            raise RuntimeError("unexpected response %02X/%d" % (rsp_cmd, rsp_seq))
+        if status != 0:
+            raise RuntimeError("device returned %s"
+                               % STATUS_NAMES.get(status, hex(status)))
+        return rsp_payload
+
+
+def run_bench(client, size, count, window):
+    """Pipelines count CTR requests of size bytes, keeping up to window
+    requests outstanding, and reports the request and byte rates."""
+    iv = bytes(range(16))
+    data = bytes(i & 0xFF for i in range(size))
+    payload = iv + data
+    received = 0
+
+    def reader():
+        nonlocal received
+        for _ in range(count):
+            _, status, _, _ = client.receive()
+            if status != 0:
+                raise RuntimeError("request failed")
+            received += 1
+
+    thread = threading.Thread(target=reader)
+    start = time.perf_counter()
+    thread.start()
+    for sent in range(count):
+        while sent - received >= window:
+            time.sleep(0)
+        client.send(CMD_AES_CTR, payload)
+    thread.join()
+    elapsed = time.perf_counter() - start
+
+    print("%d requests of %d bytes in %.3f s: %.0f req/s, %.1f KiB/s"
+          % (count, size, elapsed, count / elapsed,
+             count * size / elapsed / 1024.0))
+
+
+# Tag lengths aes_gcm accepts, per SP 800-38D
+GCM_TAG_LENGTHS = (4, 8, 12, 13, 14, 15, 16)
+
+BATCH_MODES = {"ctr": 0, "cfb": 1, "cfb-decrypt": 2}
+# IV (16) and length (2) in front of each job's data
+BATCH_JOB_HEADER_SIZE = 18
+
+
+def batch_payload_size(jobs, size):
+    """Request payload length of an AES_BATCH of jobs messages of size
+    bytes: mode and job count, then each job's header and data."""
+    return 2 + jobs * (BATCH_JOB_HEADER_SIZE + size)
+
+
+def run_batch(client, mode, jobs, size):
+    """Sends one AES_BATCH request of jobs messages of size bytes, checks
+    each output against a single-message request and prints the timing
+    reported by the device."""
+    ivs = [bytes([i]) * 16 for i in range(jobs)]
+    datas = [bytes((i + j) & 0xFF for j in range(size)) for i in range(jobs)]
+    payload = bytes([BATCH_MODES[mode], jobs])
+    for iv, data in zip(ivs, datas):
+        payload += iv + struct.pack("<H", len(data)) + data
+    rsp = client.request(CMD_AES_BATCH, payload)
+
+    clock_hz, key_cycles, batch_cycles = struct.unpack_from("<III", rsp)
+    job_cycles = struct.unpack_from("<%dI" % jobs, rsp, 12)
+    out = rsp[12 + 4 * jobs:]
+    cmd = CMD_AES_CTR if mode == "ctr" else CMD_AES_CFB
+    flags = FLAG_DECRYPT if mode == "cfb-decrypt" else 0
+
+    def us(cycles):
+        return cycles * 1e6 / clock_hz
+
+    for i, (iv, data) in enumerate(zip(ivs, datas)):
+        match = client.request(cmd, iv + data, flags) == out[:size]
+        out = out[size:]
+        print("job %2d: %4d bytes %9.3f us %s"
+              % (i, size, us(job_cycles[i]), "ok" if match else "MISMATCH"))
+    print("batch: %d jobs, key load %.3f us, total %.3f us at %d Hz"
+          % (jobs, us(key_cycles), us(batch_cycles), clock_hz))
+
+
+# frame_ble_sc_t
+BLE_SC_FUNCTIONS = {"f4": 0, "f5": 1, "f6": 2, "g2": 3}
+
+
+def run_ble_sc(client, function, inputs):
+    """Runs an LE Secure Connections function on the device and prints its
+    output; for g2 also the six-digit numeric comparison value."""
+    payload = bytes([BLE_SC_FUNCTIONS[function]])
+    payload += b"".join(bytes.fromhex(value) for value in inputs)
+    rsp = client.request(CMD_BLE_SC, payload)
+    if function == "f5":
+        print("MacKey %s" % rsp[:16].hex())
+        print("LTK    %s" % rsp[16:].hex())
+    elif function == "g2":
+        value = struct.unpack(">I", rsp)[0]
+        print("%08x (%06d)" % (value, value % 1000000))
+    else:
+        print(rsp.hex())
+
+
+HEALTH_STATUS = {0: "ok", 1: "repetition count failure",
+                 2: "adaptive proportion failure"}
+
+
+def run_trng_stats(client, requests, count):
+    """Sends requests TRNG requests of count bytes each, then prints the
+    entropy pool counters. Failed requests, such as after a health test
+    failure, are counted rather than raised."""
+    failed = 0
+    for _ in range(requests):
+        try:
+            client.request(CMD_TRNG, struct.pack("<H", count))
+        except RuntimeError:
+            failed += 1
+    if failed:
+        print("%d of %d TRNG requests failed" % (failed, requests))
+    rsp = client.request(CMD_TRNG_STATS)
+    (clock_hz, total, hits, served, refills, words, cycles_lo, cycles_hi,
+     max_cycles, available, health, samples, max_rct,
+     max_apt) = struct.unpack("<14I", rsp)
+    cycles = cycles_lo | (cycles_hi << 32)
+
+    def us(value):
+        return value * 1e6 / clock_hz
+
+    print("requests: %d, served from the pool: %d (%.1f%%), %d bytes"
+          % (total, hits, 100.0 * hits / total if total else 0.0, served))
+    print("refills: %d, %d words, average %.3f us, max %.3f us"
+          % (refills, words, us(cycles / refills) if refills else 0.0,
+             us(max_cycles)))
+    print("pool: %d bytes available" % available)
+    print("health: %s, %d samples, longest run %d, highest window count %d"
+          % (HEALTH_STATUS.get(health, health), samples, max_rct, max_apt))
+
+
+# Operations of OP_STATS, in the order of op_stats_id_t
+OP_STATS_NAMES = ("AES CTR", "AES CFB", "AES CCM", "AES GCM", "AES CMAC",
+                  "SHA-256", "HMAC-SHA256", "TRNG", "CTR_DRBG", "UART print",
+                  "BLE SC")
+
+
+def run_op_stats(client, reset):
+    """Prints the device's per-operation timing statistics, optionally
+    clearing them afterwards."""
+    rsp = client.request(CMD_OP_STATS, bytes([1]) if reset else b"")
+    clock_hz, count = struct.unpack_from("<II", rsp)
+
+    def us(value):
+        return value * 1e6 / clock_hz
+
+    print("%-12s %8s %12s %12s %12s" % ("operation", "calls", "min us",
+                                        "mean us", "max us"))
+    for op in range(count):
+        (calls, min_cycles, max_cycles, total_lo,
+         total_hi) = struct.unpack_from("<5I", rsp, 8 + 20 * op)
+        name = OP_STATS_NAMES[op] if op < len(OP_STATS_NAMES) else str(op)
+        if not calls:
+            print("%-12s %8s" % (name, "-"))
+            continue
+        total = total_lo | (total_hi << 32)
+        print("%-12s %8d %12.3f %12.3f %12.3f"
+              % (name, calls, us(min_cycles), us(total / calls),
+                 us(max_cycles)))
+
+
+def run_trace_dump(client, path):
+    """Reads the device's trace ring, oldest event first, and writes it to
+    path for trace_decode.py: core clock in Hz (4) | sequence number of the
+    first event (4) | event count (4) | events (8 each, as sent). Events
+    recorded while the dump runs are left out."""
+    rsp = client.request(CMD_TRACE_DUMP, struct.pack("<I", 0))
+    clock_hz, head, start = struct.unpack_from("<III", rsp)
+    events = b""
+    first = start
+    while True:
+        data = rsp[12:]
+        keep = min(len(data) // 8, (head - first) & 0xFFFFFFFF)
+        events += data[:keep * 8]
+        first = (first + keep) & 0xFFFFFFFF
+        if keep == 0 or first == head:
+            break
+        rsp = client.request(CMD_TRACE_DUMP, struct.pack("<I", first))
+        _, _, got = struct.unpack_from("<III", rsp)
+        if got != first:
+            raise RuntimeError("trace overwritten while reading it")
+    with open(path, "wb") as out:
+        out.write(struct.pack("<III", clock_hz, start, len(events) // 8))
+        out.write(events)
+    print("%d events (sequence %d to %d) written to %s"
+          % (len(events) // 8, start, first, path))
+
+
+def run_rng_bench(client, size):
+    """Has the device produce size bytes from the raw TRNG and from the
+    CTR_DRBG and prints the throughput of each."""
+    rsp = client.request(CMD_RNG_BENCH, struct.pack("<I", size))
+    clock_hz, trng_cycles, drbg_cycles = struct.unpack("<III", rsp)
+    for name, cycles in (("trng", trng_cycles), ("drbg", drbg_cycles)):
+        seconds = cycles / clock_hz
+        print("%s: %d bytes in %.3f ms, %.1f KiB/s"
+              % (name, size, seconds * 1e3,
+                 size / seconds / 1024.0 if cycles else 0.0))
+    if drbg_cycles:
+        print("drbg/trng: %.1fx" % (trng_cycles / drbg_cycles))
+
+
+PRINTABLE = bytes(range(0x21, 0x7F))
+
+
+def run_password(client, length, alphabet, count, chi2):
+    """Requests count passwords. With chi2, prints a chi-square test of the
+    character frequencies against the uniform distribution instead of the
+    passwords; without an alphabet the device is assumed to use the 94
+    visible ASCII characters."""
+    payload = bytes([length]) + alphabet
+    counts = {}
+    start = time.monotonic()
+    for _ in range(count):
+        password = client.request(CMD_PASSWORD, payload)
+        if not chi2:
+            print(password.decode("latin-1"))
+        for c in password:
+            counts[c] = counts.get(c, 0) + 1
+    elapsed = time.monotonic() - start
+    print("%d passwords in %.3f s, %.0f passwords/s (including transport)"
+          % (count, elapsed, count / elapsed), file=sys.stderr)
+    if chi2:
+        symbols = sorted(set(alphabet or PRINTABLE))
+        unexpected = sum(n for c, n in counts.items() if c not in symbols)
+        expected = count * length / len(symbols)
+        stat = sum((counts.get(c, 0) - expected) ** 2 / expected
+                   for c in symbols)
+        df = len(symbols) - 1
+        # Wilson-Hilferty: (chi2/df)^(1/3) is close to normal
+        z = (((stat / df) ** (1.0 / 3.0)) - (1.0 - 2.0 / (9.0 * df))) \
+            / math.sqrt(2.0 / (9.0 * df))
+        print("chi-square %.1f, %d degrees of freedom, p = %.4f, "
+              "%d characters outside the alphabet"
+              % (stat, df, 0.5 * math.erfc(z / math.sqrt(2.0)), unexpected))
+
+
+def sha256_stream(client, stream, chunk):
+    """Hashes a file object of any size with START/UPDATE/FINISH, keeping
+    the UPDATE requests pipelined."""
+    client.request(CMD_SHA256_START)
+    pending = 0
+    while True:
+        data = stream.read(chunk)
+        if not data:
+            break
+        client.send(CMD_SHA256_UPDATE, data)
+        pending += 1
+    for _ in range(pending):
+        _, status, _, _ = client.receive()
+        if status != 0:
+            raise RuntimeError("device returned %s"
+                               % STATUS_NAMES.get(status, hex(status)))
+    return client.request(CMD_SHA256_FINISH)
+
+
+def parse_data(text):
+    """Accepts hex (prefix 'hex:') or plain text."""
+    if text.startswith("hex:"):
+        return bytes.fromhex(text[4:])
+    return text.encode()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    target = parser.add_mutually_exclusive_group(required=True)
+    target.add_argument("--port", help="serial port of the board")
+    target.add_argument("--exec", dest="command",
+                        help="path of the host build to run")
+    parser.add_argument("--baud", type=int, default=115200)
+    sub = parser.add_subparsers(dest="op", required=True)
+
+    sub.add_parser("ping").add_argument("data", nargs="?", default="ping")
+    for name in ("ctr", "cfb"):
+        p = sub.add_parser(name)
+        p.add_argument("iv", help="16-byte IV in hex")
+        p.add_argument("data", help="text, or hex with a 'hex:' prefix")
+        p.add_argument("--decrypt", action="store_true")
+    sub.add_parser("sha256").add_argument("data")
+    sha_file = sub.add_parser("sha256file", help="stream a file through "
+                              "SHA256_START/UPDATE/FINISH")
+    sha_file.add_argument("path")
+    sha_file.add_argument("--chunk", type=int, default=256,
+                          help="bytes per UPDATE request")
+    for name, nonce_help in (("ccm", "7..13-byte nonce in hex"),
+                             ("gcm", "IV in hex, normally 12 bytes")):
+        aead = sub.add_parser(name)
+        aead.add_argument("nonce", help=nonce_help)
+        aead.add_argument("data", help="text, or hex with a 'hex:' prefix; "
+                          "ciphertext followed by the tag when decrypting")
+        aead.add_argument("--aad", default="", help="associated data in hex")
+        aead.add_argument("--tag-len", type=int,
+                          default=8 if name == "ccm" else 16,
+                          choices=None if name == "ccm" else GCM_TAG_LENGTHS)
+        aead.add_argument("--decrypt", action="store_true")
+    hmac = sub.add_parser("hmac")
+    hmac.add_argument("key", help="key in hex, any length")
+    hmac.add_argument("data", help="text, or hex with a 'hex:' prefix")
+    cmac = sub.add_parser("cmac")
+    cmac.add_argument("data", help="text, or hex with a 'hex:' prefix")
+    cmac.add_argument("--key", help="16-byte key in hex, loaded with "
+                      "SET_KEY first")
+    sub.add_parser("trng").add_argument("count", type=int)
+    sub.add_parser("setkey").add_argument("key", help="16-byte key in hex")
+    drbg = sub.add_parser("drbg")
+    drbg.add_argument("count", type=int)
+    drbg.add_argument("--add", default="",
+                      help="additional input in hex, up to 32 bytes")
+    sub.add_parser("rngbench", help="TRNG vs DRBG throughput").add_argument(
+        "--size", type=int, default=65536)
+    password = sub.add_parser("password")
+    password.add_argument("--length", type=int, default=16)
+    password.add_argument("--alphabet", default="",
+                          help="characters to use instead of the device's "
+                          "default")
+    password.add_argument("--count", type=int, default=1)
+    password.add_argument("--chi2", action="store_true",
+                          help="test the character distribution")
+    trng_stats = sub.add_parser("trngstats", help="entropy pool counters")
+    trng_stats.add_argument("--requests", type=int, default=0,
+                            help="TRNG requests to send first")
+    trng_stats.add_argument("--count", type=int, default=16,
+                            help="bytes per TRNG request")
+    op_stats = sub.add_parser("opstats", help="per-operation timing")
+    op_stats.add_argument("--reset", action="store_true",
+                          help="clear the statistics after reading them")
+    trace = sub.add_parser("trace", help="dump the event trace for "
+                           "trace_decode.py")
+    trace.add_argument("--out", default="trace.bin")
+    ble_sc = sub.add_parser("blesc", help="LE Secure Connections function")
+    ble_sc.add_argument("function", choices=BLE_SC_FUNCTIONS)
+    ble_sc.add_argument("inputs", nargs="+",
+                        help="inputs in hex, most significant byte first, "
+                        "in the order of the specification")
+    batch = sub.add_parser("batch", help="AES_BATCH timing and check")
+    batch.add_argument("--mode", choices=sorted(BATCH_MODES), default="ctr")
+    batch.add_argument("--jobs", type=int, default=8)
+    batch.add_argument("--size", type=int, default=13,
+                       help="bytes per job")
+    batch.add_argument("--max-payload", type=int, default=DEVICE_MAX_PAYLOAD,
+                       help="largest request payload the device accepts "
+                       "(16 + its FRAME_MAX_DATA)")
+    bench = sub.add_parser("bench")
+    bench.add_argument("--size", type=int, default=256)
+    bench.add_argument("--count", type=int, default=1000)
+    bench.add_argument("--window", type=int, default=8,
+                       help="maximum requests in flight")
+
+    args = parser.parse_args()
+    if args.op == "batch":
+        if args.jobs < 1 or args.size < 0:
+            parser.error("batch needs at least one job and a size of 0 or more")
+        if batch_payload_size(args.jobs, args.size) > args.max_payload:
+            parser.error("%d jobs of %d bytes need a %d byte request, the "
+                         "device takes %d: at most %d jobs of this size"
+                         % (args.jobs, args.size,
+                            batch_payload_size(args.jobs, args.size),
+                            args.max_payload,
+                            (args.max_payload - 2)
+                            // (BATCH_JOB_HEADER_SIZE + args.size)))
+    if args.command:
+        transport = SubprocessTransport([args.command])
+    else:
+        transport = SerialTransport(args.port, args.baud)
+    client = FrameClient(transport)
+
+    try:
+        if args.op == "ping":
+            print(client.request(CMD_PING, parse_data(args.data)).decode())
+        elif args.op in ("ctr", "cfb"):
+            cmd = CMD_AES_CTR if args.op == "ctr" else CMD_AES_CFB
+            flags = FLAG_DECRYPT if args.decrypt else 0
+            print(client.request(cmd, bytes.fromhex(args.iv)
+                                 + parse_data(args.data), flags).hex())
+        elif args.op == "sha256":
+            print(client.request(CMD_SHA256, parse_data(args.data)).hex())
+        elif args.op == "sha256file":
+            with open(args.path, "rb") as stream:
+                print(sha256_stream(client, stream, args.chunk).hex())
+        elif args.op in ("ccm", "gcm"):
+            cmd = CMD_AES_CCM if args.op == "ccm" else CMD_AES_GCM
+            nonce = bytes.fromhex(args.nonce)
+            aad = bytes.fromhex(args.aad)
+            payload = (bytes([args.tag_len, len(nonce)]) + nonce
+                       + struct.pack("<H", len(aad)) + aad
+                       + parse_data(args.data))
+            flags = FLAG_DECRYPT if args.decrypt else 0
+            print(client.request(cmd, payload, flags).hex())
+        elif args.op == "hmac":
+            client.request(CMD_HMAC_SET_KEY, bytes.fromhex(args.key))
+            print(client.request(CMD_HMAC_SHA256, parse_data(args.data)).hex())
+        elif args.op == "cmac":
+            if args.key:
+                client.request(CMD_SET_KEY, bytes.fromhex(args.key))
+            print(client.request(CMD_AES_CMAC, parse_data(args.data)).hex())
+        elif args.op == "trng":
+            print(client.request(CMD_TRNG, struct.pack("<H", args.count)).hex())
+        elif args.op == "setkey":
+            client.request(CMD_SET_KEY, bytes.fromhex(args.key))
+        elif args.op == "drbg":
+            print(client.request(CMD_DRBG, struct.pack("<H", args.count)
+                                 + bytes.fromhex(args.add)).hex())
+        elif args.op == "rngbench":
+            run_rng_bench(client, args.size)
+        elif args.op == "password":
+            run_password(client, args.length, args.alphabet.encode("latin-1"),
+                         args.count, args.chi2)
+        elif args.op == "trngstats":
+            run_trng_stats(client, args.requests, args.count)
+        elif args.op == "opstats":
+            run_op_stats(client, args.reset)
+        elif args.op == "trace":
+            run_trace_dump(client, args.out)
+        elif args.op == "blesc":
+            run_ble_sc(client, args.function, args.inputs)
+        elif args.op == "batch":
+            run_batch(client, args.mode, args.jobs, args.size)
+        elif args.op == "bench":
+            run_bench(client, args.size, args.count, args.window)
+        client.request(CMD_EXIT)
+    finally:
+        transport.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
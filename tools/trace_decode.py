@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+################################################################################
+# \file trace_decode.py
+# \version 1.0
+#
+# \brief
+# Decodes a trace written by "frame_client.py trace" (see source/trace_ring.h)
+# into log2 latency histograms: time spent in each state of the command state
+# machine, per menu mode, and the duration of each timed operation and frame
+# command. Timestamps are 32-bit cycle counts, so a single interval longer
+# than 2^32 cycles (4.3 s at 1 GHz) is under-reported.
+#
+# Usage:
+#   trace_decode.py trace.bin
+#   trace_decode.py --events trace.bin
+#
+################################################################################
+# \copyright
+# Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+
+import argparse
+import struct
+import sys
+
+import frame_client
+from frame_client import OP_STATS_NAMES, STATUS_NAMES
+
+# trace_event_type_t
+EVENT_STATE = 1
+EVENT_OP_BEGIN = 2
+EVENT_OP_END = 3
+EVENT_FRAME_BEGIN = 4
+EVENT_FRAME_END = 5
+
+# message_status_t, and the menu modes of main.c
+STATE_NAMES = {0: "MESSAGE_ENTER_NEW", 1: "MESSAGE_READY", 2: "MENU",
+               3: "FRAME_MODE"}
+MODE_NAMES = {1: "CTR", 2: "CFB", 3: "SHA-256", 5: "CCM"}
+
+FRAME_CMD_NAMES = {value: name[len("CMD_"):]
+                   for name, value in vars(frame_client).items()
+                   if name.startswith("CMD_")}
+
+HISTOGRAM_WIDTH = 40
+
+
+def load(path):
+    """Returns the core clock in Hz and the events of a trace file as
+    (sequence, time, type, id, data) tuples. Times are cycle counts made
+    monotonic across counter wraps."""
+    with open(path, "rb") as stream:
+        clock_hz, first, count = struct.unpack("<III", stream.read(12))
+        data = stream.read(count * 8)
+    events = []
+    now = 0
+    previous = None
+    for i in range(count):
+        timestamp, info = struct.unpack_from("<II", data, i * 8)
+        if previous is not None:
+            now += (timestamp - previous) & 0xFFFFFFFF
+        previous = timestamp
+        events.append((first + i, now, info & 0xFF, (info >> 8) & 0xFF,
+                       info >> 16))
+    return clock_hz, events
+
+
+def state_label(state, mode):
+    name = STATE_NAMES.get(state, "state %d" % state)
+    if state in (0, 1):
+        name += " " + MODE_NAMES.get(mode, "mode %d" % mode)
+    return name
+
+
+def latencies(events):
+    """Groups the intervals of a trace by what they measure. Returns a dict
+    of label -> list of cycle counts."""
+    result = {}
+    state = None
+    op_begin = {}
+    frame_begin = {}
+
+    for _, now, kind, ident, data in events:
+        if kind == EVENT_STATE:
+            if state is not None:
+                result.setdefault("state " + state[0], []).append(
+                    now - state[1])
+            state = (state_label(ident, data), now)
+        elif kind == EVENT_OP_BEGIN:
+            op_begin[ident] = now
+        elif kind == EVENT_OP_END and ident in op_begin:
+            name = (OP_STATS_NAMES[ident] if ident < len(OP_STATS_NAMES)
+                    else "op %d" % ident)
+            result.setdefault("op " + name, []).append(
+                now - op_begin.pop(ident))
+        elif kind == EVENT_FRAME_BEGIN:
+            frame_begin[ident] = now
+        elif kind == EVENT_FRAME_END and ident in frame_begin:
+            name = FRAME_CMD_NAMES.get(ident, "0x%02X" % ident)
+            result.setdefault("frame " + name, []).append(
+                now - frame_begin.pop(ident))
+    return result
+
+
+def log2_histogram(values):
+    """Counts values per power of two: bucket k holds 2^k <= value <
+    2^(k+1), bucket 0 also holds 0."""
+    buckets = {}
+    for value in values:
+        bucket = max(value, 1).bit_length() - 1
+        buckets[bucket] = buckets.get(bucket, 0) + 1
+    return buckets
+
+
+def print_histogram(label, values, clock_hz):
+    buckets = log2_histogram(values)
+    peak = max(buckets.values())
+    print("%s: %d, mean %.3f us, max %.3f us"
+          % (label, len(values), sum(values) * 1e6 / len(values) / clock_hz,
+             max(values) * 1e6 / clock_hz))
+    print("%25s : %-7s %s" % ("cycles", "count", "distribution"))
+    for bucket in range(min(buckets), max(buckets) + 1):
+        count = buckets.get(bucket, 0)
+        low = 0 if bucket == 0 else 1 << bucket
+        print("%11d -> %-10d : %-7d |%-*s|"
+              % (low, (1 << (bucket + 1)) - 1, count, HISTOGRAM_WIDTH,
+                 "*" * ((count * HISTOGRAM_WIDTH + peak - 1) // peak)))
+    print()
+
+
+def print_events(events, clock_hz):
+    start = events[0][1] if events else 0
+    for seq, now, kind, ident, data in events:
+        if kind == EVENT_STATE:
+            what = "state %s" % state_label(ident, data)
+        elif kind in (EVENT_OP_BEGIN, EVENT_OP_END):
+            what = "%s %s" % ("begin" if kind == EVENT_OP_BEGIN else "end",
+                              OP_STATS_NAMES[ident]
+                              if ident < len(OP_STATS_NAMES) else ident)
+        elif kind == EVENT_FRAME_BEGIN:
+            what = "frame %s, %d bytes" % (
+                FRAME_CMD_NAMES.get(ident, "0x%02X" % ident), data)
+        elif kind == EVENT_FRAME_END:
+            what = "frame %s done, status %s" % (
+                FRAME_CMD_NAMES.get(ident, "0x%02X" % ident),
+                STATUS_NAMES.get(data, data))
+        else:
+            what = "type %d id %d data %d" % (kind, ident, data)
+        print("%8d %14.3f us  %s" % (seq, (now - start) * 1e6 / clock_hz,
+                                      what))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="log2 latency histograms of a Cryptolite trace")
+    parser.add_argument("path", help="file written by frame_client.py trace")
+    parser.add_argument("--events", action="store_true",
+                        help="list the events instead of histograms")
+    args = parser.parse_args()
+
+    clock_hz, events = load(args.path)
+    if args.events:
+        print_events(events, clock_hz)
+        return 0
+
+    print("%d events at %d Hz\n" % (len(events), clock_hz))
+    for label, values in sorted(latencies(events).items()):
+        print_histogram(label, values, clock_hz)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())